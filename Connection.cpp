@@ -24,12 +24,15 @@ typedef int ssize_t;
 #include <netinet/ip.h>
 #include <unistd.h>
 #include <netdb.h>
+#include <fcntl.h>
 
 #define closesocket close
 
 #endif
 
 #include "Connection.hpp"
+#include "Metrics.hpp"
+#include "FlightRecorder.hpp"
 
 //------------------------------------------------------
 
@@ -38,6 +41,7 @@ typedef int ssize_t;
 #include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <chrono>
 
 //NOTE: much of the sockets code herein is based on http-tweak's single-header http server
 // see: https://github.com/ixchow/http-tweak
@@ -46,24 +50,98 @@ typedef int ssize_t;
 
 
 void Connection::close() {
+	timer.cancel();
 	if (socket != InvalidSocket) {
 		::closesocket(socket);
 		socket = InvalidSocket;
 	}
 }
 
+bool Connection::has_message() const {
+	//messages are [type, size_low0, size_mid8, size_high8, data...]:
+	if (recv_buffer.size() < 4) return false;
+	uint32_t size = (uint32_t(recv_buffer[3]) << 16)
+	              | (uint32_t(recv_buffer[2]) << 8)
+	              |  uint32_t(recv_buffer[1]);
+	return recv_buffer.size() >= 4 + size;
+}
+
+bool Connection::ready(Awaiter::What what) const {
+	if (socket == InvalidSocket) return true; //closed connections never get more ready
+	if (what == Awaiter::Message) return has_message();
+	else return send_buffer.empty();
+}
+
+void Connection::resume_waiting() {
+	if (!waiting || !ready(waiting_for)) return;
+	auto handle = waiting;
+	waiting = nullptr;
+	handle.promise().waiting_on = nullptr;
+	handle.resume();
+}
+
+//---------------------------------
+//Deadlines are tracked in ticks of this length:
+constexpr double TimerTick = 0.01; //seconds
+
+static TimingWheel::Tick seconds_to_ticks(double seconds) {
+	return TimingWheel::Tick(std::ceil(seconds / TimerTick));
+}
+
+TimingWheel::Tick poll_detail::current_tick() {
+	auto now = std::chrono::steady_clock::now().time_since_epoch();
+	return TimingWheel::Tick(std::chrono::duration< double >(now).count() / TimerTick);
+}
+
+//(re-)arm a connection's deadline based on what it is waiting for:
+void poll_detail::arm_timer(TimingWheel *timers, Connection::Timeouts const &timeouts, Connection &c) {
+	c.timer.connection = &c;
+	if (!c.established) {
+		if (timeouts.handshake > 0.0) {
+			c.timer.stage = Connection::Timer::Handshake;
+			timers->schedule(&c.timer, timers->now + seconds_to_ticks(timeouts.handshake));
+		}
+	} else if (timeouts.keepalive > 0.0) {
+		c.timer.stage = Connection::Timer::Quiet;
+		timers->schedule(&c.timer, timers->now + seconds_to_ticks(timeouts.keepalive));
+	} else if (timeouts.idle > 0.0) {
+		c.timer.stage = Connection::Timer::Probed;
+		timers->schedule(&c.timer, timers->now + seconds_to_ticks(timeouts.idle));
+	} else {
+		c.timer.cancel();
+	}
+}
+
+//after a keepalive, wait for the remainder of the idle timeout:
+void poll_detail::arm_probe(TimingWheel *timers, Connection::Timeouts const &timeouts, Connection &c) {
+	if (timeouts.idle > timeouts.keepalive) {
+		c.timer.stage = Connection::Timer::Probed;
+		timers->schedule(&c.timer, timers->now + seconds_to_ticks(timeouts.idle - timeouts.keepalive));
+	}
+}
+
+void poll_detail::timed_out(char const *where, Connection &c) {
+	Metrics::add(Metrics::ConnectionTimeouts);
+	if (c.timer.stage == Connection::Timer::Handshake) {
+		std::cerr << "[" << where << "] handshake deadline passed, disconnecting." << std::endl;
+	} else {
+		std::cerr << "[" << where << "] connection idle, disconnecting." << std::endl;
+	}
+	c.close();
+}
+
 //---------------------------------
-//Polling helper used by both server and client:
-void poll_connections(
-	char const *where,
-	std::list< Connection > &connections,
-	std::function< void(Connection *, Connection::Event event) > const &on_event,
-	double timeout,
-	Socket listen_socket = InvalidSocket) {
+//Socket helpers used by poll_detail::poll_connections (see Connection.hpp):
 
+bool poll_detail::wait(char const *where, std::list< Connection > &connections, double timeout, Socket listen_socket, bool *can_accept) {
 	fd_set read_fds, write_fds;
 	FD_ZERO(&read_fds);
 	FD_ZERO(&write_fds);
+	#ifdef _WIN32
+	//(windows reports failed non-blocking connects as exceptions rather than as readable)
+	fd_set except_fds;
+	FD_ZERO(&except_fds);
+	#endif
 
 	int max = 0;
 
@@ -74,10 +152,13 @@ void poll_connections(
 	}
 
 	//add each connection's socket to read (and possibly write) sets:
-	for (auto c : connections) {
+	for (auto const &c : connections) {
 		if (c.socket != InvalidSocket) {
 			max = std::max(max, int(c.socket));
 			FD_SET(c.socket, &read_fds);
+			#ifdef _WIN32
+			FD_SET(c.socket, &except_fds);
+			#endif
 			if (!c.send_buffer.empty()) {
 				FD_SET(c.socket, &write_fds);
 			}
@@ -89,102 +170,112 @@ void poll_connections(
 		tv.tv_sec = std::lround(std::floor(timeout));
 		tv.tv_usec = std::lround((timeout - std::floor(timeout)) * 1e6);
 		//NOTE: on windows nfds is ignored -- https://msdn.microsoft.com/en-us/library/windows/desktop/ms740141(v=vs.85).aspx
+		#ifdef _WIN32
+		int ret = select(max + 1, &read_fds, &write_fds, &except_fds, &tv);
+		#else
 		int ret = select(max + 1, &read_fds, &write_fds, NULL, &tv);
+		#endif
 
 		if (ret < 0) {
 			std::cerr << "[" << where << "] Select returned an error; will attempt to read/write anyway." << std::endl;
 		} else if (ret == 0) {
 			//nothing to read or write.
-			return;
+			return false;
 		}
 	}
 
-	//add new connections as needed:
-	if (listen_socket != InvalidSocket && FD_ISSET(listen_socket, &read_fds)) {
-		Socket got = accept(listen_socket, NULL, NULL);
-		if (got == InvalidSocket) {
-			//oh well.
-		} else {
-			#ifdef _WIN32
-			unsigned long one = 1;
-			if (0 == ioctlsocket(got, FIONBIO, &one)) {
-			#else
-			{
-			#endif
-				connections.emplace_back();
-				connections.back().socket = got;
-				std::cerr << "[" << where << "] client connected on " << connections.back().socket << "." << std::endl; //INFO
-				if (on_event) on_event(&connections.back(), Connection::OnOpen);
-			}
-		}
+	*can_accept = (listen_socket != InvalidSocket && FD_ISSET(listen_socket, &read_fds));
+	for (auto &c : connections) {
+		c.readable = (c.socket != InvalidSocket && FD_ISSET(c.socket, &read_fds));
+		#ifdef _WIN32
+		//(so the failure gets picked up by the next recv())
+		if (c.socket != InvalidSocket && FD_ISSET(c.socket, &except_fds)) c.readable = true;
+		#endif
+		c.writable = (c.socket != InvalidSocket && FD_ISSET(c.socket, &write_fds));
 	}
+	return true;
+}
 
+Connection *poll_detail::accept(char const *where, std::list< Connection > &connections, Socket listen_socket) {
+	Socket got = ::accept(listen_socket, NULL, NULL);
+	if (got == InvalidSocket) {
+		//oh well.
+		return nullptr;
+	}
+	#ifdef _WIN32
+	unsigned long one = 1;
+	if (0 != ioctlsocket(got, FIONBIO, &one)) {
+		closesocket(got);
+		return nullptr;
+	}
+	#endif
+	connections.emplace_back();
+	connections.back().socket = got;
+	std::cerr << "[" << where << "] client connected on " << connections.back().socket << "." << std::endl; //INFO
+	return &connections.back();
+}
+
+poll_detail::Received poll_detail::receive(char const *where, Connection &c) {
 	const uint32_t BufferSize = 20000;
 	static thread_local char *buffer = new char[BufferSize];
-
-	//process requests:
-	for (auto &c : connections) {
-		//only read from valid sockets marked readable:
-		if (c.socket == InvalidSocket || !FD_ISSET(c.socket, &read_fds)) continue;
-
-		while (true) { //read until more data left to read
-			ssize_t ret = recv(c.socket, buffer, BufferSize, MSG_DONTWAIT);
-			if (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
-				//~no problem~ but no data
-				break;
-			} else if (ret <= 0 || ret > (ssize_t)BufferSize) {
-				//~problem~ so remove connection
-				if (ret == 0) {
-					std::cerr << "[" << where << "] port closed, disconnecting." << std::endl;
-				} else if (ret < 0) {
-					std::cerr << "[" << where << "] recv() returned error " << errno << "(" << strerror(errno) << "), disconnecting." << std::endl;
-				} else {
-					std::cerr << "[" << where << "] recv() returned strange number of bytes, disconnecting." << std::endl;
-				}
-				c.close();
-				if (on_event) on_event(&c, Connection::OnClose);
-				break;
-			} else { //ret > 0
-				c.recv_buffer.insert(c.recv_buffer.end(), buffer, buffer + ret);
-				if (on_event) on_event(&c, Connection::OnRecv);
-				if (ret < BufferSize) break; //ran out of data before buffer: no more data left to read
-			}
+	RECORD_SCOPE("recv");
+
+	ssize_t ret = recv(c.socket, buffer, BufferSize, MSG_DONTWAIT);
+	if (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+		//~no problem~ but no data
+		return Nothing;
+	} else if (ret <= 0 || ret > (ssize_t)BufferSize) {
+		//~problem~ so remove connection
+		if (ret == 0) {
+			std::cerr << "[" << where << "] port closed, disconnecting." << std::endl;
+		} else if (ret < 0) {
+			std::cerr << "[" << where << "] recv() returned error " << errno << "(" << strerror(errno) << "), disconnecting." << std::endl;
+			Metrics::add(Metrics::SocketErrors);
+		} else {
+			std::cerr << "[" << where << "] recv() returned strange number of bytes, disconnecting." << std::endl;
+			Metrics::add(Metrics::SocketErrors);
 		}
+		c.close();
+		return Closed;
+	} else { //ret > 0
+		c.recv_buffer.insert(c.recv_buffer.end(), buffer, buffer + ret);
+		c.buffer_memory.set(c.recv_buffer.capacity() + c.send_buffer.capacity());
+		Metrics::add(Metrics::SocketBytesReceived, uint64_t(ret));
+		return (ret < (ssize_t)BufferSize ? Some : Full);
 	}
+}
 
-	//process responses:
-	for (auto &c : connections) {
-		//don't bother with connections unless they are valid, have something to send, and are marked writable:
-		if (c.socket == InvalidSocket || c.send_buffer.empty() || !FD_ISSET(c.socket, &write_fds)) continue;
-		
-		#ifdef _WIN32
-		ssize_t ret = send(c.socket, reinterpret_cast< char const * >(c.send_buffer.data()), int(c.send_buffer.size()), MSG_DONTWAIT);
-		#else
-		ssize_t ret = send(c.socket, reinterpret_cast< char const * >(c.send_buffer.data()), c.send_buffer.size(), MSG_DONTWAIT);
-		#endif 
-		if (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
-			//~no problem~, but don't keep trying
-			break;
-		} else if (ret <= 0 || ret > (ssize_t)c.send_buffer.size()) {
-			if (ret < 0) {
-				std::cerr << "[" << where << "] send() returned error " << errno << ", disconnecting." << std::endl;
-			} else { assert(ret == 0 || ret > (ssize_t)c.send_buffer.size());
-				std::cerr << "[" << where << "] send() returned strange number of bytes [" << ret << " of " << c.send_buffer.size() << "], disconnecting." << std::endl;
-			}
-			c.close();
-			if (on_event) on_event(&c, Connection::OnClose);
-		} else { //ret seems reasonable
-			c.send_buffer.erase(c.send_buffer.begin(), c.send_buffer.begin() + ret);
+bool poll_detail::transmit(char const *where, Connection &c) {
+	RECORD_SCOPE("send");
+	#ifdef _WIN32
+	ssize_t ret = send(c.socket, reinterpret_cast< char const * >(c.send_buffer.data()), int(c.send_buffer.size()), MSG_DONTWAIT);
+	#else
+	ssize_t ret = send(c.socket, reinterpret_cast< char const * >(c.send_buffer.data()), c.send_buffer.size(), MSG_DONTWAIT);
+	#endif 
+	if (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+		//~no problem~, but don't keep trying
+		return true;
+	} else if (ret <= 0 || ret > (ssize_t)c.send_buffer.size()) {
+		if (ret < 0) {
+			std::cerr << "[" << where << "] send() returned error " << errno << ", disconnecting." << std::endl;
+		} else { assert(ret == 0 || ret > (ssize_t)c.send_buffer.size());
+			std::cerr << "[" << where << "] send() returned strange number of bytes [" << ret << " of " << c.send_buffer.size() << "], disconnecting." << std::endl;
 		}
+		Metrics::add(Metrics::SocketErrors);
+		c.close();
+		return false;
+	} else { //ret seems reasonable
+		c.send_buffer.erase(c.send_buffer.begin(), c.send_buffer.begin() + ret);
+		c.buffer_memory.set(c.recv_buffer.capacity() + c.send_buffer.capacity());
+		Metrics::add(Metrics::SocketBytesSent, uint64_t(ret));
+		return true;
 	}
-
-		
 }
 
 //---------------------------------
 
 
-Server::Server(std::string const &port) {
+Server::Server(std::string const &port) : timers(poll_detail::current_tick()) {
 
 	#ifdef _WIN32
 	{ //init winsock:
@@ -275,8 +366,11 @@ Server::Server(std::string const &port) {
 }
 
 void Server::poll(std::function< void(Connection *, Connection::Event event) > const &on_event, double timeout) {
-	poll_connections("Server::poll", connections, on_event, timeout, listen_socket);
+	poll_detail::poll_connections("Server::poll", connections, on_event, timeout, listen_socket, &timers, timeouts);
+	reap();
+}
 
+void Server::reap() {
 	//reap closed clients:
 	for (auto connection = connections.begin(); connection != connections.end(); /*later*/) {
 		auto old = connection;
@@ -287,75 +381,129 @@ void Server::poll(std::function< void(Connection *, Connection::Event event) > c
 	}
 }
 
-Client::Client(std::string const &host, std::string const &port) : connections(1), connection(connections.front()) {
-	#ifdef _WIN32
-	{ //init winsock:
-		WSADATA info;
-		if (WSAStartup((2 << 8) | 2, &info) != 0) {
-			throw std::runtime_error("WSAStartup failed.");
-		}
+//look up host:port and open a TCP connection to it, throwing if that fails.
+// If !blocking, the socket is returned as soon as the connection has started: poll() finishes connecting
+// (a failure shows up as an OnClose) and anything queued in the meantime is sent once it is ready.
+//Note that host name lookup itself still blocks.
+static Socket connect_socket(char const *where, std::string const &host, std::string const &port, bool blocking) {
+	struct addrinfo hints;
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_protocol = IPPROTO_TCP;
+
+	struct addrinfo *res = nullptr;
+	int addrinfo_ret = getaddrinfo(host.c_str(), port.c_str(), &hints, &res);
+	if (addrinfo_ret != 0) {
+		throw std::runtime_error("getaddrinfo error: " + std::string(gai_strerror(addrinfo_ret)));
 	}
-	#endif
 
-	{ //use getaddrinfo to look up how to bind to host/port:
-		struct addrinfo hints;
-		memset(&hints, 0, sizeof(hints));
-		hints.ai_family = AF_UNSPEC;
-		hints.ai_socktype = SOCK_STREAM;
-		hints.ai_protocol = IPPROTO_TCP;
-
-		struct addrinfo *res = nullptr;
-		int addrinfo_ret = getaddrinfo(host.c_str(), port.c_str(), &hints, &res);
-		if (addrinfo_ret != 0) {
-			throw std::runtime_error("getaddrinfo error: " + std::string(gai_strerror(addrinfo_ret)));
-		}
-
-		std::cout << "[Client::Client] connecting to " << host << ":" << port << ":" << std::endl;
-		//based on example code in the 'man getaddrinfo' man page on OSX:
-		for (struct addrinfo *info = res; info != nullptr; info = info->ai_next) {
-			{ //DEBUG: dump info about this address:
-				std::cout << "\ttrying ";
-				char ip[INET6_ADDRSTRLEN];
-				if (info->ai_family == AF_INET) {
-					struct sockaddr_in *s = reinterpret_cast< struct sockaddr_in * >(info->ai_addr);
-					inet_ntop(res->ai_family, &s->sin_addr, ip, sizeof(ip));
-					std::cout << ip << ":" << ntohs(s->sin_port);
-				} else if (info->ai_family == AF_INET6) {
-					struct sockaddr_in6 *s = reinterpret_cast< struct sockaddr_in6 * >(info->ai_addr);
-					inet_ntop(res->ai_family, &s->sin6_addr, ip, sizeof(ip));
-					std::cout << ip << ":" << ntohs(s->sin6_port);
-				} else {
-					std::cout << "[unknown ai_family]";
-				}
-				std::cout << "... "; std::cout.flush();
+	Socket got = InvalidSocket;
+	std::cout << "[" << where << "] connecting to " << host << ":" << port << ":" << std::endl;
+	//based on example code in the 'man getaddrinfo' man page on OSX:
+	for (struct addrinfo *info = res; info != nullptr; info = info->ai_next) {
+		{ //DEBUG: dump info about this address:
+			std::cout << "\ttrying ";
+			char ip[INET6_ADDRSTRLEN];
+			if (info->ai_family == AF_INET) {
+				struct sockaddr_in *s = reinterpret_cast< struct sockaddr_in * >(info->ai_addr);
+				inet_ntop(res->ai_family, &s->sin_addr, ip, sizeof(ip));
+				std::cout << ip << ":" << ntohs(s->sin_port);
+			} else if (info->ai_family == AF_INET6) {
+				struct sockaddr_in6 *s = reinterpret_cast< struct sockaddr_in6 * >(info->ai_addr);
+				inet_ntop(res->ai_family, &s->sin6_addr, ip, sizeof(ip));
+				std::cout << ip << ":" << ntohs(s->sin6_port);
+			} else {
+				std::cout << "[unknown ai_family]";
 			}
+			std::cout << "... "; std::cout.flush();
+		}
 
-			Socket s = socket(info->ai_family, info->ai_socktype, info->ai_protocol);
-			if (s == InvalidSocket) {
-				std::cout << "(failed to create socket: " << strerror(errno) << ")" << std::endl;
+		Socket s = socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+		if (s == InvalidSocket) {
+			std::cout << "(failed to create socket: " << strerror(errno) << ")" << std::endl;
+			continue;
+		}
+		if (!blocking) {
+			#ifdef _WIN32
+			unsigned long one = 1;
+			bool ok = (0 == ioctlsocket(s, FIONBIO, &one));
+			#else
+			bool ok = (0 == fcntl(s, F_SETFL, fcntl(s, F_GETFL, 0) | O_NONBLOCK));
+			#endif
+			if (!ok) {
+				std::cout << "(failed to make socket non-blocking)" << std::endl;
+				closesocket(s);
 				continue;
 			}
-			int ret = connect(s, info->ai_addr, int(info->ai_addrlen));
-			if (ret < 0) {
+		}
+		int ret = ::connect(s, info->ai_addr, int(info->ai_addrlen));
+		if (ret < 0) {
+			#ifdef _WIN32
+			bool started = (!blocking && WSAGetLastError() == WSAEWOULDBLOCK);
+			#else
+			bool started = (!blocking && errno == EINPROGRESS);
+			#endif
+			if (!started) {
 				std::cout << "(failed to connect: " << strerror(errno) << ")" << std::endl;
+				closesocket(s);
 				continue;
 			}
+			std::cout << "started." << std::endl;
+		} else {
 			std::cout << "success!" << std::endl;
-
-			connection.socket = s;
-			break;
 		}
 
-		freeaddrinfo(res);
+		got = s;
+		break;
+	}
 
-		if (!connection) {
-			throw std::runtime_error("Failed to connect to any of the addresses tried for server.");
+	freeaddrinfo(res);
+
+	if (got == InvalidSocket) {
+		throw std::runtime_error("Failed to connect to any of the addresses tried for " + host + ":" + port + ".");
+	}
+	return got;
+}
+
+
+Client::Client(std::string const &host, std::string const &port) : connections(1), connection(connections.front()) {
+	#ifdef _WIN32
+	{ //init winsock:
+		WSADATA info;
+		if (WSAStartup((2 << 8) | 2, &info) != 0) {
+			throw std::runtime_error("WSAStartup failed.");
 		}
 	}
+	#endif
+
+	connect(host, port);
+}
+
+void Client::reconnect(std::string const &host, std::string const &port) {
+	connection.close();
+	connection.recv_buffer.clear();
+	connection.send_buffer.clear();
+	connection.established = false;
+	connection.readable = connection.writable = false;
+	connection.socket = connect_socket("Client::reconnect", host, port, false);
+}
+
+void Client::connect(std::string const &host, std::string const &port) {
+	assert(!connection);
+	connection.socket = connect_socket("Client::connect", host, port, true);
 }
 
+Connection *Server::connect(std::string const &host, std::string const &port) {
+	Socket s = connect_socket("Server::connect", host, port, false);
+	connections.emplace_back();
+	Connection &c = connections.back();
+	c.socket = s;
+	poll_detail::arm_timer(&timers, timeouts, c); //(an unanswered connection still runs into the handshake deadline)
+	return &c;
+}
 
 void Client::poll(std::function< void(Connection *, Connection::Event event) > const &on_event, double timeout) {
-	poll_connections("Client::poll", connections, on_event, timeout, InvalidSocket);
+	poll_detail::poll_connections("Client::poll", connections, on_event, timeout, InvalidSocket);
 }
 
@@ -60,10 +60,15 @@ int main(int argc, char **argv) {
 #endif
 //--------- ---------------------------------- ---------
 
+#include "TimingWheel.hpp"
+#include "ConnectionTask.hpp"
+#include "Memory.hpp"
+
 #include <vector>
 #include <list>
 #include <string>
 #include <functional>
+#include <type_traits>
 
 //Thin wrapper around a (polling-based) TCP socket connection:
 struct Connection {
@@ -87,6 +92,24 @@ struct Connection {
 	std::vector< uint8_t > send_buffer;
 	//When the connection receives data, it is appended to recv_buffer:
 	std::vector< uint8_t > recv_buffer;
+	//(capacity of both buffers, as of the last socket read or write)
+	Memory::Tracked buffer_memory{Memory::ConnectionBuffers};
+
+	//Awaitables for use in ConnectionTask coroutines (see ConnectionTask.hpp):
+	struct Awaiter;
+	//co_await read_message() waits until recv_buffer holds a complete [type, size x3, data...] message;
+	// resumes with 'true' if so, or 'false' if the connection closed first:
+	Awaiter read_message();
+	//co_await flush() waits until send_buffer has been handed to the OS;
+	// resumes with 'true' if so, or 'false' if the connection closed first:
+	Awaiter flush();
+
+	//does recv_buffer start with a complete message?
+	bool has_message() const;
+
+	//Set 'established' once the connection has sent something valid;
+	// this ends the handshake deadline and starts the read-idle timeout (see Server::timeouts):
+	bool established = false;
 
 	//internals:
 	Socket socket = InvalidSocket;
@@ -94,10 +117,58 @@ struct Connection {
 	enum Event {
 		OnOpen,
 		OnRecv,
+		OnIdle, //no data received for Timeouts::keepalive seconds (a good time to send a probe)
 		OnClose
 	};
+
+	//idle / handshake deadlines, if enabled:
+	struct Timeouts {
+		double handshake = 0.0; //seconds from open until 'established' must be set
+		double keepalive = 0.0; //seconds of read-idle before an OnIdle event
+		double idle = 0.0; //seconds of read-idle before the connection is closed
+		//(a value of zero disables that deadline)
+	};
+	struct Timer : TimingWheel::Timer {
+		Connection *connection = nullptr;
+		enum Stage : uint8_t {
+			Handshake, //waiting for 'established'
+			Quiet, //waiting to send OnIdle
+			Probed, //waiting to close
+		} stage = Handshake;
+	} timer;
+
+	//coroutine waiting on this connection, resumed by poll() when ready:
+	struct Awaiter {
+		Connection *connection;
+		enum What : uint8_t { Message, Flush } what;
+
+		bool await_ready() const { return connection->ready(what); }
+		void await_suspend(std::coroutine_handle< ConnectionTask::promise_type > handle) {
+			connection->waiting = handle;
+			connection->waiting_for = what;
+			handle.promise().waiting_on = connection;
+		}
+		bool await_resume() const { return connection->socket != InvalidSocket; }
+	};
+	std::coroutine_handle< ConnectionTask::promise_type > waiting;
+	Awaiter::What waiting_for = Awaiter::Message;
+	bool ready(Awaiter::What what) const;
+	void resume_waiting(); //resume 'waiting' if it is ready
+
+	//socket readiness from the most recent poll:
+	bool readable = false;
+	bool writable = false;
 };
 
+inline Connection::Awaiter Connection::read_message() { return Awaiter{this, Awaiter::Message}; }
+inline Connection::Awaiter Connection::flush() { return Awaiter{this, Awaiter::Flush}; }
+
+//poll() handlers may be either:
+// - anything callable as handler(Connection *, Connection::Event), or
+// - an object with on_open(Connection *), on_recv(Connection *), on_close(Connection *)
+//   (and, optionally, on_idle(Connection *)) members.
+//Passing the handler by type (rather than as a std::function) lets the compiler inline it into the event loop.
+
 struct Server {
 	Server(std::string const &port); //pass the port number to listen on, as a string (servname, really)
 
@@ -107,22 +178,193 @@ struct Server {
 		std::function< void(Connection *, Connection::Event event) > const &connection_event = nullptr,
 		double timeout = 0.0 //timeout (seconds)
 	);
+	template< typename Handler >
+		requires (!std::is_same_v< std::decay_t< Handler >, std::nullptr_t >)
+	void poll(Handler &&handler, double timeout = 0.0);
 
 	std::list< Connection > connections;
 	Socket listen_socket = InvalidSocket;
+
+	//read-idle, keepalive, and handshake deadlines for connections:
+	// (expired deadlines are reported through the usual OnIdle / OnClose events)
+	Connection::Timeouts timeouts;
+	TimingWheel timers;
+
+	void reap(); //remove closed connections (called by poll)
+
+	//open an outgoing connection (e.g., to another server) and poll() it along with the rest:
+	// (like Client::reconnect, this doesn't wait for the connection to finish opening; throws if it can't start)
+	// No OnOpen is sent for it; it is subject to the same deadlines as accepted connections.
+	Connection *connect(std::string const &host, std::string const &port);
 };
 
 
 struct Client {
 	Client(std::string const &host, std::string const &port);
 
+	//drop the current connection (and anything buffered on it) and connect somewhere else:
+	// (used to follow a server's redirect when a match migrates)
+	//Doesn't wait for the new connection: poll() finishes connecting, anything sent in the meantime
+	// goes out once it is ready, and a failed connection is reported as OnClose.
+	void reconnect(std::string const &host, std::string const &port);
+
 	//poll() checks the status of the active connection and sends/receives data if possible:
 	// (will wait up to 'timeout' for first event)
 	void poll(
 		std::function< void(Connection *, Connection::Event event) > const &connection_event = nullptr,
 		double timeout = 0.0 //timeout (seconds)
 	);
+	template< typename Handler >
+		requires (!std::is_same_v< std::decay_t< Handler >, std::nullptr_t >)
+	void poll(Handler &&handler, double timeout = 0.0);
 
 	std::list< Connection > connections; //will only ever contain exactly one connection
 	Connection &connection; //reference to the only connection in the connections list
+
+	void connect(std::string const &host, std::string const &port); //(blocking)
 };
+
+//---------------------------------
+//poll() internals.
+// The event loop is a template so handlers can be inlined;
+// the socket calls it makes are plain functions in Connection.cpp.
+
+namespace poll_detail {
+	//deliver one event to a handler:
+	template< typename Handler >
+	inline void dispatch(Handler &handler, Connection *c, Connection::Event evt) {
+		if constexpr (std::is_invocable_v< Handler &, Connection *, Connection::Event >) {
+			handler(c, evt);
+		} else {
+			if (evt == Connection::OnOpen) handler.on_open(c);
+			else if (evt == Connection::OnRecv) handler.on_recv(c);
+			else if (evt == Connection::OnClose) handler.on_close(c);
+			else if constexpr (requires { handler.on_idle(c); }) {
+				if (evt == Connection::OnIdle) handler.on_idle(c);
+			}
+		}
+	}
+	//(std::function handlers may be empty)
+	inline void dispatch(std::function< void(Connection *, Connection::Event) > const &handler, Connection *c, Connection::Event evt) {
+		if (handler) handler(c, evt);
+	}
+
+	//deadlines:
+	TimingWheel::Tick current_tick();
+	void arm_timer(TimingWheel *timers, Connection::Timeouts const &timeouts, Connection &c);
+	void arm_probe(TimingWheel *timers, Connection::Timeouts const &timeouts, Connection &c); //after OnIdle
+	void timed_out(char const *where, Connection &c); //(logs + closes)
+
+	//socket i/o:
+	//wait until a socket is ready or the timeout passes; sets Connection::readable/writable.
+	// returns 'false' if nothing is ready:
+	bool wait(char const *where, std::list< Connection > &connections, double timeout, Socket listen_socket, bool *can_accept);
+	//accept a new connection (returns nullptr on failure):
+	Connection *accept(char const *where, std::list< Connection > &connections, Socket listen_socket);
+	//read available data onto recv_buffer:
+	enum Received : uint8_t {
+		Nothing, //no data available
+		Some, //appended data; no more waiting
+		Full, //appended a full buffer; there may be more waiting
+		Closed, //connection closed (error or hang-up)
+	};
+	Received receive(char const *where, Connection &c);
+	//send as much of send_buffer as possible (returns 'false' if the connection closed):
+	bool transmit(char const *where, Connection &c);
+
+	template< typename Handler >
+	void poll_connections(
+		char const *where,
+		std::list< Connection > &connections,
+		Handler &on_event,
+		double timeout,
+		Socket listen_socket = InvalidSocket,
+		TimingWheel *timers = nullptr,
+		Connection::Timeouts const &timeouts = Connection::Timeouts()) {
+
+		//fire any expired deadlines:
+		if (timers) {
+			timers->advance(current_tick(), [&](TimingWheel::Timer *timer_) {
+				Connection::Timer *timer = static_cast< Connection::Timer * >(timer_);
+				Connection &c = *timer->connection;
+				if (timer->stage == Connection::Timer::Quiet) {
+					//keepalive: let the application probe, then wait for the remainder of the idle timeout:
+					dispatch(on_event, &c, Connection::OnIdle);
+					if (c.socket != InvalidSocket) arm_probe(timers, timeouts, c);
+				} else {
+					timed_out(where, c);
+					dispatch(on_event, &c, Connection::OnClose);
+				}
+			});
+		}
+
+		//resume any coroutines whose messages arrived, whose sends finished, or whose connections closed:
+		auto resume_waiting = [&]() {
+			for (auto &c : connections) {
+				bool was_established = c.established;
+				c.resume_waiting();
+				//a task that just completed the handshake starts the read-idle timeout:
+				if (timers && c.socket != InvalidSocket && c.established && !was_established) arm_timer(timers, timeouts, c);
+			}
+		};
+
+		bool can_accept = false;
+		if (!wait(where, connections, timeout, listen_socket, &can_accept)) {
+			//nothing to read or write.
+			resume_waiting();
+			return;
+		}
+
+		//add new connections as needed:
+		if (can_accept) {
+			if (Connection *c = accept(where, connections, listen_socket)) {
+				if (timers) arm_timer(timers, timeouts, *c);
+				dispatch(on_event, c, Connection::OnOpen);
+			}
+		}
+
+		//process requests:
+		for (auto &c : connections) {
+			//only read from valid sockets marked readable:
+			if (c.socket == InvalidSocket || !c.readable) continue;
+
+			while (true) { //read until more data left to read
+				Received got = receive(where, c);
+				if (got == Nothing) break;
+				if (got == Closed) {
+					dispatch(on_event, &c, Connection::OnClose);
+					break;
+				}
+				dispatch(on_event, &c, Connection::OnRecv);
+				//reset read-idle deadline (or start it, if this data completed the handshake):
+				if (timers && c.socket != InvalidSocket && c.established) arm_timer(timers, timeouts, c);
+				if (c.socket == InvalidSocket) break; //closed by on_event
+				if (got == Some) break; //ran out of data before buffer: no more data left to read
+			}
+		}
+
+		//process responses:
+		for (auto &c : connections) {
+			//don't bother with connections unless they are valid, have something to send, and are marked writable:
+			if (c.socket == InvalidSocket || c.send_buffer.empty() || !c.writable) continue;
+			if (!transmit(where, c)) {
+				dispatch(on_event, &c, Connection::OnClose);
+			}
+		}
+
+		resume_waiting();
+	}
+}
+
+template< typename Handler >
+	requires (!std::is_same_v< std::decay_t< Handler >, std::nullptr_t >)
+void Server::poll(Handler &&handler, double timeout) {
+	poll_detail::poll_connections("Server::poll", connections, handler, timeout, listen_socket, &timers, timeouts);
+	reap();
+}
+
+template< typename Handler >
+	requires (!std::is_same_v< std::decay_t< Handler >, std::nullptr_t >)
+void Client::poll(Handler &&handler, double timeout) {
+	poll_detail::poll_connections("Client::poll", connections, handler, timeout, InvalidSocket);
+}
@@ -0,0 +1,96 @@
+#include "ConnectionTask.hpp"
+
+#include "Connection.hpp"
+
+#include <vector>
+#include <memory>
+#include <new>
+
+//Each thread keeps its own pool of frame-sized blocks, threaded onto a free list:
+namespace {
+	struct FramePool {
+		union Block {
+			Block *next_free;
+			alignas(std::max_align_t) unsigned char bytes[ConnectionTask::FrameSize];
+		};
+		static constexpr size_t BlocksPerChunk = 64;
+
+		std::vector< std::unique_ptr< Block[] > > chunks;
+		Block *free_list = nullptr;
+		ConnectionTaskPoolStats stats;
+
+		void *allocate() {
+			if (!free_list) {
+				chunks.emplace_back(new Block[BlocksPerChunk]);
+				for (size_t i = 0; i < BlocksPerChunk; ++i) {
+					chunks.back()[i].next_free = free_list;
+					free_list = &chunks.back()[i];
+				}
+				stats.blocks += BlocksPerChunk;
+			}
+			Block *block = free_list;
+			free_list = block->next_free;
+			stats.in_use += 1;
+			return block;
+		}
+
+		void deallocate(void *frame) {
+			Block *block = reinterpret_cast< Block * >(frame);
+			block->next_free = free_list;
+			free_list = block;
+			stats.in_use -= 1;
+		}
+	};
+
+	FramePool &get_pool() {
+		static thread_local FramePool pool;
+		return pool;
+	}
+}
+
+void *ConnectionTask::promise_type::operator new(size_t size) {
+	FramePool &pool = get_pool();
+	if (size > FrameSize) {
+		pool.stats.oversized += 1;
+		return ::operator new(size);
+	}
+	return pool.allocate();
+}
+
+void ConnectionTask::promise_type::operator delete(void *frame, size_t size) {
+	if (size > FrameSize) {
+		::operator delete(frame);
+	} else {
+		get_pool().deallocate(frame);
+	}
+}
+
+//destroy a (possibly suspended) coroutine, making sure its connection forgets about it:
+static void destroy(std::coroutine_handle< ConnectionTask::promise_type > handle) {
+	Connection *connection = handle.promise().waiting_on;
+	if (connection && connection->waiting == handle) connection->waiting = nullptr;
+	handle.destroy();
+}
+
+ConnectionTask &ConnectionTask::operator=(ConnectionTask &&from) {
+	if (this != &from) {
+		if (handle) destroy(handle);
+		handle = from.handle;
+		from.handle = nullptr;
+	}
+	return *this;
+}
+
+ConnectionTask::~ConnectionTask() {
+	if (handle) destroy(handle);
+}
+
+void ConnectionTask::rethrow_if_failed() const {
+	if (handle && handle.done() && handle.promise().exception) {
+		std::rethrow_exception(handle.promise().exception);
+	}
+}
+
+ConnectionTaskPoolStats connection_task_pool_stats() {
+	return get_pool().stats;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+/*
+ * ConnectionTask lets per-connection protocol logic be written as a straight-line
+ * C++20 coroutine instead of a callback that re-parses on every OnRecv event.
+ *
+ * A coroutine returning ConnectionTask runs until its first co_await, and is
+ * resumed by Server::poll / Client::poll once what it is waiting for is ready:
+ *
+ * ConnectionTask greet(Connection &connection) {
+ *     //wait for a whole message to arrive:
+ *     if (!co_await connection.read_message()) co_return; //(connection closed)
+ *     Player::Controls controls;
+ *     if (!controls.recv_controls_message(&connection)) throw std::runtime_error("expected controls");
+ *     ...
+ *     //wait for everything in send_buffer to be handed to the OS:
+ *     co_await connection.flush();
+ * }
+ *
+ * //in the OnOpen handler:
+ * tasks.emplace(connection, greet(*connection));
+ *
+ * //after polling:
+ * if (task.done()) task.rethrow_if_failed();
+ *
+ * Coroutine frames are allocated from a pool of fixed-size blocks, so a suspended
+ * connection costs exactly one block (ConnectionTask::FrameSize bytes).
+ *
+ * NOTE: a task must be created, resumed (i.e., polled), and destroyed on the same thread,
+ *  and a suspended task must be destroyed before the connection it waits on.
+ */
+
+#include <coroutine>
+#include <exception>
+#include <cstddef>
+
+struct Connection;
+
+struct ConnectionTask {
+	//frames up to this size come from the pool; larger frames fall back to the heap:
+	static constexpr size_t FrameSize = 512;
+
+	struct promise_type {
+		ConnectionTask get_return_object() {
+			return ConnectionTask(std::coroutine_handle< promise_type >::from_promise(*this));
+		}
+		//run eagerly until the first co_await:
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		//stay alive after finishing so the owner can check done() and errors:
+		std::suspend_always final_suspend() noexcept { return {}; }
+		void return_void() { }
+		void unhandled_exception() { exception = std::current_exception(); }
+
+		static void *operator new(size_t size);
+		static void operator delete(void *frame, size_t size);
+
+		std::exception_ptr exception;
+		Connection *waiting_on = nullptr; //connection this task is suspended on (if any)
+	};
+
+	ConnectionTask() = default;
+	explicit ConnectionTask(std::coroutine_handle< promise_type > handle_) : handle(handle_) { }
+	ConnectionTask(ConnectionTask const &) = delete;
+	ConnectionTask &operator=(ConnectionTask const &) = delete;
+	ConnectionTask(ConnectionTask &&from) : handle(from.handle) { from.handle = nullptr; }
+	ConnectionTask &operator=(ConnectionTask &&from);
+	~ConnectionTask();
+
+	//has the coroutine run to completion (or thrown)?
+	bool done() const { return !handle || handle.done(); }
+
+	//if the coroutine exited with an exception, rethrow it:
+	void rethrow_if_failed() const;
+
+	std::coroutine_handle< promise_type > handle;
+};
+
+//frame pool statistics (for the calling thread):
+struct ConnectionTaskPoolStats {
+	size_t blocks = 0; //blocks allocated from the OS
+	size_t in_use = 0; //blocks currently holding a frame
+	size_t oversized = 0; //frames that were too large for a block
+};
+ConnectionTaskPoolStats connection_task_pool_stats();
@@ -3,6 +3,7 @@
 #include "ColorProgram.hpp"
 
 #include "gl_errors.hpp"
+#include "FlightRecorder.hpp"
 
 #include <glm/gtc/type_ptr.hpp>
 
@@ -11,6 +12,7 @@
 //n.b. declared static so they don't conflict with similarly named global variables elsewhere:
 static GLuint vertex_buffer = 0;
 static GLuint vertex_buffer_for_color_program = 0;
+static Memory::Tracked vertex_buffer_memory(Memory::StreamBuffersGL); //(as of the last upload)
 
 static Load< void > setup_buffers(LoadTagDefault, [](){
 	//you may recognize this init code from DrawSprites.cpp:
@@ -69,6 +71,7 @@ DrawLines::DrawLines(glm::mat4 const &world_to_clip_) : world_to_clip(world_to_c
 void DrawLines::draw(glm::vec3 const &a, glm::vec3 const &b, glm::u8vec4 const &color) {
 	attribs.emplace_back(a, color);
 	attribs.emplace_back(b, color);
+	attribs_memory.set(attribs.capacity() * sizeof(Vertex));
 }
 
 void DrawLines::draw_box(glm::mat4x3 const &mat, glm::u8vec4 const &color) {
@@ -128,12 +131,15 @@ void DrawLines::draw_text(std::string const &text, glm::vec3 const &anchor_in, g
 		}
 		start = end;
 	}
+	attribs_memory.set(attribs.capacity() * sizeof(Vertex));
 
 	if (anchor_out) *anchor_out = anchor;
 }
 
 DrawLines::~DrawLines() {
 	if (attribs.empty()) return;
+	RECORD_SCOPE("~DrawLines");
+	vertices_submitted += attribs.size();
 
 	//based on DrawSprites.cpp :
 
@@ -141,6 +147,7 @@ DrawLines::~DrawLines() {
 	glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer); //set vertex_buffer as current
 	glBufferData(GL_ARRAY_BUFFER, attribs.size() * sizeof(attribs[0]), attribs.data(), GL_STREAM_DRAW); //upload attribs array
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	vertex_buffer_memory.set(attribs.size() * sizeof(attribs[0]));
 
 	//set color_program as current program:
 	glUseProgram(color_program->program);
@@ -9,6 +9,8 @@
  */
 
 
+#include "Memory.hpp"
+
 #include <glm/glm.hpp>
 
 #include <string>
@@ -44,5 +46,9 @@ struct DrawLines {
 		glm::u8vec4 Color;
 	};
 	std::vector< Vertex > attribs;
+	Memory::Tracked attribs_memory{Memory::FrameTemporaries}; //(capacity of attribs)
+
+	//vertices submitted by all DrawLines so far (for the frame stats overlay):
+	static inline size_t vertices_submitted = 0;
 
 };
@@ -0,0 +1,275 @@
+#include "FlightRecorder.hpp"
+
+#include "write_json.hpp"
+
+#include <array>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+	//each thread's recent events (written only by that thread, read by whichever thread dumps):
+	struct Ring {
+		struct Event {
+			std::atomic< char const * > name{nullptr};
+			std::atomic< uint64_t > begin{0};
+			std::atomic< uint64_t > end{0};
+		};
+		std::array< Event, FlightRecorder::RingSize > events;
+		std::atomic< uint64_t > count{0}; //events recorded so far (the newest RingSize are kept)
+		std::atomic< char const * > name{nullptr};
+		uint32_t tid = 0;
+	};
+
+	constexpr size_t MaxThreads = 64; //(threads past this aren't recorded)
+	std::array< std::atomic< Ring * >, MaxThreads > rings{};
+	std::atomic< uint32_t > ring_count{0};
+
+	//rings are never freed, so events from threads that have already exited still get dumped:
+	Ring *local_ring() {
+		thread_local Ring *ring = []() -> Ring * {
+			uint32_t index = ring_count.fetch_add(1, std::memory_order_relaxed);
+			if (index >= MaxThreads) return nullptr;
+			Ring *created = new Ring;
+			created->tid = index + 1;
+			rings[index].store(created, std::memory_order_release);
+			return created;
+		}();
+		return ring;
+	}
+
+	//tick rate is measured against steady_clock from program start:
+	uint64_t const origin_ticks = FlightRecorder::now();
+	std::chrono::steady_clock::time_point const origin_time = std::chrono::steady_clock::now();
+	std::atomic< double > calibrated_rate{0.0}; //(set once a second has passed)
+
+	double ticks_per_second() {
+		#if defined(__x86_64__) || defined(_M_X64)
+		double rate = calibrated_rate.load(std::memory_order_relaxed);
+		if (rate != 0.0) return rate;
+		uint64_t ticks = FlightRecorder::now();
+		double elapsed = std::chrono::duration< double >(std::chrono::steady_clock::now() - origin_time).count();
+		if (elapsed <= 0.0 || ticks <= origin_ticks) return 1e9; //(too early to tell)
+		rate = (ticks - origin_ticks) / elapsed;
+		if (elapsed >= 1.0) calibrated_rate.store(rate, std::memory_order_relaxed);
+		return rate;
+		#else
+		return 1e9;
+		#endif
+	}
+
+	std::atomic< double > budget{0.0};
+	std::string prefix = "hitch"; //(set by configure, before other threads start)
+
+	std::mutex dump_mutex;
+	uint32_t dumps = 0;
+	uint32_t skipped = 0; //(dumps not written because of the cooldown, since the last one)
+	std::chrono::steady_clock::time_point last_dump;
+
+	//a dump's events, copied out of the rings (see collect), waiting to be written:
+	struct Dump {
+		struct Event {
+			char const *name;
+			uint64_t begin, end;
+			uint32_t tid;
+		};
+		std::vector< Event > events;
+		std::vector< std::pair< uint32_t, char const * > > thread_names;
+		uint64_t start; //(ticks)
+		double rate; //(ticks per second)
+		std::string reason;
+		std::string filename;
+		uint32_t number;
+		uint32_t skipped;
+	};
+	Dump collect(uint64_t cutoff);
+	bool write_events(Dump const &dump, std::string const &filename);
+	void write(Dump const &dump);
+
+	//formats and writes dumps on its own thread, so the thread that hitched doesn't also wait on the disk:
+	struct Writer {
+		std::mutex mutex;
+		std::condition_variable wake;
+		std::deque< Dump > queue;
+		bool stopping = false;
+		std::thread thread; //(started with the first dump)
+
+		void push(Dump &&dump) {
+			std::unique_lock< std::mutex > lock(mutex);
+			queue.emplace_back(std::move(dump));
+			if (!thread.joinable()) thread = std::thread([this](){ run(); });
+			wake.notify_one();
+		}
+		void run() {
+			FlightRecorder::name_thread("flight recorder");
+			while (true) {
+				Dump dump;
+				{
+					std::unique_lock< std::mutex > lock(mutex);
+					wake.wait(lock, [this](){ return stopping || !queue.empty(); });
+					if (queue.empty()) return; //(stopping, and nothing left to write)
+					dump = std::move(queue.front());
+					queue.pop_front();
+				}
+				write(dump);
+			}
+		}
+		//(at exit, finishes any dumps still waiting)
+		~Writer() {
+			{
+				std::unique_lock< std::mutex > lock(mutex);
+				stopping = true;
+			}
+			wake.notify_one();
+			if (thread.joinable()) thread.join();
+		}
+	} writer;
+}
+
+double FlightRecorder::seconds(uint64_t ticks) {
+	return ticks / ticks_per_second();
+}
+
+void FlightRecorder::record(char const *name, uint64_t begin, uint64_t end) {
+	Ring *ring = local_ring();
+	if (!ring) return;
+	uint64_t at = ring->count.load(std::memory_order_relaxed);
+	Ring::Event &event = ring->events[at % RingSize];
+	event.name.store(name, std::memory_order_relaxed);
+	event.begin.store(begin, std::memory_order_relaxed);
+	event.end.store(end, std::memory_order_relaxed);
+	ring->count.store(at + 1, std::memory_order_release);
+}
+
+void FlightRecorder::name_thread(char const *name) {
+	if (Ring *ring = local_ring()) ring->name.store(name, std::memory_order_relaxed);
+}
+
+void FlightRecorder::configure(char const *prefix_, double budget_) {
+	prefix = prefix_;
+	budget.store(budget_, std::memory_order_relaxed);
+}
+
+FlightRecorder::Watch::~Watch() {
+	uint64_t end = now();
+	record(name, begin, end);
+
+	double limit = budget.load(std::memory_order_relaxed);
+	if (limit <= 0.0) return;
+	double took = seconds(end - begin);
+	if (took <= limit) return;
+
+	std::ostringstream reason;
+	reason << name << " took " << std::fixed << std::setprecision(2) << (took * 1000.0) << "ms (budget " << (limit * 1000.0) << "ms)";
+	dump(reason.str().c_str());
+}
+
+bool FlightRecorder::dump(char const *reason) {
+	std::unique_lock< std::mutex > lock(dump_mutex);
+
+	auto time = std::chrono::steady_clock::now();
+	if (dumps >= MaxDumps) return false;
+	if (dumps > 0 && std::chrono::duration< double >(time - last_dump).count() < DumpCooldown) {
+		skipped += 1;
+		return false;
+	}
+	dumps += 1;
+	last_dump = time;
+
+	//copy out recent events (here, before they're overwritten; the writer thread does the rest):
+	Dump dump = collect(now() - uint64_t(WindowSeconds * ticks_per_second()));
+	dump.reason = reason;
+	dump.filename = prefix + "-hitch-" + std::to_string(dumps) + ".json";
+	dump.number = dumps;
+	dump.skipped = skipped;
+	skipped = 0;
+
+	writer.push(std::move(dump));
+	return true;
+}
+
+bool FlightRecorder::write_trace(std::string const &path, size_t *events) {
+	Dump dump = collect(0);
+	if (events) *events = dump.events.size();
+	return write_events(dump, path);
+}
+
+namespace {
+	//copy the events that ended at or after 'cutoff' out of every ring:
+	Dump collect(uint64_t cutoff) {
+		Dump dump;
+		auto &events = dump.events;
+
+		uint32_t used = std::min< uint32_t >(ring_count.load(std::memory_order_relaxed), MaxThreads);
+		for (uint32_t r = 0; r < used; ++r) {
+			Ring const *ring = rings[r].load(std::memory_order_acquire);
+			if (!ring) continue; //(still being created)
+			if (char const *name = ring->name.load(std::memory_order_relaxed)) dump.thread_names.emplace_back(ring->tid, name);
+
+			size_t first = events.size();
+			uint64_t count = ring->count.load(std::memory_order_acquire);
+			for (uint64_t i = (count > FlightRecorder::RingSize ? count - FlightRecorder::RingSize : 0); i < count; ++i) {
+				Ring::Event const &event = ring->events[i % FlightRecorder::RingSize];
+				events.emplace_back(Dump::Event{
+					event.name.load(std::memory_order_relaxed),
+					event.begin.load(std::memory_order_relaxed),
+					event.end.load(std::memory_order_relaxed),
+					ring->tid
+				});
+			}
+			//the owning thread keeps recording while this copies, so drop any slots it may have reused since:
+			std::atomic_thread_fence(std::memory_order_acquire);
+			uint64_t after = ring->count.load(std::memory_order_relaxed);
+			uint64_t valid = (after + 1 > FlightRecorder::RingSize ? after + 1 - FlightRecorder::RingSize : 0); //(first index certainly not overwritten)
+			uint64_t copied_from = (count > FlightRecorder::RingSize ? count - FlightRecorder::RingSize : 0);
+			if (valid > copied_from) {
+				events.erase(events.begin() + first, events.begin() + first + std::min< size_t >(valid - copied_from, events.size() - first));
+			}
+		}
+		events.erase(std::remove_if(events.begin(), events.end(), [&](Dump::Event const &e) {
+			return e.name == nullptr || e.end < cutoff;
+		}), events.end());
+
+		//(dumps start at the cutoff; whole traces at their first event)
+		dump.start = (cutoff ? cutoff : ~uint64_t(0));
+		for (auto const &e : events) dump.start = std::min(dump.start, e.begin);
+		dump.rate = ticks_per_second();
+		return dump;
+	}
+
+	bool write_events(Dump const &dump, std::string const &filename) {
+		std::ofstream out(filename, std::ios::binary);
+		std::vector< std::pair< std::string, std::string > > other_data;
+		if (!dump.reason.empty()) other_data.emplace_back("reason", dump.reason);
+		ChromeTraceWriter trace(out, other_data);
+		for (auto const &[tid, name] : dump.thread_names) {
+			trace.thread_name(tid, name);
+		}
+		for (auto const &e : dump.events) {
+			trace.complete(e.name, e.tid, (e.begin - dump.start) / dump.rate * 1e6, (e.end - e.begin) / dump.rate * 1e6);
+		}
+		trace.finish();
+		return bool(out);
+	}
+
+	void write(Dump const &dump) {
+		if (!write_events(dump, dump.filename)) {
+			std::cerr << "[flight recorder] " << dump.reason << "; failed to write '" << dump.filename << "'." << std::endl;
+			return;
+		}
+		std::cerr << "[flight recorder] " << dump.reason << "; wrote " << dump.events.size() << " events to '" << dump.filename << "'.";
+		if (dump.skipped) std::cerr << " (" << dump.skipped << " more since the last dump weren't written.)";
+		if (dump.number == FlightRecorder::MaxDumps) std::cerr << " (That's the last dump for this run.)";
+		std::cerr << std::endl;
+	}
+}
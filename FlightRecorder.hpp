@@ -0,0 +1,101 @@
+#pragma once
+
+/*
+ * The flight recorder keeps each thread's most recent timed events (frame
+ * phases, uploads, loads, socket reads, audio callbacks) in memory all the
+ * time, and writes the last couple of seconds of them to disk when a frame or
+ * tick runs over budget:
+ *
+ *  FlightRecorder::configure("client", 0.1); //dump to client-hitch-N.json on frames over 100ms
+ *
+ *  while (...) {
+ *  	FlightRecorder::Watch watch("frame"); //records "frame"; dumps when this scope ends, if it took too long
+ *  	...
+ *  	{
+ *  		RECORD_SCOPE("Mode::draw");
+ *  		...
+ *  	}
+ *  }
+ *
+ * Events come from RECORD_SCOPE (and Watch), which are always compiled in,
+ * and threads are named with RECORD_THREAD. Dumps are Chrome trace-event JSON
+ * (load them in chrome://tracing or https://ui.perfetto.dev), covering every thread.
+ *
+ * The optional trace (see Trace.hpp) is written from these same rings, so
+ * RECORD_SCOPE events show up in it too; traced builds keep more of them.
+ *
+ * Since recording is always on, it has to be cheap: a scope reads the CPU's
+ * timestamp counter twice and writes one slot of a per-thread ring (no locks,
+ * no allocation, no shared writes). Dumps are rare; the thread that went over
+ * budget only copies the recent events, and a background thread writes the file.
+ */
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#else
+#include <chrono>
+#endif
+
+namespace FlightRecorder {
+	#ifdef ENABLE_TRACE
+	constexpr size_t RingSize = 1 << 16; //events kept per thread (traced builds write them all out at exit)
+	#else
+	constexpr size_t RingSize = 4096; //events kept per thread
+	#endif
+	constexpr double WindowSeconds = 2.0; //how far back a dump goes
+	constexpr double DumpCooldown = 10.0; //seconds after a dump before another can be written
+	constexpr uint32_t MaxDumps = 20; //(per run)
+
+	//timestamp, in ticks (the timestamp counter on x86-64, otherwise nanoseconds):
+	inline uint64_t now() {
+		#if defined(__x86_64__) || defined(_M_X64)
+		return __rdtsc();
+		#else
+		return uint64_t(std::chrono::duration_cast< std::chrono::nanoseconds >(std::chrono::steady_clock::now().time_since_epoch()).count());
+		#endif
+	}
+	double seconds(uint64_t ticks); //convert a tick count to seconds
+
+	//record a complete event on the calling thread's ring ('name' must outlive the program, e.g. a string literal):
+	void record(char const *name, uint64_t begin, uint64_t end);
+	void name_thread(char const *name);
+
+	//dumps are written to '<prefix>-hitch-<N>.json' when a Watch lasts longer than 'budget' seconds (0 turns dumps off):
+	void configure(char const *prefix, double budget);
+
+	//queue the last WindowSeconds of every thread's events to be written
+	// (returns false if skipped because of MaxDumps or DumpCooldown; write failures are only logged):
+	bool dump(char const *reason);
+
+	//write every event still in the rings (not just the last WindowSeconds) to 'path' on the calling thread;
+	// returns false if the file couldn't be written:
+	bool write_trace(std::string const &path, size_t *events = nullptr);
+
+	struct Scope {
+		Scope(char const *name_) : name(name_), begin(now()) { }
+		~Scope() { record(name, begin, now()); }
+		char const *name;
+		uint64_t begin;
+	};
+
+	//records the enclosing scope like Scope, then dumps the recorder if it ran over budget:
+	struct Watch {
+		Watch(char const *name_) : name(name_), begin(now()) { }
+		~Watch();
+		char const *name;
+		uint64_t begin;
+	};
+}
+
+#define RECORD_CONCAT2(a, b) a ## b
+#define RECORD_CONCAT(a, b) RECORD_CONCAT2(a, b)
+#define RECORD_SCOPE(name) FlightRecorder::Scope RECORD_CONCAT(record_scope_, __LINE__)(name)
+#define RECORD_THREAD(name) FlightRecorder::name_thread(name)
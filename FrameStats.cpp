@@ -0,0 +1,190 @@
+#include "FrameStats.hpp"
+
+#include "DrawLines.hpp"
+#include "Metrics.hpp"
+#include "GL.hpp"
+#include "gl_errors.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+void FrameStats::begin_frame() {
+	Clock::time_point now = Clock::now();
+
+	#ifdef ENABLE_GL_STATS
+	GLStats::end_frame();
+	#endif
+
+	if (started) {
+		current.seconds = std::chrono::duration< float >(now - frame_begin).count();
+		current.vertices = uint32_t(DrawLines::vertices_submitted - vertex_mark - overlay_vertices);
+		frames[recorded % History] = current;
+		recorded += 1;
+	} else {
+		net_begin = now;
+		net_received_mark = Metrics::total(Metrics::SocketBytesReceived);
+		net_sent_mark = Metrics::total(Metrics::SocketBytesSent);
+		started = true;
+	}
+
+	current = Frame();
+	frame_begin = now;
+	vertex_mark = DrawLines::vertices_submitted;
+	overlay_vertices = 0;
+
+	//update network rates about once a second:
+	double net_elapsed = std::chrono::duration< double >(now - net_begin).count();
+	if (net_elapsed >= 1.0) {
+		uint64_t received = Metrics::total(Metrics::SocketBytesReceived);
+		uint64_t sent = Metrics::total(Metrics::SocketBytesSent);
+		net_received_rate = (received - net_received_mark) / net_elapsed;
+		net_sent_rate = (sent - net_sent_mark) / net_elapsed;
+		net_received_mark = received;
+		net_sent_mark = sent;
+		net_begin = now;
+	}
+}
+
+void FrameStats::draw(glm::uvec2 const &drawable_size) {
+	size_t vertices_before = DrawLines::vertices_submitted;
+	#ifdef ENABLE_GL_STATS
+	GLStats::Frame const gl_before = GLStats::current; //(the overlay's own calls are taken back out at the end)
+	#endif
+
+	uint32_t count = std::min< uint32_t >(recorded, uint32_t(History));
+	auto frame = [&](uint32_t i) -> Frame const & { //i-th oldest remembered frame
+		return frames[(recorded - count + i) % History];
+	};
+
+	static std::array< glm::u8vec4, PhaseCount > const phase_colors{{
+		glm::u8vec4(0x44, 0xdd, 0xff, 0xff),
+		glm::u8vec4(0x66, 0xff, 0x66, 0xff),
+		glm::u8vec4(0xff, 0xaa, 0x33, 0xff),
+		glm::u8vec4(0x88, 0x88, 0xff, 0xff),
+	}};
+	glm::u8vec4 const white = glm::u8vec4(0xff, 0xff, 0xff, 0xff);
+	glm::u8vec4 const gray = glm::u8vec4(0x88, 0x88, 0x88, 0xff);
+
+	std::vector< std::pair< std::string, glm::u8vec4 > > text;
+	auto ms = [](double seconds) {
+		std::ostringstream str;
+		str << std::fixed << std::setprecision(2) << (seconds * 1000.0);
+		return str.str();
+	};
+
+	if (count == 0) {
+		text.emplace_back("(no frames yet)", white);
+	} else {
+		std::vector< float > seconds;
+		seconds.reserve(count);
+		double total = 0.0;
+		uint64_t vertices = 0;
+		for (uint32_t i = 0; i < count; ++i) {
+			seconds.emplace_back(frame(i).seconds);
+			total += frame(i).seconds;
+			vertices += frame(i).vertices;
+		}
+		std::sort(seconds.begin(), seconds.end());
+		auto percentile = [&](double p) {
+			return seconds[std::min< size_t >(count - 1, size_t(p * count))];
+		};
+
+		{
+			std::ostringstream line;
+			line << "frame " << ms(total / count) << "ms avg (" << std::fixed << std::setprecision(0) << (count / total) << " fps) over " << count << " frames";
+			text.emplace_back(line.str(), white);
+		}
+		text.emplace_back("  p50 " + ms(percentile(0.50)) + "  p95 " + ms(percentile(0.95)) + "  p99 " + ms(percentile(0.99)) + "  max " + ms(seconds.back()), white);
+
+		for (uint32_t p = 0; p < PhaseCount; ++p) {
+			double sum = 0.0;
+			float worst = 0.0f;
+			for (uint32_t i = 0; i < count; ++i) {
+				sum += frame(i).phases[p];
+				worst = std::max(worst, frame(i).phases[p]);
+			}
+			std::ostringstream line;
+			line << std::left << std::setw(7) << PhaseNames[p] << ms(sum / count) << "ms avg  " << ms(worst) << "ms max";
+			text.emplace_back(line.str(), phase_colors[p]);
+		}
+
+		text.emplace_back("lines " + std::to_string(frame(count - 1).vertices) + " vertices (avg " + std::to_string(vertices / count) + ")", white);
+	}
+	{
+		std::ostringstream line;
+		line << "net " << std::fixed << std::setprecision(0) << net_received_rate << " B/s in, " << net_sent_rate << " B/s out";
+		text.emplace_back(line.str(), white);
+	}
+	#ifdef ENABLE_GL_STATS
+	{ //previous frame's OpenGL calls (see make-GL.py):
+		GLStats::Frame const &gl = GLStats::last;
+		uint32_t calls = 0;
+		std::vector< uint32_t > timed;
+		for (uint32_t f = 0; f < GLStats::FunctionCount; ++f) {
+			calls += gl.calls[f];
+			if (gl.seconds[f] > 0.0) timed.emplace_back(f);
+		}
+		std::sort(timed.begin(), timed.end(), [&](uint32_t a, uint32_t b) { return gl.seconds[a] > gl.seconds[b]; });
+
+		std::ostringstream line;
+		line << "gl " << calls << " calls, " << gl.draw_calls << " draws, " << gl.state_changes << " state changes, "
+			<< std::fixed << std::setprecision(1) << (gl.upload_bytes / 1024.0) << " KiB uploaded";
+		text.emplace_back(line.str(), white);
+		for (size_t i = 0; i < timed.size() && i < 3; ++i) {
+			text.emplace_back("  " + std::string(GLStats::FunctionNames[timed[i]]) + " x" + std::to_string(gl.calls[timed[i]]) + " " + ms(gl.seconds[timed[i]]) + "ms", gray);
+		}
+	}
+	#endif
+
+	//overlay in a [-aspect,aspect]x[-1,1] box, over whatever was drawn:
+	float aspect = float(drawable_size.x) / float(drawable_size.y);
+	glm::mat4 world_to_clip = glm::mat4(
+		1.0f / aspect, 0.0f, 0.0f, 0.0f,
+		0.0f, 1.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 1.0f, 0.0f,
+		0.0f, 0.0f, 0.0f, 1.0f
+	);
+	glDisable(GL_DEPTH_TEST);
+
+	{
+		DrawLines lines(world_to_clip);
+
+		//graph of recent frames (oldest to newest), each split into its phases:
+		float const bar = std::min(0.005f, 1.5f * aspect / History); //(width per frame)
+		float const unit = 0.25f / (1.0f / 30.0f); //(height per second)
+		glm::vec3 const base = glm::vec3(-aspect + 0.05f, -0.95f, 0.0f);
+		for (float budget : { 1.0f / 60.0f, 1.0f / 30.0f }) {
+			lines.draw(base + glm::vec3(0.0f, budget * unit, 0.0f), base + glm::vec3(bar * History, budget * unit, 0.0f), gray);
+		}
+		for (uint32_t i = 0; i < count; ++i) {
+			Frame const &f = frame(i);
+			glm::vec3 at = base + glm::vec3(bar * i, 0.0f, 0.0f);
+			float top = std::min(f.seconds, 2.0f / 30.0f) * unit;
+			float y = 0.0f;
+			for (uint32_t p = 0; p < PhaseCount && y < top; ++p) {
+				float h = std::min(f.phases[p] * unit, top - y);
+				lines.draw(at + glm::vec3(0.0f, y, 0.0f), at + glm::vec3(0.0f, y + h, 0.0f), phase_colors[p]);
+				y += h;
+			}
+			//(rest of the frame: time outside the measured phases)
+			if (y < top) lines.draw(at + glm::vec3(0.0f, y, 0.0f), at + glm::vec3(0.0f, top, 0.0f), gray);
+		}
+
+		float const H = 0.04f;
+		glm::vec3 at = base + glm::vec3(0.0f, 2.0f / 30.0f * unit + 0.5f * H + 1.5f * H * text.size(), 0.0f);
+		for (auto const &[line, color] : text) {
+			lines.draw_text(line, at, glm::vec3(H, 0.0f, 0.0f), glm::vec3(0.0f, H, 0.0f), color);
+			at.y -= 1.5f * H;
+		}
+	}
+
+	GL_ERRORS();
+
+	overlay_vertices += DrawLines::vertices_submitted - vertices_before;
+	#ifdef ENABLE_GL_STATS
+	GLStats::current = gl_before;
+	#endif
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+/*
+ * FrameStats keeps per-frame timings for the client's main loop and draws
+ * them as an on-screen overlay (toggled with F2):
+ *
+ *  FrameStats stats;
+ *  while (...) {
+ *  	stats.begin_frame();
+ *  	{ FrameStats::Scope scope(stats, FrameStats::Update); mode->update(elapsed); }
+ *  	...
+ *  	if (stats.visible) stats.draw(drawable_size);
+ *  	SDL_GL_SwapWindow(window);
+ *  }
+ *
+ * The overlay shows the average and worst time of each phase over recent
+ * frames, frame-time percentiles, the DrawLines vertices submitted per frame,
+ * network traffic, and a graph of recent frames split by phase. Builds with
+ * ENABLE_GL_STATS (see make-GL.py) also show the previous frame's OpenGL call
+ * counts and slowest calls, leaving out the overlay's own calls.
+ */
+
+#include "FlightRecorder.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+struct FrameStats {
+	enum Phase : uint32_t {
+		Events,
+		Update,
+		Draw,
+		Swap,
+		PhaseCount
+	};
+	inline static constexpr std::array< char const *, PhaseCount > PhaseNames{{ "events", "update", "draw", "swap" }};
+	static constexpr size_t History = 240; //frames remembered (and graphed)
+
+	//start a new frame (finishing the previous one):
+	void begin_frame();
+
+	//time spent in 'phase' this frame (seconds; may be added to more than once):
+	void add(Phase phase, double seconds) { current.phases[phase] += float(seconds); }
+
+	//times a block of code as 'phase' (also recording it in the flight recorder, under its name from PhaseNames):
+	struct Scope {
+		Scope(FrameStats &stats_, Phase phase_) : stats(stats_), phase(phase_), record(PhaseNames[phase_]), begin(Clock::now()) { }
+		~Scope() { stats.add(phase, std::chrono::duration< double >(Clock::now() - begin).count()); }
+		FrameStats &stats;
+		Phase phase;
+		FlightRecorder::Scope record;
+		std::chrono::steady_clock::time_point begin;
+	};
+
+	//draw the overlay over the current frame (its own lines aren't counted):
+	void draw(glm::uvec2 const &drawable_size);
+
+	bool visible = false;
+
+	//---- internals ----
+	using Clock = std::chrono::steady_clock;
+
+	struct Frame {
+		float seconds = 0.0f; //from this frame's start to the next's
+		std::array< float, PhaseCount > phases{};
+		uint32_t vertices = 0; //DrawLines vertices submitted
+	};
+	std::array< Frame, History > frames{}; //(ring, by frame)
+	uint32_t recorded = 0; //frames finished
+
+	Frame current;
+	bool started = false;
+	Clock::time_point frame_begin;
+	size_t vertex_mark = 0; //DrawLines::vertices_submitted as of frame_begin
+	size_t overlay_vertices = 0; //(submitted by draw() this frame)
+
+	//network traffic, measured over about a second:
+	Clock::time_point net_begin;
+	uint64_t net_received_mark = 0, net_sent_mark = 0;
+	double net_received_rate = 0.0, net_sent_rate = 0.0; //bytes per second
+};
@@ -584,3 +584,429 @@ void init_GL() {
 	 void (APIENTRYFP glVertexAttribP4ui) (GLuint index, GLenum type, GLboolean normalized, GLuint value);
 	 void (APIENTRYFP glVertexAttribP4uiv) (GLuint index, GLenum type, GLboolean normalized, const GLuint *value);
 #endif
+
+#ifdef ENABLE_GL_STATS
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+std::array< char const *, GLStats::FunctionCount > const GLStats::FunctionNames{{
+	"glCullFace",
+	"glFrontFace",
+	"glHint",
+	"glLineWidth",
+	"glPointSize",
+	"glPolygonMode",
+	"glScissor",
+	"glTexParameterf",
+	"glTexParameterfv",
+	"glTexParameteri",
+	"glTexParameteriv",
+	"glTexImage1D",
+	"glTexImage2D",
+	"glDrawBuffer",
+	"glClear",
+	"glClearColor",
+	"glClearStencil",
+	"glClearDepth",
+	"glStencilMask",
+	"glColorMask",
+	"glDepthMask",
+	"glDisable",
+	"glEnable",
+	"glFinish",
+	"glFlush",
+	"glBlendFunc",
+	"glLogicOp",
+	"glStencilFunc",
+	"glStencilOp",
+	"glDepthFunc",
+	"glPixelStoref",
+	"glPixelStorei",
+	"glReadBuffer",
+	"glReadPixels",
+	"glGetBooleanv",
+	"glGetDoublev",
+	"glGetError",
+	"glGetFloatv",
+	"glGetIntegerv",
+	"glGetString",
+	"glGetTexImage",
+	"glGetTexParameterfv",
+	"glGetTexParameteriv",
+	"glGetTexLevelParameterfv",
+	"glGetTexLevelParameteriv",
+	"glIsEnabled",
+	"glDepthRange",
+	"glViewport",
+	"glDrawArrays",
+	"glDrawElements",
+	"glGetPointerv",
+	"glPolygonOffset",
+	"glCopyTexImage1D",
+	"glCopyTexImage2D",
+	"glCopyTexSubImage1D",
+	"glCopyTexSubImage2D",
+	"glTexSubImage1D",
+	"glTexSubImage2D",
+	"glBindTexture",
+	"glDeleteTextures",
+	"glGenTextures",
+	"glIsTexture",
+	"glDrawRangeElements",
+	"glTexImage3D",
+	"glTexSubImage3D",
+	"glCopyTexSubImage3D",
+	"glActiveTexture",
+	"glSampleCoverage",
+	"glCompressedTexImage3D",
+	"glCompressedTexImage2D",
+	"glCompressedTexImage1D",
+	"glCompressedTexSubImage3D",
+	"glCompressedTexSubImage2D",
+	"glCompressedTexSubImage1D",
+	"glGetCompressedTexImage",
+	"glBlendFuncSeparate",
+	"glMultiDrawArrays",
+	"glMultiDrawElements",
+	"glPointParameterf",
+	"glPointParameterfv",
+	"glPointParameteri",
+	"glPointParameteriv",
+	"glBlendColor",
+	"glBlendEquation",
+	"glGenQueries",
+	"glDeleteQueries",
+	"glIsQuery",
+	"glBeginQuery",
+	"glEndQuery",
+	"glGetQueryiv",
+	"glGetQueryObjectiv",
+	"glGetQueryObjectuiv",
+	"glBindBuffer",
+	"glDeleteBuffers",
+	"glGenBuffers",
+	"glIsBuffer",
+	"glBufferData",
+	"glBufferSubData",
+	"glGetBufferSubData",
+	"glMapBuffer",
+	"glUnmapBuffer",
+	"glGetBufferParameteriv",
+	"glGetBufferPointerv",
+	"glBlendEquationSeparate",
+	"glDrawBuffers",
+	"glStencilOpSeparate",
+	"glStencilFuncSeparate",
+	"glStencilMaskSeparate",
+	"glAttachShader",
+	"glBindAttribLocation",
+	"glCompileShader",
+	"glCreateProgram",
+	"glCreateShader",
+	"glDeleteProgram",
+	"glDeleteShader",
+	"glDetachShader",
+	"glDisableVertexAttribArray",
+	"glEnableVertexAttribArray",
+	"glGetActiveAttrib",
+	"glGetActiveUniform",
+	"glGetAttachedShaders",
+	"glGetAttribLocation",
+	"glGetProgramiv",
+	"glGetProgramInfoLog",
+	"glGetShaderiv",
+	"glGetShaderInfoLog",
+	"glGetShaderSource",
+	"glGetUniformLocation",
+	"glGetUniformfv",
+	"glGetUniformiv",
+	"glGetVertexAttribdv",
+	"glGetVertexAttribfv",
+	"glGetVertexAttribiv",
+	"glGetVertexAttribPointerv",
+	"glIsProgram",
+	"glIsShader",
+	"glLinkProgram",
+	"glShaderSource",
+	"glUseProgram",
+	"glUniform1f",
+	"glUniform2f",
+	"glUniform3f",
+	"glUniform4f",
+	"glUniform1i",
+	"glUniform2i",
+	"glUniform3i",
+	"glUniform4i",
+	"glUniform1fv",
+	"glUniform2fv",
+	"glUniform3fv",
+	"glUniform4fv",
+	"glUniform1iv",
+	"glUniform2iv",
+	"glUniform3iv",
+	"glUniform4iv",
+	"glUniformMatrix2fv",
+	"glUniformMatrix3fv",
+	"glUniformMatrix4fv",
+	"glValidateProgram",
+	"glVertexAttrib1d",
+	"glVertexAttrib1dv",
+	"glVertexAttrib1f",
+	"glVertexAttrib1fv",
+	"glVertexAttrib1s",
+	"glVertexAttrib1sv",
+	"glVertexAttrib2d",
+	"glVertexAttrib2dv",
+	"glVertexAttrib2f",
+	"glVertexAttrib2fv",
+	"glVertexAttrib2s",
+	"glVertexAttrib2sv",
+	"glVertexAttrib3d",
+	"glVertexAttrib3dv",
+	"glVertexAttrib3f",
+	"glVertexAttrib3fv",
+	"glVertexAttrib3s",
+	"glVertexAttrib3sv",
+	"glVertexAttrib4Nbv",
+	"glVertexAttrib4Niv",
+	"glVertexAttrib4Nsv",
+	"glVertexAttrib4Nub",
+	"glVertexAttrib4Nubv",
+	"glVertexAttrib4Nuiv",
+	"glVertexAttrib4Nusv",
+	"glVertexAttrib4bv",
+	"glVertexAttrib4d",
+	"glVertexAttrib4dv",
+	"glVertexAttrib4f",
+	"glVertexAttrib4fv",
+	"glVertexAttrib4iv",
+	"glVertexAttrib4s",
+	"glVertexAttrib4sv",
+	"glVertexAttrib4ubv",
+	"glVertexAttrib4uiv",
+	"glVertexAttrib4usv",
+	"glVertexAttribPointer",
+	"glUniformMatrix2x3fv",
+	"glUniformMatrix3x2fv",
+	"glUniformMatrix2x4fv",
+	"glUniformMatrix4x2fv",
+	"glUniformMatrix3x4fv",
+	"glUniformMatrix4x3fv",
+	"glColorMaski",
+	"glGetBooleani_v",
+	"glGetIntegeri_v",
+	"glEnablei",
+	"glDisablei",
+	"glIsEnabledi",
+	"glBeginTransformFeedback",
+	"glEndTransformFeedback",
+	"glBindBufferRange",
+	"glBindBufferBase",
+	"glTransformFeedbackVaryings",
+	"glGetTransformFeedbackVarying",
+	"glClampColor",
+	"glBeginConditionalRender",
+	"glEndConditionalRender",
+	"glVertexAttribIPointer",
+	"glGetVertexAttribIiv",
+	"glGetVertexAttribIuiv",
+	"glVertexAttribI1i",
+	"glVertexAttribI2i",
+	"glVertexAttribI3i",
+	"glVertexAttribI4i",
+	"glVertexAttribI1ui",
+	"glVertexAttribI2ui",
+	"glVertexAttribI3ui",
+	"glVertexAttribI4ui",
+	"glVertexAttribI1iv",
+	"glVertexAttribI2iv",
+	"glVertexAttribI3iv",
+	"glVertexAttribI4iv",
+	"glVertexAttribI1uiv",
+	"glVertexAttribI2uiv",
+	"glVertexAttribI3uiv",
+	"glVertexAttribI4uiv",
+	"glVertexAttribI4bv",
+	"glVertexAttribI4sv",
+	"glVertexAttribI4ubv",
+	"glVertexAttribI4usv",
+	"glGetUniformuiv",
+	"glBindFragDataLocation",
+	"glGetFragDataLocation",
+	"glUniform1ui",
+	"glUniform2ui",
+	"glUniform3ui",
+	"glUniform4ui",
+	"glUniform1uiv",
+	"glUniform2uiv",
+	"glUniform3uiv",
+	"glUniform4uiv",
+	"glTexParameterIiv",
+	"glTexParameterIuiv",
+	"glGetTexParameterIiv",
+	"glGetTexParameterIuiv",
+	"glClearBufferiv",
+	"glClearBufferuiv",
+	"glClearBufferfv",
+	"glClearBufferfi",
+	"glGetStringi",
+	"glIsRenderbuffer",
+	"glBindRenderbuffer",
+	"glDeleteRenderbuffers",
+	"glGenRenderbuffers",
+	"glRenderbufferStorage",
+	"glGetRenderbufferParameteriv",
+	"glIsFramebuffer",
+	"glBindFramebuffer",
+	"glDeleteFramebuffers",
+	"glGenFramebuffers",
+	"glCheckFramebufferStatus",
+	"glFramebufferTexture1D",
+	"glFramebufferTexture2D",
+	"glFramebufferTexture3D",
+	"glFramebufferRenderbuffer",
+	"glGetFramebufferAttachmentParameteriv",
+	"glGenerateMipmap",
+	"glBlitFramebuffer",
+	"glRenderbufferStorageMultisample",
+	"glFramebufferTextureLayer",
+	"glMapBufferRange",
+	"glFlushMappedBufferRange",
+	"glBindVertexArray",
+	"glDeleteVertexArrays",
+	"glGenVertexArrays",
+	"glIsVertexArray",
+	"glDrawArraysInstanced",
+	"glDrawElementsInstanced",
+	"glTexBuffer",
+	"glPrimitiveRestartIndex",
+	"glCopyBufferSubData",
+	"glGetUniformIndices",
+	"glGetActiveUniformsiv",
+	"glGetActiveUniformName",
+	"glGetUniformBlockIndex",
+	"glGetActiveUniformBlockiv",
+	"glGetActiveUniformBlockName",
+	"glUniformBlockBinding",
+	"glDrawElementsBaseVertex",
+	"glDrawRangeElementsBaseVertex",
+	"glDrawElementsInstancedBaseVertex",
+	"glMultiDrawElementsBaseVertex",
+	"glProvokingVertex",
+	"glFenceSync",
+	"glIsSync",
+	"glDeleteSync",
+	"glClientWaitSync",
+	"glWaitSync",
+	"glGetInteger64v",
+	"glGetSynciv",
+	"glGetInteger64i_v",
+	"glGetBufferParameteri64v",
+	"glFramebufferTexture",
+	"glTexImage2DMultisample",
+	"glTexImage3DMultisample",
+	"glGetMultisamplefv",
+	"glSampleMaski",
+	"glBindFragDataLocationIndexed",
+	"glGetFragDataIndex",
+	"glGenSamplers",
+	"glDeleteSamplers",
+	"glIsSampler",
+	"glBindSampler",
+	"glSamplerParameteri",
+	"glSamplerParameteriv",
+	"glSamplerParameterf",
+	"glSamplerParameterfv",
+	"glSamplerParameterIiv",
+	"glSamplerParameterIuiv",
+	"glGetSamplerParameteriv",
+	"glGetSamplerParameterIiv",
+	"glGetSamplerParameterfv",
+	"glGetSamplerParameterIuiv",
+	"glQueryCounter",
+	"glGetQueryObjecti64v",
+	"glGetQueryObjectui64v",
+	"glVertexAttribDivisor",
+	"glVertexAttribP1ui",
+	"glVertexAttribP1uiv",
+	"glVertexAttribP2ui",
+	"glVertexAttribP2uiv",
+	"glVertexAttribP3ui",
+	"glVertexAttribP3uiv",
+	"glVertexAttribP4ui",
+	"glVertexAttribP4uiv",
+}};
+
+GLStats::Frame GLStats::current;
+GLStats::Frame GLStats::last;
+
+void GLStats::end_frame() {
+	last = current;
+	current = Frame();
+}
+
+std::string GLStats::report(Frame const &frame) {
+	std::vector< uint32_t > called;
+	uint32_t total = 0;
+	for (uint32_t f = 0; f < FunctionCount; ++f) {
+		if (frame.calls[f] == 0) continue;
+		called.emplace_back(f);
+		total += frame.calls[f];
+	}
+	std::stable_sort(called.begin(), called.end(), [&](uint32_t a, uint32_t b) {
+		return frame.calls[a] > frame.calls[b];
+	});
+
+	std::ostringstream out;
+	out << total << " calls, " << frame.draw_calls << " draws, " << frame.state_changes << " state changes, "
+		<< frame.upload_bytes << " bytes uploaded\n";
+	out << std::fixed << std::setprecision(3);
+	for (uint32_t f : called) {
+		out << "  " << std::left << std::setw(28) << FunctionNames[f] << std::right << std::setw(6) << frame.calls[f];
+		if (frame.seconds[f] > 0.0) out << "  " << (frame.seconds[f] * 1000.0) << "ms";
+		out << "\n";
+	}
+	return out.str();
+}
+
+uint32_t GLStats::texel_bytes(GLenum format, GLenum type) {
+	//packed types hold a whole texel:
+	switch (type) {
+		case GL_UNSIGNED_BYTE_3_3_2: case GL_UNSIGNED_BYTE_2_3_3_REV:
+			return 1;
+		case GL_UNSIGNED_SHORT_5_6_5: case GL_UNSIGNED_SHORT_5_6_5_REV:
+		case GL_UNSIGNED_SHORT_4_4_4_4: case GL_UNSIGNED_SHORT_4_4_4_4_REV:
+		case GL_UNSIGNED_SHORT_5_5_5_1: case GL_UNSIGNED_SHORT_1_5_5_5_REV:
+			return 2;
+		case GL_UNSIGNED_INT_8_8_8_8: case GL_UNSIGNED_INT_8_8_8_8_REV:
+		case GL_UNSIGNED_INT_10_10_10_2: case GL_UNSIGNED_INT_2_10_10_10_REV:
+		case GL_UNSIGNED_INT_24_8: case GL_UNSIGNED_INT_10F_11F_11F_REV: case GL_UNSIGNED_INT_5_9_9_9_REV:
+			return 4;
+		case GL_FLOAT_32_UNSIGNED_INT_24_8_REV:
+			return 8;
+	}
+	uint32_t component = 0;
+	switch (type) {
+		case GL_UNSIGNED_BYTE: case GL_BYTE: component = 1; break;
+		case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT: component = 2; break;
+		case GL_UNSIGNED_INT: case GL_INT: case GL_FLOAT: component = 4; break;
+		default: return 0;
+	}
+	switch (format) {
+		case GL_RED: case GL_GREEN: case GL_BLUE: case GL_RED_INTEGER: case GL_GREEN_INTEGER: case GL_BLUE_INTEGER:
+		case GL_DEPTH_COMPONENT: case GL_STENCIL_INDEX:
+			return component;
+		case GL_RG: case GL_RG_INTEGER: case GL_DEPTH_STENCIL:
+			return 2 * component;
+		case GL_RGB: case GL_BGR: case GL_RGB_INTEGER: case GL_BGR_INTEGER:
+			return 3 * component;
+		case GL_RGBA: case GL_BGRA: case GL_RGBA_INTEGER: case GL_BGRA_INTEGER:
+			return 4 * component;
+		default: return 0;
+	}
+}
+
+#endif //ENABLE_GL_STATS
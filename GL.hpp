@@ -1277,3 +1277,2179 @@ GLAPI void (APIENTRYFP glVertexAttribP4ui) (GLuint index, GLenum type, GLboolean
 GLAPI void (APIENTRYFP glVertexAttribP4uiv) (GLuint index, GLenum type, GLboolean normalized, const GLuint *value);
 
 }
+
+//------------------------------------------------------------
+//Per-frame call statistics (compiled in with ENABLE_GL_STATS):
+// every gl call goes through a wrapper that counts it; draws, state changes, and
+// buffer and texture uploads are totaled, and a few calls are timed (see make-GL.py for which).
+// Call GLStats::end_frame() once per frame, then read GLStats::last.
+
+#ifdef ENABLE_GL_STATS
+
+#include <array>
+#include <chrono>
+#include <string>
+
+namespace GLStats {
+	enum Function : uint32_t {
+		Call_glCullFace,
+		Call_glFrontFace,
+		Call_glHint,
+		Call_glLineWidth,
+		Call_glPointSize,
+		Call_glPolygonMode,
+		Call_glScissor,
+		Call_glTexParameterf,
+		Call_glTexParameterfv,
+		Call_glTexParameteri,
+		Call_glTexParameteriv,
+		Call_glTexImage1D,
+		Call_glTexImage2D,
+		Call_glDrawBuffer,
+		Call_glClear,
+		Call_glClearColor,
+		Call_glClearStencil,
+		Call_glClearDepth,
+		Call_glStencilMask,
+		Call_glColorMask,
+		Call_glDepthMask,
+		Call_glDisable,
+		Call_glEnable,
+		Call_glFinish,
+		Call_glFlush,
+		Call_glBlendFunc,
+		Call_glLogicOp,
+		Call_glStencilFunc,
+		Call_glStencilOp,
+		Call_glDepthFunc,
+		Call_glPixelStoref,
+		Call_glPixelStorei,
+		Call_glReadBuffer,
+		Call_glReadPixels,
+		Call_glGetBooleanv,
+		Call_glGetDoublev,
+		Call_glGetError,
+		Call_glGetFloatv,
+		Call_glGetIntegerv,
+		Call_glGetString,
+		Call_glGetTexImage,
+		Call_glGetTexParameterfv,
+		Call_glGetTexParameteriv,
+		Call_glGetTexLevelParameterfv,
+		Call_glGetTexLevelParameteriv,
+		Call_glIsEnabled,
+		Call_glDepthRange,
+		Call_glViewport,
+		Call_glDrawArrays,
+		Call_glDrawElements,
+		Call_glGetPointerv,
+		Call_glPolygonOffset,
+		Call_glCopyTexImage1D,
+		Call_glCopyTexImage2D,
+		Call_glCopyTexSubImage1D,
+		Call_glCopyTexSubImage2D,
+		Call_glTexSubImage1D,
+		Call_glTexSubImage2D,
+		Call_glBindTexture,
+		Call_glDeleteTextures,
+		Call_glGenTextures,
+		Call_glIsTexture,
+		Call_glDrawRangeElements,
+		Call_glTexImage3D,
+		Call_glTexSubImage3D,
+		Call_glCopyTexSubImage3D,
+		Call_glActiveTexture,
+		Call_glSampleCoverage,
+		Call_glCompressedTexImage3D,
+		Call_glCompressedTexImage2D,
+		Call_glCompressedTexImage1D,
+		Call_glCompressedTexSubImage3D,
+		Call_glCompressedTexSubImage2D,
+		Call_glCompressedTexSubImage1D,
+		Call_glGetCompressedTexImage,
+		Call_glBlendFuncSeparate,
+		Call_glMultiDrawArrays,
+		Call_glMultiDrawElements,
+		Call_glPointParameterf,
+		Call_glPointParameterfv,
+		Call_glPointParameteri,
+		Call_glPointParameteriv,
+		Call_glBlendColor,
+		Call_glBlendEquation,
+		Call_glGenQueries,
+		Call_glDeleteQueries,
+		Call_glIsQuery,
+		Call_glBeginQuery,
+		Call_glEndQuery,
+		Call_glGetQueryiv,
+		Call_glGetQueryObjectiv,
+		Call_glGetQueryObjectuiv,
+		Call_glBindBuffer,
+		Call_glDeleteBuffers,
+		Call_glGenBuffers,
+		Call_glIsBuffer,
+		Call_glBufferData,
+		Call_glBufferSubData,
+		Call_glGetBufferSubData,
+		Call_glMapBuffer,
+		Call_glUnmapBuffer,
+		Call_glGetBufferParameteriv,
+		Call_glGetBufferPointerv,
+		Call_glBlendEquationSeparate,
+		Call_glDrawBuffers,
+		Call_glStencilOpSeparate,
+		Call_glStencilFuncSeparate,
+		Call_glStencilMaskSeparate,
+		Call_glAttachShader,
+		Call_glBindAttribLocation,
+		Call_glCompileShader,
+		Call_glCreateProgram,
+		Call_glCreateShader,
+		Call_glDeleteProgram,
+		Call_glDeleteShader,
+		Call_glDetachShader,
+		Call_glDisableVertexAttribArray,
+		Call_glEnableVertexAttribArray,
+		Call_glGetActiveAttrib,
+		Call_glGetActiveUniform,
+		Call_glGetAttachedShaders,
+		Call_glGetAttribLocation,
+		Call_glGetProgramiv,
+		Call_glGetProgramInfoLog,
+		Call_glGetShaderiv,
+		Call_glGetShaderInfoLog,
+		Call_glGetShaderSource,
+		Call_glGetUniformLocation,
+		Call_glGetUniformfv,
+		Call_glGetUniformiv,
+		Call_glGetVertexAttribdv,
+		Call_glGetVertexAttribfv,
+		Call_glGetVertexAttribiv,
+		Call_glGetVertexAttribPointerv,
+		Call_glIsProgram,
+		Call_glIsShader,
+		Call_glLinkProgram,
+		Call_glShaderSource,
+		Call_glUseProgram,
+		Call_glUniform1f,
+		Call_glUniform2f,
+		Call_glUniform3f,
+		Call_glUniform4f,
+		Call_glUniform1i,
+		Call_glUniform2i,
+		Call_glUniform3i,
+		Call_glUniform4i,
+		Call_glUniform1fv,
+		Call_glUniform2fv,
+		Call_glUniform3fv,
+		Call_glUniform4fv,
+		Call_glUniform1iv,
+		Call_glUniform2iv,
+		Call_glUniform3iv,
+		Call_glUniform4iv,
+		Call_glUniformMatrix2fv,
+		Call_glUniformMatrix3fv,
+		Call_glUniformMatrix4fv,
+		Call_glValidateProgram,
+		Call_glVertexAttrib1d,
+		Call_glVertexAttrib1dv,
+		Call_glVertexAttrib1f,
+		Call_glVertexAttrib1fv,
+		Call_glVertexAttrib1s,
+		Call_glVertexAttrib1sv,
+		Call_glVertexAttrib2d,
+		Call_glVertexAttrib2dv,
+		Call_glVertexAttrib2f,
+		Call_glVertexAttrib2fv,
+		Call_glVertexAttrib2s,
+		Call_glVertexAttrib2sv,
+		Call_glVertexAttrib3d,
+		Call_glVertexAttrib3dv,
+		Call_glVertexAttrib3f,
+		Call_glVertexAttrib3fv,
+		Call_glVertexAttrib3s,
+		Call_glVertexAttrib3sv,
+		Call_glVertexAttrib4Nbv,
+		Call_glVertexAttrib4Niv,
+		Call_glVertexAttrib4Nsv,
+		Call_glVertexAttrib4Nub,
+		Call_glVertexAttrib4Nubv,
+		Call_glVertexAttrib4Nuiv,
+		Call_glVertexAttrib4Nusv,
+		Call_glVertexAttrib4bv,
+		Call_glVertexAttrib4d,
+		Call_glVertexAttrib4dv,
+		Call_glVertexAttrib4f,
+		Call_glVertexAttrib4fv,
+		Call_glVertexAttrib4iv,
+		Call_glVertexAttrib4s,
+		Call_glVertexAttrib4sv,
+		Call_glVertexAttrib4ubv,
+		Call_glVertexAttrib4uiv,
+		Call_glVertexAttrib4usv,
+		Call_glVertexAttribPointer,
+		Call_glUniformMatrix2x3fv,
+		Call_glUniformMatrix3x2fv,
+		Call_glUniformMatrix2x4fv,
+		Call_glUniformMatrix4x2fv,
+		Call_glUniformMatrix3x4fv,
+		Call_glUniformMatrix4x3fv,
+		Call_glColorMaski,
+		Call_glGetBooleani_v,
+		Call_glGetIntegeri_v,
+		Call_glEnablei,
+		Call_glDisablei,
+		Call_glIsEnabledi,
+		Call_glBeginTransformFeedback,
+		Call_glEndTransformFeedback,
+		Call_glBindBufferRange,
+		Call_glBindBufferBase,
+		Call_glTransformFeedbackVaryings,
+		Call_glGetTransformFeedbackVarying,
+		Call_glClampColor,
+		Call_glBeginConditionalRender,
+		Call_glEndConditionalRender,
+		Call_glVertexAttribIPointer,
+		Call_glGetVertexAttribIiv,
+		Call_glGetVertexAttribIuiv,
+		Call_glVertexAttribI1i,
+		Call_glVertexAttribI2i,
+		Call_glVertexAttribI3i,
+		Call_glVertexAttribI4i,
+		Call_glVertexAttribI1ui,
+		Call_glVertexAttribI2ui,
+		Call_glVertexAttribI3ui,
+		Call_glVertexAttribI4ui,
+		Call_glVertexAttribI1iv,
+		Call_glVertexAttribI2iv,
+		Call_glVertexAttribI3iv,
+		Call_glVertexAttribI4iv,
+		Call_glVertexAttribI1uiv,
+		Call_glVertexAttribI2uiv,
+		Call_glVertexAttribI3uiv,
+		Call_glVertexAttribI4uiv,
+		Call_glVertexAttribI4bv,
+		Call_glVertexAttribI4sv,
+		Call_glVertexAttribI4ubv,
+		Call_glVertexAttribI4usv,
+		Call_glGetUniformuiv,
+		Call_glBindFragDataLocation,
+		Call_glGetFragDataLocation,
+		Call_glUniform1ui,
+		Call_glUniform2ui,
+		Call_glUniform3ui,
+		Call_glUniform4ui,
+		Call_glUniform1uiv,
+		Call_glUniform2uiv,
+		Call_glUniform3uiv,
+		Call_glUniform4uiv,
+		Call_glTexParameterIiv,
+		Call_glTexParameterIuiv,
+		Call_glGetTexParameterIiv,
+		Call_glGetTexParameterIuiv,
+		Call_glClearBufferiv,
+		Call_glClearBufferuiv,
+		Call_glClearBufferfv,
+		Call_glClearBufferfi,
+		Call_glGetStringi,
+		Call_glIsRenderbuffer,
+		Call_glBindRenderbuffer,
+		Call_glDeleteRenderbuffers,
+		Call_glGenRenderbuffers,
+		Call_glRenderbufferStorage,
+		Call_glGetRenderbufferParameteriv,
+		Call_glIsFramebuffer,
+		Call_glBindFramebuffer,
+		Call_glDeleteFramebuffers,
+		Call_glGenFramebuffers,
+		Call_glCheckFramebufferStatus,
+		Call_glFramebufferTexture1D,
+		Call_glFramebufferTexture2D,
+		Call_glFramebufferTexture3D,
+		Call_glFramebufferRenderbuffer,
+		Call_glGetFramebufferAttachmentParameteriv,
+		Call_glGenerateMipmap,
+		Call_glBlitFramebuffer,
+		Call_glRenderbufferStorageMultisample,
+		Call_glFramebufferTextureLayer,
+		Call_glMapBufferRange,
+		Call_glFlushMappedBufferRange,
+		Call_glBindVertexArray,
+		Call_glDeleteVertexArrays,
+		Call_glGenVertexArrays,
+		Call_glIsVertexArray,
+		Call_glDrawArraysInstanced,
+		Call_glDrawElementsInstanced,
+		Call_glTexBuffer,
+		Call_glPrimitiveRestartIndex,
+		Call_glCopyBufferSubData,
+		Call_glGetUniformIndices,
+		Call_glGetActiveUniformsiv,
+		Call_glGetActiveUniformName,
+		Call_glGetUniformBlockIndex,
+		Call_glGetActiveUniformBlockiv,
+		Call_glGetActiveUniformBlockName,
+		Call_glUniformBlockBinding,
+		Call_glDrawElementsBaseVertex,
+		Call_glDrawRangeElementsBaseVertex,
+		Call_glDrawElementsInstancedBaseVertex,
+		Call_glMultiDrawElementsBaseVertex,
+		Call_glProvokingVertex,
+		Call_glFenceSync,
+		Call_glIsSync,
+		Call_glDeleteSync,
+		Call_glClientWaitSync,
+		Call_glWaitSync,
+		Call_glGetInteger64v,
+		Call_glGetSynciv,
+		Call_glGetInteger64i_v,
+		Call_glGetBufferParameteri64v,
+		Call_glFramebufferTexture,
+		Call_glTexImage2DMultisample,
+		Call_glTexImage3DMultisample,
+		Call_glGetMultisamplefv,
+		Call_glSampleMaski,
+		Call_glBindFragDataLocationIndexed,
+		Call_glGetFragDataIndex,
+		Call_glGenSamplers,
+		Call_glDeleteSamplers,
+		Call_glIsSampler,
+		Call_glBindSampler,
+		Call_glSamplerParameteri,
+		Call_glSamplerParameteriv,
+		Call_glSamplerParameterf,
+		Call_glSamplerParameterfv,
+		Call_glSamplerParameterIiv,
+		Call_glSamplerParameterIuiv,
+		Call_glGetSamplerParameteriv,
+		Call_glGetSamplerParameterIiv,
+		Call_glGetSamplerParameterfv,
+		Call_glGetSamplerParameterIuiv,
+		Call_glQueryCounter,
+		Call_glGetQueryObjecti64v,
+		Call_glGetQueryObjectui64v,
+		Call_glVertexAttribDivisor,
+		Call_glVertexAttribP1ui,
+		Call_glVertexAttribP1uiv,
+		Call_glVertexAttribP2ui,
+		Call_glVertexAttribP2uiv,
+		Call_glVertexAttribP3ui,
+		Call_glVertexAttribP3uiv,
+		Call_glVertexAttribP4ui,
+		Call_glVertexAttribP4uiv,
+		FunctionCount
+	};
+	extern std::array< char const *, FunctionCount > const FunctionNames;
+
+	struct Frame {
+		std::array< uint32_t, FunctionCount > calls{};
+		std::array< double, FunctionCount > seconds{}; //(only for timed calls)
+		uint32_t draw_calls = 0;
+		uint32_t state_changes = 0;
+		uint64_t upload_bytes = 0; //buffer data plus texels (ignoring row padding; uploads from a bound GL_PIXEL_UNPACK_BUFFER aren't counted)
+	};
+	extern Frame current; //calls so far this frame
+	extern Frame last; //calls during the previous frame
+
+	//finish the current frame (making it 'last') and start a new one:
+	void end_frame();
+
+	//calls made during 'frame', most frequent first (after a line of totals):
+	std::string report(Frame const &frame);
+
+	//bytes per texel of client data in 'format' and 'type' (0 if unknown):
+	uint32_t texel_bytes(GLenum format, GLenum type);
+
+	struct Timer {
+		Timer(Function function_) : function(function_), begin(std::chrono::steady_clock::now()) { }
+		~Timer() { current.seconds[function] += std::chrono::duration< double >(std::chrono::steady_clock::now() - begin).count(); }
+		Function function;
+		std::chrono::steady_clock::time_point begin;
+	};
+
+	inline void glCullFace (GLenum mode) {
+		current.calls[Call_glCullFace] += 1;
+		current.state_changes += 1;
+		return (::glCullFace)(mode);
+	}
+	inline void glFrontFace (GLenum mode) {
+		current.calls[Call_glFrontFace] += 1;
+		current.state_changes += 1;
+		return (::glFrontFace)(mode);
+	}
+	inline void glHint (GLenum target, GLenum mode) {
+		current.calls[Call_glHint] += 1;
+		return (::glHint)(target, mode);
+	}
+	inline void glLineWidth (GLfloat width) {
+		current.calls[Call_glLineWidth] += 1;
+		return (::glLineWidth)(width);
+	}
+	inline void glPointSize (GLfloat size) {
+		current.calls[Call_glPointSize] += 1;
+		return (::glPointSize)(size);
+	}
+	inline void glPolygonMode (GLenum face, GLenum mode) {
+		current.calls[Call_glPolygonMode] += 1;
+		current.state_changes += 1;
+		return (::glPolygonMode)(face, mode);
+	}
+	inline void glScissor (GLint x, GLint y, GLsizei width, GLsizei height) {
+		current.calls[Call_glScissor] += 1;
+		current.state_changes += 1;
+		return (::glScissor)(x, y, width, height);
+	}
+	inline void glTexParameterf (GLenum target, GLenum pname, GLfloat param) {
+		current.calls[Call_glTexParameterf] += 1;
+		return (::glTexParameterf)(target, pname, param);
+	}
+	inline void glTexParameterfv (GLenum target, GLenum pname, const GLfloat *params) {
+		current.calls[Call_glTexParameterfv] += 1;
+		return (::glTexParameterfv)(target, pname, params);
+	}
+	inline void glTexParameteri (GLenum target, GLenum pname, GLint param) {
+		current.calls[Call_glTexParameteri] += 1;
+		return (::glTexParameteri)(target, pname, param);
+	}
+	inline void glTexParameteriv (GLenum target, GLenum pname, const GLint *params) {
+		current.calls[Call_glTexParameteriv] += 1;
+		return (::glTexParameteriv)(target, pname, params);
+	}
+	inline void glTexImage1D (GLenum target, GLint level, GLint internalformat, GLsizei width, GLint border, GLenum format, GLenum type, const void *pixels) {
+		current.calls[Call_glTexImage1D] += 1;
+		if (pixels) current.upload_bytes += uint64_t(width) * texel_bytes(format, type);
+		return (::glTexImage1D)(target, level, internalformat, width, border, format, type, pixels);
+	}
+	inline void glTexImage2D (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *pixels) {
+		current.calls[Call_glTexImage2D] += 1;
+		if (pixels) current.upload_bytes += uint64_t(width) * uint64_t(height) * texel_bytes(format, type);
+		Timer timer(Call_glTexImage2D);
+		return (::glTexImage2D)(target, level, internalformat, width, height, border, format, type, pixels);
+	}
+	inline void glDrawBuffer (GLenum buf) {
+		current.calls[Call_glDrawBuffer] += 1;
+		current.draw_calls += 1;
+		return (::glDrawBuffer)(buf);
+	}
+	inline void glClear (GLbitfield mask) {
+		current.calls[Call_glClear] += 1;
+		Timer timer(Call_glClear);
+		return (::glClear)(mask);
+	}
+	inline void glClearColor (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+		current.calls[Call_glClearColor] += 1;
+		return (::glClearColor)(red, green, blue, alpha);
+	}
+	inline void glClearStencil (GLint s) {
+		current.calls[Call_glClearStencil] += 1;
+		return (::glClearStencil)(s);
+	}
+	inline void glClearDepth (GLdouble depth) {
+		current.calls[Call_glClearDepth] += 1;
+		return (::glClearDepth)(depth);
+	}
+	inline void glStencilMask (GLuint mask) {
+		current.calls[Call_glStencilMask] += 1;
+		return (::glStencilMask)(mask);
+	}
+	inline void glColorMask (GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha) {
+		current.calls[Call_glColorMask] += 1;
+		current.state_changes += 1;
+		return (::glColorMask)(red, green, blue, alpha);
+	}
+	inline void glDepthMask (GLboolean flag) {
+		current.calls[Call_glDepthMask] += 1;
+		current.state_changes += 1;
+		return (::glDepthMask)(flag);
+	}
+	inline void glDisable (GLenum cap) {
+		current.calls[Call_glDisable] += 1;
+		current.state_changes += 1;
+		return (::glDisable)(cap);
+	}
+	inline void glEnable (GLenum cap) {
+		current.calls[Call_glEnable] += 1;
+		current.state_changes += 1;
+		return (::glEnable)(cap);
+	}
+	inline void glFinish (void) {
+		current.calls[Call_glFinish] += 1;
+		Timer timer(Call_glFinish);
+		return (::glFinish)();
+	}
+	inline void glFlush (void) {
+		current.calls[Call_glFlush] += 1;
+		Timer timer(Call_glFlush);
+		return (::glFlush)();
+	}
+	inline void glBlendFunc (GLenum sfactor, GLenum dfactor) {
+		current.calls[Call_glBlendFunc] += 1;
+		current.state_changes += 1;
+		return (::glBlendFunc)(sfactor, dfactor);
+	}
+	inline void glLogicOp (GLenum opcode) {
+		current.calls[Call_glLogicOp] += 1;
+		return (::glLogicOp)(opcode);
+	}
+	inline void glStencilFunc (GLenum func, GLint ref, GLuint mask) {
+		current.calls[Call_glStencilFunc] += 1;
+		return (::glStencilFunc)(func, ref, mask);
+	}
+	inline void glStencilOp (GLenum fail, GLenum zfail, GLenum zpass) {
+		current.calls[Call_glStencilOp] += 1;
+		return (::glStencilOp)(fail, zfail, zpass);
+	}
+	inline void glDepthFunc (GLenum func) {
+		current.calls[Call_glDepthFunc] += 1;
+		current.state_changes += 1;
+		return (::glDepthFunc)(func);
+	}
+	inline void glPixelStoref (GLenum pname, GLfloat param) {
+		current.calls[Call_glPixelStoref] += 1;
+		return (::glPixelStoref)(pname, param);
+	}
+	inline void glPixelStorei (GLenum pname, GLint param) {
+		current.calls[Call_glPixelStorei] += 1;
+		return (::glPixelStorei)(pname, param);
+	}
+	inline void glReadBuffer (GLenum src) {
+		current.calls[Call_glReadBuffer] += 1;
+		return (::glReadBuffer)(src);
+	}
+	inline void glReadPixels (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void *pixels) {
+		current.calls[Call_glReadPixels] += 1;
+		Timer timer(Call_glReadPixels);
+		return (::glReadPixels)(x, y, width, height, format, type, pixels);
+	}
+	inline void glGetBooleanv (GLenum pname, GLboolean *data) {
+		current.calls[Call_glGetBooleanv] += 1;
+		return (::glGetBooleanv)(pname, data);
+	}
+	inline void glGetDoublev (GLenum pname, GLdouble *data) {
+		current.calls[Call_glGetDoublev] += 1;
+		return (::glGetDoublev)(pname, data);
+	}
+	inline GLenum glGetError (void) {
+		current.calls[Call_glGetError] += 1;
+		Timer timer(Call_glGetError);
+		return (::glGetError)();
+	}
+	inline void glGetFloatv (GLenum pname, GLfloat *data) {
+		current.calls[Call_glGetFloatv] += 1;
+		return (::glGetFloatv)(pname, data);
+	}
+	inline void glGetIntegerv (GLenum pname, GLint *data) {
+		current.calls[Call_glGetIntegerv] += 1;
+		return (::glGetIntegerv)(pname, data);
+	}
+	inline const GLubyte * glGetString (GLenum name) {
+		current.calls[Call_glGetString] += 1;
+		return (::glGetString)(name);
+	}
+	inline void glGetTexImage (GLenum target, GLint level, GLenum format, GLenum type, void *pixels) {
+		current.calls[Call_glGetTexImage] += 1;
+		return (::glGetTexImage)(target, level, format, type, pixels);
+	}
+	inline void glGetTexParameterfv (GLenum target, GLenum pname, GLfloat *params) {
+		current.calls[Call_glGetTexParameterfv] += 1;
+		return (::glGetTexParameterfv)(target, pname, params);
+	}
+	inline void glGetTexParameteriv (GLenum target, GLenum pname, GLint *params) {
+		current.calls[Call_glGetTexParameteriv] += 1;
+		return (::glGetTexParameteriv)(target, pname, params);
+	}
+	inline void glGetTexLevelParameterfv (GLenum target, GLint level, GLenum pname, GLfloat *params) {
+		current.calls[Call_glGetTexLevelParameterfv] += 1;
+		return (::glGetTexLevelParameterfv)(target, level, pname, params);
+	}
+	inline void glGetTexLevelParameteriv (GLenum target, GLint level, GLenum pname, GLint *params) {
+		current.calls[Call_glGetTexLevelParameteriv] += 1;
+		return (::glGetTexLevelParameteriv)(target, level, pname, params);
+	}
+	inline GLboolean glIsEnabled (GLenum cap) {
+		current.calls[Call_glIsEnabled] += 1;
+		return (::glIsEnabled)(cap);
+	}
+	inline void glDepthRange (GLdouble n, GLdouble f) {
+		current.calls[Call_glDepthRange] += 1;
+		return (::glDepthRange)(n, f);
+	}
+	inline void glViewport (GLint x, GLint y, GLsizei width, GLsizei height) {
+		current.calls[Call_glViewport] += 1;
+		current.state_changes += 1;
+		return (::glViewport)(x, y, width, height);
+	}
+	inline void glDrawArrays (GLenum mode, GLint first, GLsizei count) {
+		current.calls[Call_glDrawArrays] += 1;
+		current.draw_calls += 1;
+		Timer timer(Call_glDrawArrays);
+		return (::glDrawArrays)(mode, first, count);
+	}
+	inline void glDrawElements (GLenum mode, GLsizei count, GLenum type, const void *indices) {
+		current.calls[Call_glDrawElements] += 1;
+		current.draw_calls += 1;
+		Timer timer(Call_glDrawElements);
+		return (::glDrawElements)(mode, count, type, indices);
+	}
+	inline void glGetPointerv (GLenum pname, void **params) {
+		current.calls[Call_glGetPointerv] += 1;
+		return (::glGetPointerv)(pname, params);
+	}
+	inline void glPolygonOffset (GLfloat factor, GLfloat units) {
+		current.calls[Call_glPolygonOffset] += 1;
+		return (::glPolygonOffset)(factor, units);
+	}
+	inline void glCopyTexImage1D (GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLint border) {
+		current.calls[Call_glCopyTexImage1D] += 1;
+		return (::glCopyTexImage1D)(target, level, internalformat, x, y, width, border);
+	}
+	inline void glCopyTexImage2D (GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border) {
+		current.calls[Call_glCopyTexImage2D] += 1;
+		return (::glCopyTexImage2D)(target, level, internalformat, x, y, width, height, border);
+	}
+	inline void glCopyTexSubImage1D (GLenum target, GLint level, GLint xoffset, GLint x, GLint y, GLsizei width) {
+		current.calls[Call_glCopyTexSubImage1D] += 1;
+		return (::glCopyTexSubImage1D)(target, level, xoffset, x, y, width);
+	}
+	inline void glCopyTexSubImage2D (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height) {
+		current.calls[Call_glCopyTexSubImage2D] += 1;
+		return (::glCopyTexSubImage2D)(target, level, xoffset, yoffset, x, y, width, height);
+	}
+	inline void glTexSubImage1D (GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLenum type, const void *pixels) {
+		current.calls[Call_glTexSubImage1D] += 1;
+		if (pixels) current.upload_bytes += uint64_t(width) * texel_bytes(format, type);
+		return (::glTexSubImage1D)(target, level, xoffset, width, format, type, pixels);
+	}
+	inline void glTexSubImage2D (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *pixels) {
+		current.calls[Call_glTexSubImage2D] += 1;
+		if (pixels) current.upload_bytes += uint64_t(width) * uint64_t(height) * texel_bytes(format, type);
+		Timer timer(Call_glTexSubImage2D);
+		return (::glTexSubImage2D)(target, level, xoffset, yoffset, width, height, format, type, pixels);
+	}
+	inline void glBindTexture (GLenum target, GLuint texture) {
+		current.calls[Call_glBindTexture] += 1;
+		current.state_changes += 1;
+		return (::glBindTexture)(target, texture);
+	}
+	inline void glDeleteTextures (GLsizei n, const GLuint *textures) {
+		current.calls[Call_glDeleteTextures] += 1;
+		return (::glDeleteTextures)(n, textures);
+	}
+	inline void glGenTextures (GLsizei n, GLuint *textures) {
+		current.calls[Call_glGenTextures] += 1;
+		return (::glGenTextures)(n, textures);
+	}
+	inline GLboolean glIsTexture (GLuint texture) {
+		current.calls[Call_glIsTexture] += 1;
+		return (::glIsTexture)(texture);
+	}
+	inline void glDrawRangeElements (GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const void *indices) {
+		current.calls[Call_glDrawRangeElements] += 1;
+		current.draw_calls += 1;
+		return (::glDrawRangeElements)(mode, start, end, count, type, indices);
+	}
+	inline void glTexImage3D (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void *pixels) {
+		current.calls[Call_glTexImage3D] += 1;
+		if (pixels) current.upload_bytes += uint64_t(width) * uint64_t(height) * uint64_t(depth) * texel_bytes(format, type);
+		return (::glTexImage3D)(target, level, internalformat, width, height, depth, border, format, type, pixels);
+	}
+	inline void glTexSubImage3D (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void *pixels) {
+		current.calls[Call_glTexSubImage3D] += 1;
+		if (pixels) current.upload_bytes += uint64_t(width) * uint64_t(height) * uint64_t(depth) * texel_bytes(format, type);
+		return (::glTexSubImage3D)(target, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels);
+	}
+	inline void glCopyTexSubImage3D (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLint x, GLint y, GLsizei width, GLsizei height) {
+		current.calls[Call_glCopyTexSubImage3D] += 1;
+		return (::glCopyTexSubImage3D)(target, level, xoffset, yoffset, zoffset, x, y, width, height);
+	}
+	inline void glActiveTexture (GLenum texture) {
+		current.calls[Call_glActiveTexture] += 1;
+		current.state_changes += 1;
+		return (::glActiveTexture)(texture);
+	}
+	inline void glSampleCoverage (GLfloat value, GLboolean invert) {
+		current.calls[Call_glSampleCoverage] += 1;
+		return (::glSampleCoverage)(value, invert);
+	}
+	inline void glCompressedTexImage3D (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLsizei imageSize, const void *data) {
+		current.calls[Call_glCompressedTexImage3D] += 1;
+		return (::glCompressedTexImage3D)(target, level, internalformat, width, height, depth, border, imageSize, data);
+	}
+	inline void glCompressedTexImage2D (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void *data) {
+		current.calls[Call_glCompressedTexImage2D] += 1;
+		return (::glCompressedTexImage2D)(target, level, internalformat, width, height, border, imageSize, data);
+	}
+	inline void glCompressedTexImage1D (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLint border, GLsizei imageSize, const void *data) {
+		current.calls[Call_glCompressedTexImage1D] += 1;
+		return (::glCompressedTexImage1D)(target, level, internalformat, width, border, imageSize, data);
+	}
+	inline void glCompressedTexSubImage3D (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, const void *data) {
+		current.calls[Call_glCompressedTexSubImage3D] += 1;
+		return (::glCompressedTexSubImage3D)(target, level, xoffset, yoffset, zoffset, width, height, depth, format, imageSize, data);
+	}
+	inline void glCompressedTexSubImage2D (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const void *data) {
+		current.calls[Call_glCompressedTexSubImage2D] += 1;
+		return (::glCompressedTexSubImage2D)(target, level, xoffset, yoffset, width, height, format, imageSize, data);
+	}
+	inline void glCompressedTexSubImage1D (GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLsizei imageSize, const void *data) {
+		current.calls[Call_glCompressedTexSubImage1D] += 1;
+		return (::glCompressedTexSubImage1D)(target, level, xoffset, width, format, imageSize, data);
+	}
+	inline void glGetCompressedTexImage (GLenum target, GLint level, void *img) {
+		current.calls[Call_glGetCompressedTexImage] += 1;
+		return (::glGetCompressedTexImage)(target, level, img);
+	}
+	inline void glBlendFuncSeparate (GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha) {
+		current.calls[Call_glBlendFuncSeparate] += 1;
+		current.state_changes += 1;
+		return (::glBlendFuncSeparate)(sfactorRGB, dfactorRGB, sfactorAlpha, dfactorAlpha);
+	}
+	inline void glMultiDrawArrays (GLenum mode, const GLint *first, const GLsizei *count, GLsizei drawcount) {
+		current.calls[Call_glMultiDrawArrays] += 1;
+		current.draw_calls += 1;
+		return (::glMultiDrawArrays)(mode, first, count, drawcount);
+	}
+	inline void glMultiDrawElements (GLenum mode, const GLsizei *count, GLenum type, const void *const*indices, GLsizei drawcount) {
+		current.calls[Call_glMultiDrawElements] += 1;
+		current.draw_calls += 1;
+		return (::glMultiDrawElements)(mode, count, type, indices, drawcount);
+	}
+	inline void glPointParameterf (GLenum pname, GLfloat param) {
+		current.calls[Call_glPointParameterf] += 1;
+		return (::glPointParameterf)(pname, param);
+	}
+	inline void glPointParameterfv (GLenum pname, const GLfloat *params) {
+		current.calls[Call_glPointParameterfv] += 1;
+		return (::glPointParameterfv)(pname, params);
+	}
+	inline void glPointParameteri (GLenum pname, GLint param) {
+		current.calls[Call_glPointParameteri] += 1;
+		return (::glPointParameteri)(pname, param);
+	}
+	inline void glPointParameteriv (GLenum pname, const GLint *params) {
+		current.calls[Call_glPointParameteriv] += 1;
+		return (::glPointParameteriv)(pname, params);
+	}
+	inline void glBlendColor (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+		current.calls[Call_glBlendColor] += 1;
+		return (::glBlendColor)(red, green, blue, alpha);
+	}
+	inline void glBlendEquation (GLenum mode) {
+		current.calls[Call_glBlendEquation] += 1;
+		current.state_changes += 1;
+		return (::glBlendEquation)(mode);
+	}
+	inline void glGenQueries (GLsizei n, GLuint *ids) {
+		current.calls[Call_glGenQueries] += 1;
+		return (::glGenQueries)(n, ids);
+	}
+	inline void glDeleteQueries (GLsizei n, const GLuint *ids) {
+		current.calls[Call_glDeleteQueries] += 1;
+		return (::glDeleteQueries)(n, ids);
+	}
+	inline GLboolean glIsQuery (GLuint id) {
+		current.calls[Call_glIsQuery] += 1;
+		return (::glIsQuery)(id);
+	}
+	inline void glBeginQuery (GLenum target, GLuint id) {
+		current.calls[Call_glBeginQuery] += 1;
+		return (::glBeginQuery)(target, id);
+	}
+	inline void glEndQuery (GLenum target) {
+		current.calls[Call_glEndQuery] += 1;
+		return (::glEndQuery)(target);
+	}
+	inline void glGetQueryiv (GLenum target, GLenum pname, GLint *params) {
+		current.calls[Call_glGetQueryiv] += 1;
+		return (::glGetQueryiv)(target, pname, params);
+	}
+	inline void glGetQueryObjectiv (GLuint id, GLenum pname, GLint *params) {
+		current.calls[Call_glGetQueryObjectiv] += 1;
+		return (::glGetQueryObjectiv)(id, pname, params);
+	}
+	inline void glGetQueryObjectuiv (GLuint id, GLenum pname, GLuint *params) {
+		current.calls[Call_glGetQueryObjectuiv] += 1;
+		return (::glGetQueryObjectuiv)(id, pname, params);
+	}
+	inline void glBindBuffer (GLenum target, GLuint buffer) {
+		current.calls[Call_glBindBuffer] += 1;
+		current.state_changes += 1;
+		return (::glBindBuffer)(target, buffer);
+	}
+	inline void glDeleteBuffers (GLsizei n, const GLuint *buffers) {
+		current.calls[Call_glDeleteBuffers] += 1;
+		return (::glDeleteBuffers)(n, buffers);
+	}
+	inline void glGenBuffers (GLsizei n, GLuint *buffers) {
+		current.calls[Call_glGenBuffers] += 1;
+		return (::glGenBuffers)(n, buffers);
+	}
+	inline GLboolean glIsBuffer (GLuint buffer) {
+		current.calls[Call_glIsBuffer] += 1;
+		return (::glIsBuffer)(buffer);
+	}
+	inline void glBufferData (GLenum target, GLsizeiptr size, const void *data, GLenum usage) {
+		current.calls[Call_glBufferData] += 1;
+		current.upload_bytes += uint64_t(size);
+		Timer timer(Call_glBufferData);
+		return (::glBufferData)(target, size, data, usage);
+	}
+	inline void glBufferSubData (GLenum target, GLintptr offset, GLsizeiptr size, const void *data) {
+		current.calls[Call_glBufferSubData] += 1;
+		current.upload_bytes += uint64_t(size);
+		Timer timer(Call_glBufferSubData);
+		return (::glBufferSubData)(target, offset, size, data);
+	}
+	inline void glGetBufferSubData (GLenum target, GLintptr offset, GLsizeiptr size, void *data) {
+		current.calls[Call_glGetBufferSubData] += 1;
+		return (::glGetBufferSubData)(target, offset, size, data);
+	}
+	inline void * glMapBuffer (GLenum target, GLenum access) {
+		current.calls[Call_glMapBuffer] += 1;
+		return (::glMapBuffer)(target, access);
+	}
+	inline GLboolean glUnmapBuffer (GLenum target) {
+		current.calls[Call_glUnmapBuffer] += 1;
+		return (::glUnmapBuffer)(target);
+	}
+	inline void glGetBufferParameteriv (GLenum target, GLenum pname, GLint *params) {
+		current.calls[Call_glGetBufferParameteriv] += 1;
+		return (::glGetBufferParameteriv)(target, pname, params);
+	}
+	inline void glGetBufferPointerv (GLenum target, GLenum pname, void **params) {
+		current.calls[Call_glGetBufferPointerv] += 1;
+		return (::glGetBufferPointerv)(target, pname, params);
+	}
+	inline void glBlendEquationSeparate (GLenum modeRGB, GLenum modeAlpha) {
+		current.calls[Call_glBlendEquationSeparate] += 1;
+		current.state_changes += 1;
+		return (::glBlendEquationSeparate)(modeRGB, modeAlpha);
+	}
+	inline void glDrawBuffers (GLsizei n, const GLenum *bufs) {
+		current.calls[Call_glDrawBuffers] += 1;
+		current.draw_calls += 1;
+		return (::glDrawBuffers)(n, bufs);
+	}
+	inline void glStencilOpSeparate (GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass) {
+		current.calls[Call_glStencilOpSeparate] += 1;
+		return (::glStencilOpSeparate)(face, sfail, dpfail, dppass);
+	}
+	inline void glStencilFuncSeparate (GLenum face, GLenum func, GLint ref, GLuint mask) {
+		current.calls[Call_glStencilFuncSeparate] += 1;
+		return (::glStencilFuncSeparate)(face, func, ref, mask);
+	}
+	inline void glStencilMaskSeparate (GLenum face, GLuint mask) {
+		current.calls[Call_glStencilMaskSeparate] += 1;
+		return (::glStencilMaskSeparate)(face, mask);
+	}
+	inline void glAttachShader (GLuint program, GLuint shader) {
+		current.calls[Call_glAttachShader] += 1;
+		return (::glAttachShader)(program, shader);
+	}
+	inline void glBindAttribLocation (GLuint program, GLuint index, const GLchar *name) {
+		current.calls[Call_glBindAttribLocation] += 1;
+		return (::glBindAttribLocation)(program, index, name);
+	}
+	inline void glCompileShader (GLuint shader) {
+		current.calls[Call_glCompileShader] += 1;
+		return (::glCompileShader)(shader);
+	}
+	inline GLuint glCreateProgram (void) {
+		current.calls[Call_glCreateProgram] += 1;
+		return (::glCreateProgram)();
+	}
+	inline GLuint glCreateShader (GLenum type) {
+		current.calls[Call_glCreateShader] += 1;
+		return (::glCreateShader)(type);
+	}
+	inline void glDeleteProgram (GLuint program) {
+		current.calls[Call_glDeleteProgram] += 1;
+		return (::glDeleteProgram)(program);
+	}
+	inline void glDeleteShader (GLuint shader) {
+		current.calls[Call_glDeleteShader] += 1;
+		return (::glDeleteShader)(shader);
+	}
+	inline void glDetachShader (GLuint program, GLuint shader) {
+		current.calls[Call_glDetachShader] += 1;
+		return (::glDetachShader)(program, shader);
+	}
+	inline void glDisableVertexAttribArray (GLuint index) {
+		current.calls[Call_glDisableVertexAttribArray] += 1;
+		return (::glDisableVertexAttribArray)(index);
+	}
+	inline void glEnableVertexAttribArray (GLuint index) {
+		current.calls[Call_glEnableVertexAttribArray] += 1;
+		return (::glEnableVertexAttribArray)(index);
+	}
+	inline void glGetActiveAttrib (GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name) {
+		current.calls[Call_glGetActiveAttrib] += 1;
+		return (::glGetActiveAttrib)(program, index, bufSize, length, size, type, name);
+	}
+	inline void glGetActiveUniform (GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name) {
+		current.calls[Call_glGetActiveUniform] += 1;
+		return (::glGetActiveUniform)(program, index, bufSize, length, size, type, name);
+	}
+	inline void glGetAttachedShaders (GLuint program, GLsizei maxCount, GLsizei *count, GLuint *shaders) {
+		current.calls[Call_glGetAttachedShaders] += 1;
+		return (::glGetAttachedShaders)(program, maxCount, count, shaders);
+	}
+	inline GLint glGetAttribLocation (GLuint program, const GLchar *name) {
+		current.calls[Call_glGetAttribLocation] += 1;
+		return (::glGetAttribLocation)(program, name);
+	}
+	inline void glGetProgramiv (GLuint program, GLenum pname, GLint *params) {
+		current.calls[Call_glGetProgramiv] += 1;
+		return (::glGetProgramiv)(program, pname, params);
+	}
+	inline void glGetProgramInfoLog (GLuint program, GLsizei bufSize, GLsizei *length, GLchar *infoLog) {
+		current.calls[Call_glGetProgramInfoLog] += 1;
+		return (::glGetProgramInfoLog)(program, bufSize, length, infoLog);
+	}
+	inline void glGetShaderiv (GLuint shader, GLenum pname, GLint *params) {
+		current.calls[Call_glGetShaderiv] += 1;
+		return (::glGetShaderiv)(shader, pname, params);
+	}
+	inline void glGetShaderInfoLog (GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *infoLog) {
+		current.calls[Call_glGetShaderInfoLog] += 1;
+		return (::glGetShaderInfoLog)(shader, bufSize, length, infoLog);
+	}
+	inline void glGetShaderSource (GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *source) {
+		current.calls[Call_glGetShaderSource] += 1;
+		return (::glGetShaderSource)(shader, bufSize, length, source);
+	}
+	inline GLint glGetUniformLocation (GLuint program, const GLchar *name) {
+		current.calls[Call_glGetUniformLocation] += 1;
+		return (::glGetUniformLocation)(program, name);
+	}
+	inline void glGetUniformfv (GLuint program, GLint location, GLfloat *params) {
+		current.calls[Call_glGetUniformfv] += 1;
+		return (::glGetUniformfv)(program, location, params);
+	}
+	inline void glGetUniformiv (GLuint program, GLint location, GLint *params) {
+		current.calls[Call_glGetUniformiv] += 1;
+		return (::glGetUniformiv)(program, location, params);
+	}
+	inline void glGetVertexAttribdv (GLuint index, GLenum pname, GLdouble *params) {
+		current.calls[Call_glGetVertexAttribdv] += 1;
+		return (::glGetVertexAttribdv)(index, pname, params);
+	}
+	inline void glGetVertexAttribfv (GLuint index, GLenum pname, GLfloat *params) {
+		current.calls[Call_glGetVertexAttribfv] += 1;
+		return (::glGetVertexAttribfv)(index, pname, params);
+	}
+	inline void glGetVertexAttribiv (GLuint index, GLenum pname, GLint *params) {
+		current.calls[Call_glGetVertexAttribiv] += 1;
+		return (::glGetVertexAttribiv)(index, pname, params);
+	}
+	inline void glGetVertexAttribPointerv (GLuint index, GLenum pname, void **pointer) {
+		current.calls[Call_glGetVertexAttribPointerv] += 1;
+		return (::glGetVertexAttribPointerv)(index, pname, pointer);
+	}
+	inline GLboolean glIsProgram (GLuint program) {
+		current.calls[Call_glIsProgram] += 1;
+		return (::glIsProgram)(program);
+	}
+	inline GLboolean glIsShader (GLuint shader) {
+		current.calls[Call_glIsShader] += 1;
+		return (::glIsShader)(shader);
+	}
+	inline void glLinkProgram (GLuint program) {
+		current.calls[Call_glLinkProgram] += 1;
+		return (::glLinkProgram)(program);
+	}
+	inline void glShaderSource (GLuint shader, GLsizei count, const GLchar *const*string, const GLint *length) {
+		current.calls[Call_glShaderSource] += 1;
+		return (::glShaderSource)(shader, count, string, length);
+	}
+	inline void glUseProgram (GLuint program) {
+		current.calls[Call_glUseProgram] += 1;
+		current.state_changes += 1;
+		return (::glUseProgram)(program);
+	}
+	inline void glUniform1f (GLint location, GLfloat v0) {
+		current.calls[Call_glUniform1f] += 1;
+		return (::glUniform1f)(location, v0);
+	}
+	inline void glUniform2f (GLint location, GLfloat v0, GLfloat v1) {
+		current.calls[Call_glUniform2f] += 1;
+		return (::glUniform2f)(location, v0, v1);
+	}
+	inline void glUniform3f (GLint location, GLfloat v0, GLfloat v1, GLfloat v2) {
+		current.calls[Call_glUniform3f] += 1;
+		return (::glUniform3f)(location, v0, v1, v2);
+	}
+	inline void glUniform4f (GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) {
+		current.calls[Call_glUniform4f] += 1;
+		return (::glUniform4f)(location, v0, v1, v2, v3);
+	}
+	inline void glUniform1i (GLint location, GLint v0) {
+		current.calls[Call_glUniform1i] += 1;
+		return (::glUniform1i)(location, v0);
+	}
+	inline void glUniform2i (GLint location, GLint v0, GLint v1) {
+		current.calls[Call_glUniform2i] += 1;
+		return (::glUniform2i)(location, v0, v1);
+	}
+	inline void glUniform3i (GLint location, GLint v0, GLint v1, GLint v2) {
+		current.calls[Call_glUniform3i] += 1;
+		return (::glUniform3i)(location, v0, v1, v2);
+	}
+	inline void glUniform4i (GLint location, GLint v0, GLint v1, GLint v2, GLint v3) {
+		current.calls[Call_glUniform4i] += 1;
+		return (::glUniform4i)(location, v0, v1, v2, v3);
+	}
+	inline void glUniform1fv (GLint location, GLsizei count, const GLfloat *value) {
+		current.calls[Call_glUniform1fv] += 1;
+		return (::glUniform1fv)(location, count, value);
+	}
+	inline void glUniform2fv (GLint location, GLsizei count, const GLfloat *value) {
+		current.calls[Call_glUniform2fv] += 1;
+		return (::glUniform2fv)(location, count, value);
+	}
+	inline void glUniform3fv (GLint location, GLsizei count, const GLfloat *value) {
+		current.calls[Call_glUniform3fv] += 1;
+		return (::glUniform3fv)(location, count, value);
+	}
+	inline void glUniform4fv (GLint location, GLsizei count, const GLfloat *value) {
+		current.calls[Call_glUniform4fv] += 1;
+		return (::glUniform4fv)(location, count, value);
+	}
+	inline void glUniform1iv (GLint location, GLsizei count, const GLint *value) {
+		current.calls[Call_glUniform1iv] += 1;
+		return (::glUniform1iv)(location, count, value);
+	}
+	inline void glUniform2iv (GLint location, GLsizei count, const GLint *value) {
+		current.calls[Call_glUniform2iv] += 1;
+		return (::glUniform2iv)(location, count, value);
+	}
+	inline void glUniform3iv (GLint location, GLsizei count, const GLint *value) {
+		current.calls[Call_glUniform3iv] += 1;
+		return (::glUniform3iv)(location, count, value);
+	}
+	inline void glUniform4iv (GLint location, GLsizei count, const GLint *value) {
+		current.calls[Call_glUniform4iv] += 1;
+		return (::glUniform4iv)(location, count, value);
+	}
+	inline void glUniformMatrix2fv (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+		current.calls[Call_glUniformMatrix2fv] += 1;
+		return (::glUniformMatrix2fv)(location, count, transpose, value);
+	}
+	inline void glUniformMatrix3fv (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+		current.calls[Call_glUniformMatrix3fv] += 1;
+		return (::glUniformMatrix3fv)(location, count, transpose, value);
+	}
+	inline void glUniformMatrix4fv (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+		current.calls[Call_glUniformMatrix4fv] += 1;
+		return (::glUniformMatrix4fv)(location, count, transpose, value);
+	}
+	inline void glValidateProgram (GLuint program) {
+		current.calls[Call_glValidateProgram] += 1;
+		return (::glValidateProgram)(program);
+	}
+	inline void glVertexAttrib1d (GLuint index, GLdouble x) {
+		current.calls[Call_glVertexAttrib1d] += 1;
+		return (::glVertexAttrib1d)(index, x);
+	}
+	inline void glVertexAttrib1dv (GLuint index, const GLdouble *v) {
+		current.calls[Call_glVertexAttrib1dv] += 1;
+		return (::glVertexAttrib1dv)(index, v);
+	}
+	inline void glVertexAttrib1f (GLuint index, GLfloat x) {
+		current.calls[Call_glVertexAttrib1f] += 1;
+		return (::glVertexAttrib1f)(index, x);
+	}
+	inline void glVertexAttrib1fv (GLuint index, const GLfloat *v) {
+		current.calls[Call_glVertexAttrib1fv] += 1;
+		return (::glVertexAttrib1fv)(index, v);
+	}
+	inline void glVertexAttrib1s (GLuint index, GLshort x) {
+		current.calls[Call_glVertexAttrib1s] += 1;
+		return (::glVertexAttrib1s)(index, x);
+	}
+	inline void glVertexAttrib1sv (GLuint index, const GLshort *v) {
+		current.calls[Call_glVertexAttrib1sv] += 1;
+		return (::glVertexAttrib1sv)(index, v);
+	}
+	inline void glVertexAttrib2d (GLuint index, GLdouble x, GLdouble y) {
+		current.calls[Call_glVertexAttrib2d] += 1;
+		return (::glVertexAttrib2d)(index, x, y);
+	}
+	inline void glVertexAttrib2dv (GLuint index, const GLdouble *v) {
+		current.calls[Call_glVertexAttrib2dv] += 1;
+		return (::glVertexAttrib2dv)(index, v);
+	}
+	inline void glVertexAttrib2f (GLuint index, GLfloat x, GLfloat y) {
+		current.calls[Call_glVertexAttrib2f] += 1;
+		return (::glVertexAttrib2f)(index, x, y);
+	}
+	inline void glVertexAttrib2fv (GLuint index, const GLfloat *v) {
+		current.calls[Call_glVertexAttrib2fv] += 1;
+		return (::glVertexAttrib2fv)(index, v);
+	}
+	inline void glVertexAttrib2s (GLuint index, GLshort x, GLshort y) {
+		current.calls[Call_glVertexAttrib2s] += 1;
+		return (::glVertexAttrib2s)(index, x, y);
+	}
+	inline void glVertexAttrib2sv (GLuint index, const GLshort *v) {
+		current.calls[Call_glVertexAttrib2sv] += 1;
+		return (::glVertexAttrib2sv)(index, v);
+	}
+	inline void glVertexAttrib3d (GLuint index, GLdouble x, GLdouble y, GLdouble z) {
+		current.calls[Call_glVertexAttrib3d] += 1;
+		return (::glVertexAttrib3d)(index, x, y, z);
+	}
+	inline void glVertexAttrib3dv (GLuint index, const GLdouble *v) {
+		current.calls[Call_glVertexAttrib3dv] += 1;
+		return (::glVertexAttrib3dv)(index, v);
+	}
+	inline void glVertexAttrib3f (GLuint index, GLfloat x, GLfloat y, GLfloat z) {
+		current.calls[Call_glVertexAttrib3f] += 1;
+		return (::glVertexAttrib3f)(index, x, y, z);
+	}
+	inline void glVertexAttrib3fv (GLuint index, const GLfloat *v) {
+		current.calls[Call_glVertexAttrib3fv] += 1;
+		return (::glVertexAttrib3fv)(index, v);
+	}
+	inline void glVertexAttrib3s (GLuint index, GLshort x, GLshort y, GLshort z) {
+		current.calls[Call_glVertexAttrib3s] += 1;
+		return (::glVertexAttrib3s)(index, x, y, z);
+	}
+	inline void glVertexAttrib3sv (GLuint index, const GLshort *v) {
+		current.calls[Call_glVertexAttrib3sv] += 1;
+		return (::glVertexAttrib3sv)(index, v);
+	}
+	inline void glVertexAttrib4Nbv (GLuint index, const GLbyte *v) {
+		current.calls[Call_glVertexAttrib4Nbv] += 1;
+		return (::glVertexAttrib4Nbv)(index, v);
+	}
+	inline void glVertexAttrib4Niv (GLuint index, const GLint *v) {
+		current.calls[Call_glVertexAttrib4Niv] += 1;
+		return (::glVertexAttrib4Niv)(index, v);
+	}
+	inline void glVertexAttrib4Nsv (GLuint index, const GLshort *v) {
+		current.calls[Call_glVertexAttrib4Nsv] += 1;
+		return (::glVertexAttrib4Nsv)(index, v);
+	}
+	inline void glVertexAttrib4Nub (GLuint index, GLubyte x, GLubyte y, GLubyte z, GLubyte w) {
+		current.calls[Call_glVertexAttrib4Nub] += 1;
+		return (::glVertexAttrib4Nub)(index, x, y, z, w);
+	}
+	inline void glVertexAttrib4Nubv (GLuint index, const GLubyte *v) {
+		current.calls[Call_glVertexAttrib4Nubv] += 1;
+		return (::glVertexAttrib4Nubv)(index, v);
+	}
+	inline void glVertexAttrib4Nuiv (GLuint index, const GLuint *v) {
+		current.calls[Call_glVertexAttrib4Nuiv] += 1;
+		return (::glVertexAttrib4Nuiv)(index, v);
+	}
+	inline void glVertexAttrib4Nusv (GLuint index, const GLushort *v) {
+		current.calls[Call_glVertexAttrib4Nusv] += 1;
+		return (::glVertexAttrib4Nusv)(index, v);
+	}
+	inline void glVertexAttrib4bv (GLuint index, const GLbyte *v) {
+		current.calls[Call_glVertexAttrib4bv] += 1;
+		return (::glVertexAttrib4bv)(index, v);
+	}
+	inline void glVertexAttrib4d (GLuint index, GLdouble x, GLdouble y, GLdouble z, GLdouble w) {
+		current.calls[Call_glVertexAttrib4d] += 1;
+		return (::glVertexAttrib4d)(index, x, y, z, w);
+	}
+	inline void glVertexAttrib4dv (GLuint index, const GLdouble *v) {
+		current.calls[Call_glVertexAttrib4dv] += 1;
+		return (::glVertexAttrib4dv)(index, v);
+	}
+	inline void glVertexAttrib4f (GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w) {
+		current.calls[Call_glVertexAttrib4f] += 1;
+		return (::glVertexAttrib4f)(index, x, y, z, w);
+	}
+	inline void glVertexAttrib4fv (GLuint index, const GLfloat *v) {
+		current.calls[Call_glVertexAttrib4fv] += 1;
+		return (::glVertexAttrib4fv)(index, v);
+	}
+	inline void glVertexAttrib4iv (GLuint index, const GLint *v) {
+		current.calls[Call_glVertexAttrib4iv] += 1;
+		return (::glVertexAttrib4iv)(index, v);
+	}
+	inline void glVertexAttrib4s (GLuint index, GLshort x, GLshort y, GLshort z, GLshort w) {
+		current.calls[Call_glVertexAttrib4s] += 1;
+		return (::glVertexAttrib4s)(index, x, y, z, w);
+	}
+	inline void glVertexAttrib4sv (GLuint index, const GLshort *v) {
+		current.calls[Call_glVertexAttrib4sv] += 1;
+		return (::glVertexAttrib4sv)(index, v);
+	}
+	inline void glVertexAttrib4ubv (GLuint index, const GLubyte *v) {
+		current.calls[Call_glVertexAttrib4ubv] += 1;
+		return (::glVertexAttrib4ubv)(index, v);
+	}
+	inline void glVertexAttrib4uiv (GLuint index, const GLuint *v) {
+		current.calls[Call_glVertexAttrib4uiv] += 1;
+		return (::glVertexAttrib4uiv)(index, v);
+	}
+	inline void glVertexAttrib4usv (GLuint index, const GLushort *v) {
+		current.calls[Call_glVertexAttrib4usv] += 1;
+		return (::glVertexAttrib4usv)(index, v);
+	}
+	inline void glVertexAttribPointer (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer) {
+		current.calls[Call_glVertexAttribPointer] += 1;
+		return (::glVertexAttribPointer)(index, size, type, normalized, stride, pointer);
+	}
+	inline void glUniformMatrix2x3fv (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+		current.calls[Call_glUniformMatrix2x3fv] += 1;
+		return (::glUniformMatrix2x3fv)(location, count, transpose, value);
+	}
+	inline void glUniformMatrix3x2fv (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+		current.calls[Call_glUniformMatrix3x2fv] += 1;
+		return (::glUniformMatrix3x2fv)(location, count, transpose, value);
+	}
+	inline void glUniformMatrix2x4fv (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+		current.calls[Call_glUniformMatrix2x4fv] += 1;
+		return (::glUniformMatrix2x4fv)(location, count, transpose, value);
+	}
+	inline void glUniformMatrix4x2fv (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+		current.calls[Call_glUniformMatrix4x2fv] += 1;
+		return (::glUniformMatrix4x2fv)(location, count, transpose, value);
+	}
+	inline void glUniformMatrix3x4fv (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+		current.calls[Call_glUniformMatrix3x4fv] += 1;
+		return (::glUniformMatrix3x4fv)(location, count, transpose, value);
+	}
+	inline void glUniformMatrix4x3fv (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+		current.calls[Call_glUniformMatrix4x3fv] += 1;
+		return (::glUniformMatrix4x3fv)(location, count, transpose, value);
+	}
+	inline void glColorMaski (GLuint index, GLboolean r, GLboolean g, GLboolean b, GLboolean a) {
+		current.calls[Call_glColorMaski] += 1;
+		return (::glColorMaski)(index, r, g, b, a);
+	}
+	inline void glGetBooleani_v (GLenum target, GLuint index, GLboolean *data) {
+		current.calls[Call_glGetBooleani_v] += 1;
+		return (::glGetBooleani_v)(target, index, data);
+	}
+	inline void glGetIntegeri_v (GLenum target, GLuint index, GLint *data) {
+		current.calls[Call_glGetIntegeri_v] += 1;
+		return (::glGetIntegeri_v)(target, index, data);
+	}
+	inline void glEnablei (GLenum target, GLuint index) {
+		current.calls[Call_glEnablei] += 1;
+		return (::glEnablei)(target, index);
+	}
+	inline void glDisablei (GLenum target, GLuint index) {
+		current.calls[Call_glDisablei] += 1;
+		return (::glDisablei)(target, index);
+	}
+	inline GLboolean glIsEnabledi (GLenum target, GLuint index) {
+		current.calls[Call_glIsEnabledi] += 1;
+		return (::glIsEnabledi)(target, index);
+	}
+	inline void glBeginTransformFeedback (GLenum primitiveMode) {
+		current.calls[Call_glBeginTransformFeedback] += 1;
+		return (::glBeginTransformFeedback)(primitiveMode);
+	}
+	inline void glEndTransformFeedback (void) {
+		current.calls[Call_glEndTransformFeedback] += 1;
+		return (::glEndTransformFeedback)();
+	}
+	inline void glBindBufferRange (GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) {
+		current.calls[Call_glBindBufferRange] += 1;
+		return (::glBindBufferRange)(target, index, buffer, offset, size);
+	}
+	inline void glBindBufferBase (GLenum target, GLuint index, GLuint buffer) {
+		current.calls[Call_glBindBufferBase] += 1;
+		return (::glBindBufferBase)(target, index, buffer);
+	}
+	inline void glTransformFeedbackVaryings (GLuint program, GLsizei count, const GLchar *const*varyings, GLenum bufferMode) {
+		current.calls[Call_glTransformFeedbackVaryings] += 1;
+		return (::glTransformFeedbackVaryings)(program, count, varyings, bufferMode);
+	}
+	inline void glGetTransformFeedbackVarying (GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLsizei *size, GLenum *type, GLchar *name) {
+		current.calls[Call_glGetTransformFeedbackVarying] += 1;
+		return (::glGetTransformFeedbackVarying)(program, index, bufSize, length, size, type, name);
+	}
+	inline void glClampColor (GLenum target, GLenum clamp) {
+		current.calls[Call_glClampColor] += 1;
+		return (::glClampColor)(target, clamp);
+	}
+	inline void glBeginConditionalRender (GLuint id, GLenum mode) {
+		current.calls[Call_glBeginConditionalRender] += 1;
+		return (::glBeginConditionalRender)(id, mode);
+	}
+	inline void glEndConditionalRender (void) {
+		current.calls[Call_glEndConditionalRender] += 1;
+		return (::glEndConditionalRender)();
+	}
+	inline void glVertexAttribIPointer (GLuint index, GLint size, GLenum type, GLsizei stride, const void *pointer) {
+		current.calls[Call_glVertexAttribIPointer] += 1;
+		return (::glVertexAttribIPointer)(index, size, type, stride, pointer);
+	}
+	inline void glGetVertexAttribIiv (GLuint index, GLenum pname, GLint *params) {
+		current.calls[Call_glGetVertexAttribIiv] += 1;
+		return (::glGetVertexAttribIiv)(index, pname, params);
+	}
+	inline void glGetVertexAttribIuiv (GLuint index, GLenum pname, GLuint *params) {
+		current.calls[Call_glGetVertexAttribIuiv] += 1;
+		return (::glGetVertexAttribIuiv)(index, pname, params);
+	}
+	inline void glVertexAttribI1i (GLuint index, GLint x) {
+		current.calls[Call_glVertexAttribI1i] += 1;
+		return (::glVertexAttribI1i)(index, x);
+	}
+	inline void glVertexAttribI2i (GLuint index, GLint x, GLint y) {
+		current.calls[Call_glVertexAttribI2i] += 1;
+		return (::glVertexAttribI2i)(index, x, y);
+	}
+	inline void glVertexAttribI3i (GLuint index, GLint x, GLint y, GLint z) {
+		current.calls[Call_glVertexAttribI3i] += 1;
+		return (::glVertexAttribI3i)(index, x, y, z);
+	}
+	inline void glVertexAttribI4i (GLuint index, GLint x, GLint y, GLint z, GLint w) {
+		current.calls[Call_glVertexAttribI4i] += 1;
+		return (::glVertexAttribI4i)(index, x, y, z, w);
+	}
+	inline void glVertexAttribI1ui (GLuint index, GLuint x) {
+		current.calls[Call_glVertexAttribI1ui] += 1;
+		return (::glVertexAttribI1ui)(index, x);
+	}
+	inline void glVertexAttribI2ui (GLuint index, GLuint x, GLuint y) {
+		current.calls[Call_glVertexAttribI2ui] += 1;
+		return (::glVertexAttribI2ui)(index, x, y);
+	}
+	inline void glVertexAttribI3ui (GLuint index, GLuint x, GLuint y, GLuint z) {
+		current.calls[Call_glVertexAttribI3ui] += 1;
+		return (::glVertexAttribI3ui)(index, x, y, z);
+	}
+	inline void glVertexAttribI4ui (GLuint index, GLuint x, GLuint y, GLuint z, GLuint w) {
+		current.calls[Call_glVertexAttribI4ui] += 1;
+		return (::glVertexAttribI4ui)(index, x, y, z, w);
+	}
+	inline void glVertexAttribI1iv (GLuint index, const GLint *v) {
+		current.calls[Call_glVertexAttribI1iv] += 1;
+		return (::glVertexAttribI1iv)(index, v);
+	}
+	inline void glVertexAttribI2iv (GLuint index, const GLint *v) {
+		current.calls[Call_glVertexAttribI2iv] += 1;
+		return (::glVertexAttribI2iv)(index, v);
+	}
+	inline void glVertexAttribI3iv (GLuint index, const GLint *v) {
+		current.calls[Call_glVertexAttribI3iv] += 1;
+		return (::glVertexAttribI3iv)(index, v);
+	}
+	inline void glVertexAttribI4iv (GLuint index, const GLint *v) {
+		current.calls[Call_glVertexAttribI4iv] += 1;
+		return (::glVertexAttribI4iv)(index, v);
+	}
+	inline void glVertexAttribI1uiv (GLuint index, const GLuint *v) {
+		current.calls[Call_glVertexAttribI1uiv] += 1;
+		return (::glVertexAttribI1uiv)(index, v);
+	}
+	inline void glVertexAttribI2uiv (GLuint index, const GLuint *v) {
+		current.calls[Call_glVertexAttribI2uiv] += 1;
+		return (::glVertexAttribI2uiv)(index, v);
+	}
+	inline void glVertexAttribI3uiv (GLuint index, const GLuint *v) {
+		current.calls[Call_glVertexAttribI3uiv] += 1;
+		return (::glVertexAttribI3uiv)(index, v);
+	}
+	inline void glVertexAttribI4uiv (GLuint index, const GLuint *v) {
+		current.calls[Call_glVertexAttribI4uiv] += 1;
+		return (::glVertexAttribI4uiv)(index, v);
+	}
+	inline void glVertexAttribI4bv (GLuint index, const GLbyte *v) {
+		current.calls[Call_glVertexAttribI4bv] += 1;
+		return (::glVertexAttribI4bv)(index, v);
+	}
+	inline void glVertexAttribI4sv (GLuint index, const GLshort *v) {
+		current.calls[Call_glVertexAttribI4sv] += 1;
+		return (::glVertexAttribI4sv)(index, v);
+	}
+	inline void glVertexAttribI4ubv (GLuint index, const GLubyte *v) {
+		current.calls[Call_glVertexAttribI4ubv] += 1;
+		return (::glVertexAttribI4ubv)(index, v);
+	}
+	inline void glVertexAttribI4usv (GLuint index, const GLushort *v) {
+		current.calls[Call_glVertexAttribI4usv] += 1;
+		return (::glVertexAttribI4usv)(index, v);
+	}
+	inline void glGetUniformuiv (GLuint program, GLint location, GLuint *params) {
+		current.calls[Call_glGetUniformuiv] += 1;
+		return (::glGetUniformuiv)(program, location, params);
+	}
+	inline void glBindFragDataLocation (GLuint program, GLuint color, const GLchar *name) {
+		current.calls[Call_glBindFragDataLocation] += 1;
+		return (::glBindFragDataLocation)(program, color, name);
+	}
+	inline GLint glGetFragDataLocation (GLuint program, const GLchar *name) {
+		current.calls[Call_glGetFragDataLocation] += 1;
+		return (::glGetFragDataLocation)(program, name);
+	}
+	inline void glUniform1ui (GLint location, GLuint v0) {
+		current.calls[Call_glUniform1ui] += 1;
+		return (::glUniform1ui)(location, v0);
+	}
+	inline void glUniform2ui (GLint location, GLuint v0, GLuint v1) {
+		current.calls[Call_glUniform2ui] += 1;
+		return (::glUniform2ui)(location, v0, v1);
+	}
+	inline void glUniform3ui (GLint location, GLuint v0, GLuint v1, GLuint v2) {
+		current.calls[Call_glUniform3ui] += 1;
+		return (::glUniform3ui)(location, v0, v1, v2);
+	}
+	inline void glUniform4ui (GLint location, GLuint v0, GLuint v1, GLuint v2, GLuint v3) {
+		current.calls[Call_glUniform4ui] += 1;
+		return (::glUniform4ui)(location, v0, v1, v2, v3);
+	}
+	inline void glUniform1uiv (GLint location, GLsizei count, const GLuint *value) {
+		current.calls[Call_glUniform1uiv] += 1;
+		return (::glUniform1uiv)(location, count, value);
+	}
+	inline void glUniform2uiv (GLint location, GLsizei count, const GLuint *value) {
+		current.calls[Call_glUniform2uiv] += 1;
+		return (::glUniform2uiv)(location, count, value);
+	}
+	inline void glUniform3uiv (GLint location, GLsizei count, const GLuint *value) {
+		current.calls[Call_glUniform3uiv] += 1;
+		return (::glUniform3uiv)(location, count, value);
+	}
+	inline void glUniform4uiv (GLint location, GLsizei count, const GLuint *value) {
+		current.calls[Call_glUniform4uiv] += 1;
+		return (::glUniform4uiv)(location, count, value);
+	}
+	inline void glTexParameterIiv (GLenum target, GLenum pname, const GLint *params) {
+		current.calls[Call_glTexParameterIiv] += 1;
+		return (::glTexParameterIiv)(target, pname, params);
+	}
+	inline void glTexParameterIuiv (GLenum target, GLenum pname, const GLuint *params) {
+		current.calls[Call_glTexParameterIuiv] += 1;
+		return (::glTexParameterIuiv)(target, pname, params);
+	}
+	inline void glGetTexParameterIiv (GLenum target, GLenum pname, GLint *params) {
+		current.calls[Call_glGetTexParameterIiv] += 1;
+		return (::glGetTexParameterIiv)(target, pname, params);
+	}
+	inline void glGetTexParameterIuiv (GLenum target, GLenum pname, GLuint *params) {
+		current.calls[Call_glGetTexParameterIuiv] += 1;
+		return (::glGetTexParameterIuiv)(target, pname, params);
+	}
+	inline void glClearBufferiv (GLenum buffer, GLint drawbuffer, const GLint *value) {
+		current.calls[Call_glClearBufferiv] += 1;
+		return (::glClearBufferiv)(buffer, drawbuffer, value);
+	}
+	inline void glClearBufferuiv (GLenum buffer, GLint drawbuffer, const GLuint *value) {
+		current.calls[Call_glClearBufferuiv] += 1;
+		return (::glClearBufferuiv)(buffer, drawbuffer, value);
+	}
+	inline void glClearBufferfv (GLenum buffer, GLint drawbuffer, const GLfloat *value) {
+		current.calls[Call_glClearBufferfv] += 1;
+		return (::glClearBufferfv)(buffer, drawbuffer, value);
+	}
+	inline void glClearBufferfi (GLenum buffer, GLint drawbuffer, GLfloat depth, GLint stencil) {
+		current.calls[Call_glClearBufferfi] += 1;
+		return (::glClearBufferfi)(buffer, drawbuffer, depth, stencil);
+	}
+	inline const GLubyte * glGetStringi (GLenum name, GLuint index) {
+		current.calls[Call_glGetStringi] += 1;
+		return (::glGetStringi)(name, index);
+	}
+	inline GLboolean glIsRenderbuffer (GLuint renderbuffer) {
+		current.calls[Call_glIsRenderbuffer] += 1;
+		return (::glIsRenderbuffer)(renderbuffer);
+	}
+	inline void glBindRenderbuffer (GLenum target, GLuint renderbuffer) {
+		current.calls[Call_glBindRenderbuffer] += 1;
+		current.state_changes += 1;
+		return (::glBindRenderbuffer)(target, renderbuffer);
+	}
+	inline void glDeleteRenderbuffers (GLsizei n, const GLuint *renderbuffers) {
+		current.calls[Call_glDeleteRenderbuffers] += 1;
+		return (::glDeleteRenderbuffers)(n, renderbuffers);
+	}
+	inline void glGenRenderbuffers (GLsizei n, GLuint *renderbuffers) {
+		current.calls[Call_glGenRenderbuffers] += 1;
+		return (::glGenRenderbuffers)(n, renderbuffers);
+	}
+	inline void glRenderbufferStorage (GLenum target, GLenum internalformat, GLsizei width, GLsizei height) {
+		current.calls[Call_glRenderbufferStorage] += 1;
+		return (::glRenderbufferStorage)(target, internalformat, width, height);
+	}
+	inline void glGetRenderbufferParameteriv (GLenum target, GLenum pname, GLint *params) {
+		current.calls[Call_glGetRenderbufferParameteriv] += 1;
+		return (::glGetRenderbufferParameteriv)(target, pname, params);
+	}
+	inline GLboolean glIsFramebuffer (GLuint framebuffer) {
+		current.calls[Call_glIsFramebuffer] += 1;
+		return (::glIsFramebuffer)(framebuffer);
+	}
+	inline void glBindFramebuffer (GLenum target, GLuint framebuffer) {
+		current.calls[Call_glBindFramebuffer] += 1;
+		current.state_changes += 1;
+		return (::glBindFramebuffer)(target, framebuffer);
+	}
+	inline void glDeleteFramebuffers (GLsizei n, const GLuint *framebuffers) {
+		current.calls[Call_glDeleteFramebuffers] += 1;
+		return (::glDeleteFramebuffers)(n, framebuffers);
+	}
+	inline void glGenFramebuffers (GLsizei n, GLuint *framebuffers) {
+		current.calls[Call_glGenFramebuffers] += 1;
+		return (::glGenFramebuffers)(n, framebuffers);
+	}
+	inline GLenum glCheckFramebufferStatus (GLenum target) {
+		current.calls[Call_glCheckFramebufferStatus] += 1;
+		return (::glCheckFramebufferStatus)(target);
+	}
+	inline void glFramebufferTexture1D (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level) {
+		current.calls[Call_glFramebufferTexture1D] += 1;
+		return (::glFramebufferTexture1D)(target, attachment, textarget, texture, level);
+	}
+	inline void glFramebufferTexture2D (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level) {
+		current.calls[Call_glFramebufferTexture2D] += 1;
+		return (::glFramebufferTexture2D)(target, attachment, textarget, texture, level);
+	}
+	inline void glFramebufferTexture3D (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level, GLint zoffset) {
+		current.calls[Call_glFramebufferTexture3D] += 1;
+		return (::glFramebufferTexture3D)(target, attachment, textarget, texture, level, zoffset);
+	}
+	inline void glFramebufferRenderbuffer (GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer) {
+		current.calls[Call_glFramebufferRenderbuffer] += 1;
+		return (::glFramebufferRenderbuffer)(target, attachment, renderbuffertarget, renderbuffer);
+	}
+	inline void glGetFramebufferAttachmentParameteriv (GLenum target, GLenum attachment, GLenum pname, GLint *params) {
+		current.calls[Call_glGetFramebufferAttachmentParameteriv] += 1;
+		return (::glGetFramebufferAttachmentParameteriv)(target, attachment, pname, params);
+	}
+	inline void glGenerateMipmap (GLenum target) {
+		current.calls[Call_glGenerateMipmap] += 1;
+		return (::glGenerateMipmap)(target);
+	}
+	inline void glBlitFramebuffer (GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter) {
+		current.calls[Call_glBlitFramebuffer] += 1;
+		return (::glBlitFramebuffer)(srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter);
+	}
+	inline void glRenderbufferStorageMultisample (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height) {
+		current.calls[Call_glRenderbufferStorageMultisample] += 1;
+		return (::glRenderbufferStorageMultisample)(target, samples, internalformat, width, height);
+	}
+	inline void glFramebufferTextureLayer (GLenum target, GLenum attachment, GLuint texture, GLint level, GLint layer) {
+		current.calls[Call_glFramebufferTextureLayer] += 1;
+		return (::glFramebufferTextureLayer)(target, attachment, texture, level, layer);
+	}
+	inline void * glMapBufferRange (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+		current.calls[Call_glMapBufferRange] += 1;
+		return (::glMapBufferRange)(target, offset, length, access);
+	}
+	inline void glFlushMappedBufferRange (GLenum target, GLintptr offset, GLsizeiptr length) {
+		current.calls[Call_glFlushMappedBufferRange] += 1;
+		return (::glFlushMappedBufferRange)(target, offset, length);
+	}
+	inline void glBindVertexArray (GLuint array) {
+		current.calls[Call_glBindVertexArray] += 1;
+		current.state_changes += 1;
+		return (::glBindVertexArray)(array);
+	}
+	inline void glDeleteVertexArrays (GLsizei n, const GLuint *arrays) {
+		current.calls[Call_glDeleteVertexArrays] += 1;
+		return (::glDeleteVertexArrays)(n, arrays);
+	}
+	inline void glGenVertexArrays (GLsizei n, GLuint *arrays) {
+		current.calls[Call_glGenVertexArrays] += 1;
+		return (::glGenVertexArrays)(n, arrays);
+	}
+	inline GLboolean glIsVertexArray (GLuint array) {
+		current.calls[Call_glIsVertexArray] += 1;
+		return (::glIsVertexArray)(array);
+	}
+	inline void glDrawArraysInstanced (GLenum mode, GLint first, GLsizei count, GLsizei instancecount) {
+		current.calls[Call_glDrawArraysInstanced] += 1;
+		current.draw_calls += 1;
+		Timer timer(Call_glDrawArraysInstanced);
+		return (::glDrawArraysInstanced)(mode, first, count, instancecount);
+	}
+	inline void glDrawElementsInstanced (GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount) {
+		current.calls[Call_glDrawElementsInstanced] += 1;
+		current.draw_calls += 1;
+		Timer timer(Call_glDrawElementsInstanced);
+		return (::glDrawElementsInstanced)(mode, count, type, indices, instancecount);
+	}
+	inline void glTexBuffer (GLenum target, GLenum internalformat, GLuint buffer) {
+		current.calls[Call_glTexBuffer] += 1;
+		return (::glTexBuffer)(target, internalformat, buffer);
+	}
+	inline void glPrimitiveRestartIndex (GLuint index) {
+		current.calls[Call_glPrimitiveRestartIndex] += 1;
+		return (::glPrimitiveRestartIndex)(index);
+	}
+	inline void glCopyBufferSubData (GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size) {
+		current.calls[Call_glCopyBufferSubData] += 1;
+		return (::glCopyBufferSubData)(readTarget, writeTarget, readOffset, writeOffset, size);
+	}
+	inline void glGetUniformIndices (GLuint program, GLsizei uniformCount, const GLchar *const*uniformNames, GLuint *uniformIndices) {
+		current.calls[Call_glGetUniformIndices] += 1;
+		return (::glGetUniformIndices)(program, uniformCount, uniformNames, uniformIndices);
+	}
+	inline void glGetActiveUniformsiv (GLuint program, GLsizei uniformCount, const GLuint *uniformIndices, GLenum pname, GLint *params) {
+		current.calls[Call_glGetActiveUniformsiv] += 1;
+		return (::glGetActiveUniformsiv)(program, uniformCount, uniformIndices, pname, params);
+	}
+	inline void glGetActiveUniformName (GLuint program, GLuint uniformIndex, GLsizei bufSize, GLsizei *length, GLchar *uniformName) {
+		current.calls[Call_glGetActiveUniformName] += 1;
+		return (::glGetActiveUniformName)(program, uniformIndex, bufSize, length, uniformName);
+	}
+	inline GLuint glGetUniformBlockIndex (GLuint program, const GLchar *uniformBlockName) {
+		current.calls[Call_glGetUniformBlockIndex] += 1;
+		return (::glGetUniformBlockIndex)(program, uniformBlockName);
+	}
+	inline void glGetActiveUniformBlockiv (GLuint program, GLuint uniformBlockIndex, GLenum pname, GLint *params) {
+		current.calls[Call_glGetActiveUniformBlockiv] += 1;
+		return (::glGetActiveUniformBlockiv)(program, uniformBlockIndex, pname, params);
+	}
+	inline void glGetActiveUniformBlockName (GLuint program, GLuint uniformBlockIndex, GLsizei bufSize, GLsizei *length, GLchar *uniformBlockName) {
+		current.calls[Call_glGetActiveUniformBlockName] += 1;
+		return (::glGetActiveUniformBlockName)(program, uniformBlockIndex, bufSize, length, uniformBlockName);
+	}
+	inline void glUniformBlockBinding (GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding) {
+		current.calls[Call_glUniformBlockBinding] += 1;
+		return (::glUniformBlockBinding)(program, uniformBlockIndex, uniformBlockBinding);
+	}
+	inline void glDrawElementsBaseVertex (GLenum mode, GLsizei count, GLenum type, const void *indices, GLint basevertex) {
+		current.calls[Call_glDrawElementsBaseVertex] += 1;
+		current.draw_calls += 1;
+		return (::glDrawElementsBaseVertex)(mode, count, type, indices, basevertex);
+	}
+	inline void glDrawRangeElementsBaseVertex (GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const void *indices, GLint basevertex) {
+		current.calls[Call_glDrawRangeElementsBaseVertex] += 1;
+		current.draw_calls += 1;
+		return (::glDrawRangeElementsBaseVertex)(mode, start, end, count, type, indices, basevertex);
+	}
+	inline void glDrawElementsInstancedBaseVertex (GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount, GLint basevertex) {
+		current.calls[Call_glDrawElementsInstancedBaseVertex] += 1;
+		current.draw_calls += 1;
+		return (::glDrawElementsInstancedBaseVertex)(mode, count, type, indices, instancecount, basevertex);
+	}
+	inline void glMultiDrawElementsBaseVertex (GLenum mode, const GLsizei *count, GLenum type, const void *const*indices, GLsizei drawcount, const GLint *basevertex) {
+		current.calls[Call_glMultiDrawElementsBaseVertex] += 1;
+		current.draw_calls += 1;
+		return (::glMultiDrawElementsBaseVertex)(mode, count, type, indices, drawcount, basevertex);
+	}
+	inline void glProvokingVertex (GLenum mode) {
+		current.calls[Call_glProvokingVertex] += 1;
+		return (::glProvokingVertex)(mode);
+	}
+	inline GLsync glFenceSync (GLenum condition, GLbitfield flags) {
+		current.calls[Call_glFenceSync] += 1;
+		return (::glFenceSync)(condition, flags);
+	}
+	inline GLboolean glIsSync (GLsync sync) {
+		current.calls[Call_glIsSync] += 1;
+		return (::glIsSync)(sync);
+	}
+	inline void glDeleteSync (GLsync sync) {
+		current.calls[Call_glDeleteSync] += 1;
+		return (::glDeleteSync)(sync);
+	}
+	inline GLenum glClientWaitSync (GLsync sync, GLbitfield flags, GLuint64 timeout) {
+		current.calls[Call_glClientWaitSync] += 1;
+		return (::glClientWaitSync)(sync, flags, timeout);
+	}
+	inline void glWaitSync (GLsync sync, GLbitfield flags, GLuint64 timeout) {
+		current.calls[Call_glWaitSync] += 1;
+		return (::glWaitSync)(sync, flags, timeout);
+	}
+	inline void glGetInteger64v (GLenum pname, GLint64 *data) {
+		current.calls[Call_glGetInteger64v] += 1;
+		return (::glGetInteger64v)(pname, data);
+	}
+	inline void glGetSynciv (GLsync sync, GLenum pname, GLsizei bufSize, GLsizei *length, GLint *values) {
+		current.calls[Call_glGetSynciv] += 1;
+		return (::glGetSynciv)(sync, pname, bufSize, length, values);
+	}
+	inline void glGetInteger64i_v (GLenum target, GLuint index, GLint64 *data) {
+		current.calls[Call_glGetInteger64i_v] += 1;
+		return (::glGetInteger64i_v)(target, index, data);
+	}
+	inline void glGetBufferParameteri64v (GLenum target, GLenum pname, GLint64 *params) {
+		current.calls[Call_glGetBufferParameteri64v] += 1;
+		return (::glGetBufferParameteri64v)(target, pname, params);
+	}
+	inline void glFramebufferTexture (GLenum target, GLenum attachment, GLuint texture, GLint level) {
+		current.calls[Call_glFramebufferTexture] += 1;
+		return (::glFramebufferTexture)(target, attachment, texture, level);
+	}
+	inline void glTexImage2DMultisample (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLboolean fixedsamplelocations) {
+		current.calls[Call_glTexImage2DMultisample] += 1;
+		return (::glTexImage2DMultisample)(target, samples, internalformat, width, height, fixedsamplelocations);
+	}
+	inline void glTexImage3DMultisample (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLboolean fixedsamplelocations) {
+		current.calls[Call_glTexImage3DMultisample] += 1;
+		return (::glTexImage3DMultisample)(target, samples, internalformat, width, height, depth, fixedsamplelocations);
+	}
+	inline void glGetMultisamplefv (GLenum pname, GLuint index, GLfloat *val) {
+		current.calls[Call_glGetMultisamplefv] += 1;
+		return (::glGetMultisamplefv)(pname, index, val);
+	}
+	inline void glSampleMaski (GLuint maskNumber, GLbitfield mask) {
+		current.calls[Call_glSampleMaski] += 1;
+		return (::glSampleMaski)(maskNumber, mask);
+	}
+	inline void glBindFragDataLocationIndexed (GLuint program, GLuint colorNumber, GLuint index, const GLchar *name) {
+		current.calls[Call_glBindFragDataLocationIndexed] += 1;
+		return (::glBindFragDataLocationIndexed)(program, colorNumber, index, name);
+	}
+	inline GLint glGetFragDataIndex (GLuint program, const GLchar *name) {
+		current.calls[Call_glGetFragDataIndex] += 1;
+		return (::glGetFragDataIndex)(program, name);
+	}
+	inline void glGenSamplers (GLsizei count, GLuint *samplers) {
+		current.calls[Call_glGenSamplers] += 1;
+		return (::glGenSamplers)(count, samplers);
+	}
+	inline void glDeleteSamplers (GLsizei count, const GLuint *samplers) {
+		current.calls[Call_glDeleteSamplers] += 1;
+		return (::glDeleteSamplers)(count, samplers);
+	}
+	inline GLboolean glIsSampler (GLuint sampler) {
+		current.calls[Call_glIsSampler] += 1;
+		return (::glIsSampler)(sampler);
+	}
+	inline void glBindSampler (GLuint unit, GLuint sampler) {
+		current.calls[Call_glBindSampler] += 1;
+		current.state_changes += 1;
+		return (::glBindSampler)(unit, sampler);
+	}
+	inline void glSamplerParameteri (GLuint sampler, GLenum pname, GLint param) {
+		current.calls[Call_glSamplerParameteri] += 1;
+		return (::glSamplerParameteri)(sampler, pname, param);
+	}
+	inline void glSamplerParameteriv (GLuint sampler, GLenum pname, const GLint *param) {
+		current.calls[Call_glSamplerParameteriv] += 1;
+		return (::glSamplerParameteriv)(sampler, pname, param);
+	}
+	inline void glSamplerParameterf (GLuint sampler, GLenum pname, GLfloat param) {
+		current.calls[Call_glSamplerParameterf] += 1;
+		return (::glSamplerParameterf)(sampler, pname, param);
+	}
+	inline void glSamplerParameterfv (GLuint sampler, GLenum pname, const GLfloat *param) {
+		current.calls[Call_glSamplerParameterfv] += 1;
+		return (::glSamplerParameterfv)(sampler, pname, param);
+	}
+	inline void glSamplerParameterIiv (GLuint sampler, GLenum pname, const GLint *param) {
+		current.calls[Call_glSamplerParameterIiv] += 1;
+		return (::glSamplerParameterIiv)(sampler, pname, param);
+	}
+	inline void glSamplerParameterIuiv (GLuint sampler, GLenum pname, const GLuint *param) {
+		current.calls[Call_glSamplerParameterIuiv] += 1;
+		return (::glSamplerParameterIuiv)(sampler, pname, param);
+	}
+	inline void glGetSamplerParameteriv (GLuint sampler, GLenum pname, GLint *params) {
+		current.calls[Call_glGetSamplerParameteriv] += 1;
+		return (::glGetSamplerParameteriv)(sampler, pname, params);
+	}
+	inline void glGetSamplerParameterIiv (GLuint sampler, GLenum pname, GLint *params) {
+		current.calls[Call_glGetSamplerParameterIiv] += 1;
+		return (::glGetSamplerParameterIiv)(sampler, pname, params);
+	}
+	inline void glGetSamplerParameterfv (GLuint sampler, GLenum pname, GLfloat *params) {
+		current.calls[Call_glGetSamplerParameterfv] += 1;
+		return (::glGetSamplerParameterfv)(sampler, pname, params);
+	}
+	inline void glGetSamplerParameterIuiv (GLuint sampler, GLenum pname, GLuint *params) {
+		current.calls[Call_glGetSamplerParameterIuiv] += 1;
+		return (::glGetSamplerParameterIuiv)(sampler, pname, params);
+	}
+	inline void glQueryCounter (GLuint id, GLenum target) {
+		current.calls[Call_glQueryCounter] += 1;
+		return (::glQueryCounter)(id, target);
+	}
+	inline void glGetQueryObjecti64v (GLuint id, GLenum pname, GLint64 *params) {
+		current.calls[Call_glGetQueryObjecti64v] += 1;
+		return (::glGetQueryObjecti64v)(id, pname, params);
+	}
+	inline void glGetQueryObjectui64v (GLuint id, GLenum pname, GLuint64 *params) {
+		current.calls[Call_glGetQueryObjectui64v] += 1;
+		return (::glGetQueryObjectui64v)(id, pname, params);
+	}
+	inline void glVertexAttribDivisor (GLuint index, GLuint divisor) {
+		current.calls[Call_glVertexAttribDivisor] += 1;
+		return (::glVertexAttribDivisor)(index, divisor);
+	}
+	inline void glVertexAttribP1ui (GLuint index, GLenum type, GLboolean normalized, GLuint value) {
+		current.calls[Call_glVertexAttribP1ui] += 1;
+		return (::glVertexAttribP1ui)(index, type, normalized, value);
+	}
+	inline void glVertexAttribP1uiv (GLuint index, GLenum type, GLboolean normalized, const GLuint *value) {
+		current.calls[Call_glVertexAttribP1uiv] += 1;
+		return (::glVertexAttribP1uiv)(index, type, normalized, value);
+	}
+	inline void glVertexAttribP2ui (GLuint index, GLenum type, GLboolean normalized, GLuint value) {
+		current.calls[Call_glVertexAttribP2ui] += 1;
+		return (::glVertexAttribP2ui)(index, type, normalized, value);
+	}
+	inline void glVertexAttribP2uiv (GLuint index, GLenum type, GLboolean normalized, const GLuint *value) {
+		current.calls[Call_glVertexAttribP2uiv] += 1;
+		return (::glVertexAttribP2uiv)(index, type, normalized, value);
+	}
+	inline void glVertexAttribP3ui (GLuint index, GLenum type, GLboolean normalized, GLuint value) {
+		current.calls[Call_glVertexAttribP3ui] += 1;
+		return (::glVertexAttribP3ui)(index, type, normalized, value);
+	}
+	inline void glVertexAttribP3uiv (GLuint index, GLenum type, GLboolean normalized, const GLuint *value) {
+		current.calls[Call_glVertexAttribP3uiv] += 1;
+		return (::glVertexAttribP3uiv)(index, type, normalized, value);
+	}
+	inline void glVertexAttribP4ui (GLuint index, GLenum type, GLboolean normalized, GLuint value) {
+		current.calls[Call_glVertexAttribP4ui] += 1;
+		return (::glVertexAttribP4ui)(index, type, normalized, value);
+	}
+	inline void glVertexAttribP4uiv (GLuint index, GLenum type, GLboolean normalized, const GLuint *value) {
+		current.calls[Call_glVertexAttribP4uiv] += 1;
+		return (::glVertexAttribP4uiv)(index, type, normalized, value);
+	}
+}
+
+//(a function-like macro only applies to calls, so declarations and function pointers are left alone)
+#define glCullFace(...) GLStats::glCullFace(__VA_ARGS__)
+#define glFrontFace(...) GLStats::glFrontFace(__VA_ARGS__)
+#define glHint(...) GLStats::glHint(__VA_ARGS__)
+#define glLineWidth(...) GLStats::glLineWidth(__VA_ARGS__)
+#define glPointSize(...) GLStats::glPointSize(__VA_ARGS__)
+#define glPolygonMode(...) GLStats::glPolygonMode(__VA_ARGS__)
+#define glScissor(...) GLStats::glScissor(__VA_ARGS__)
+#define glTexParameterf(...) GLStats::glTexParameterf(__VA_ARGS__)
+#define glTexParameterfv(...) GLStats::glTexParameterfv(__VA_ARGS__)
+#define glTexParameteri(...) GLStats::glTexParameteri(__VA_ARGS__)
+#define glTexParameteriv(...) GLStats::glTexParameteriv(__VA_ARGS__)
+#define glTexImage1D(...) GLStats::glTexImage1D(__VA_ARGS__)
+#define glTexImage2D(...) GLStats::glTexImage2D(__VA_ARGS__)
+#define glDrawBuffer(...) GLStats::glDrawBuffer(__VA_ARGS__)
+#define glClear(...) GLStats::glClear(__VA_ARGS__)
+#define glClearColor(...) GLStats::glClearColor(__VA_ARGS__)
+#define glClearStencil(...) GLStats::glClearStencil(__VA_ARGS__)
+#define glClearDepth(...) GLStats::glClearDepth(__VA_ARGS__)
+#define glStencilMask(...) GLStats::glStencilMask(__VA_ARGS__)
+#define glColorMask(...) GLStats::glColorMask(__VA_ARGS__)
+#define glDepthMask(...) GLStats::glDepthMask(__VA_ARGS__)
+#define glDisable(...) GLStats::glDisable(__VA_ARGS__)
+#define glEnable(...) GLStats::glEnable(__VA_ARGS__)
+#define glFinish(...) GLStats::glFinish(__VA_ARGS__)
+#define glFlush(...) GLStats::glFlush(__VA_ARGS__)
+#define glBlendFunc(...) GLStats::glBlendFunc(__VA_ARGS__)
+#define glLogicOp(...) GLStats::glLogicOp(__VA_ARGS__)
+#define glStencilFunc(...) GLStats::glStencilFunc(__VA_ARGS__)
+#define glStencilOp(...) GLStats::glStencilOp(__VA_ARGS__)
+#define glDepthFunc(...) GLStats::glDepthFunc(__VA_ARGS__)
+#define glPixelStoref(...) GLStats::glPixelStoref(__VA_ARGS__)
+#define glPixelStorei(...) GLStats::glPixelStorei(__VA_ARGS__)
+#define glReadBuffer(...) GLStats::glReadBuffer(__VA_ARGS__)
+#define glReadPixels(...) GLStats::glReadPixels(__VA_ARGS__)
+#define glGetBooleanv(...) GLStats::glGetBooleanv(__VA_ARGS__)
+#define glGetDoublev(...) GLStats::glGetDoublev(__VA_ARGS__)
+#define glGetError(...) GLStats::glGetError(__VA_ARGS__)
+#define glGetFloatv(...) GLStats::glGetFloatv(__VA_ARGS__)
+#define glGetIntegerv(...) GLStats::glGetIntegerv(__VA_ARGS__)
+#define glGetString(...) GLStats::glGetString(__VA_ARGS__)
+#define glGetTexImage(...) GLStats::glGetTexImage(__VA_ARGS__)
+#define glGetTexParameterfv(...) GLStats::glGetTexParameterfv(__VA_ARGS__)
+#define glGetTexParameteriv(...) GLStats::glGetTexParameteriv(__VA_ARGS__)
+#define glGetTexLevelParameterfv(...) GLStats::glGetTexLevelParameterfv(__VA_ARGS__)
+#define glGetTexLevelParameteriv(...) GLStats::glGetTexLevelParameteriv(__VA_ARGS__)
+#define glIsEnabled(...) GLStats::glIsEnabled(__VA_ARGS__)
+#define glDepthRange(...) GLStats::glDepthRange(__VA_ARGS__)
+#define glViewport(...) GLStats::glViewport(__VA_ARGS__)
+#define glDrawArrays(...) GLStats::glDrawArrays(__VA_ARGS__)
+#define glDrawElements(...) GLStats::glDrawElements(__VA_ARGS__)
+#define glGetPointerv(...) GLStats::glGetPointerv(__VA_ARGS__)
+#define glPolygonOffset(...) GLStats::glPolygonOffset(__VA_ARGS__)
+#define glCopyTexImage1D(...) GLStats::glCopyTexImage1D(__VA_ARGS__)
+#define glCopyTexImage2D(...) GLStats::glCopyTexImage2D(__VA_ARGS__)
+#define glCopyTexSubImage1D(...) GLStats::glCopyTexSubImage1D(__VA_ARGS__)
+#define glCopyTexSubImage2D(...) GLStats::glCopyTexSubImage2D(__VA_ARGS__)
+#define glTexSubImage1D(...) GLStats::glTexSubImage1D(__VA_ARGS__)
+#define glTexSubImage2D(...) GLStats::glTexSubImage2D(__VA_ARGS__)
+#define glBindTexture(...) GLStats::glBindTexture(__VA_ARGS__)
+#define glDeleteTextures(...) GLStats::glDeleteTextures(__VA_ARGS__)
+#define glGenTextures(...) GLStats::glGenTextures(__VA_ARGS__)
+#define glIsTexture(...) GLStats::glIsTexture(__VA_ARGS__)
+#define glDrawRangeElements(...) GLStats::glDrawRangeElements(__VA_ARGS__)
+#define glTexImage3D(...) GLStats::glTexImage3D(__VA_ARGS__)
+#define glTexSubImage3D(...) GLStats::glTexSubImage3D(__VA_ARGS__)
+#define glCopyTexSubImage3D(...) GLStats::glCopyTexSubImage3D(__VA_ARGS__)
+#define glActiveTexture(...) GLStats::glActiveTexture(__VA_ARGS__)
+#define glSampleCoverage(...) GLStats::glSampleCoverage(__VA_ARGS__)
+#define glCompressedTexImage3D(...) GLStats::glCompressedTexImage3D(__VA_ARGS__)
+#define glCompressedTexImage2D(...) GLStats::glCompressedTexImage2D(__VA_ARGS__)
+#define glCompressedTexImage1D(...) GLStats::glCompressedTexImage1D(__VA_ARGS__)
+#define glCompressedTexSubImage3D(...) GLStats::glCompressedTexSubImage3D(__VA_ARGS__)
+#define glCompressedTexSubImage2D(...) GLStats::glCompressedTexSubImage2D(__VA_ARGS__)
+#define glCompressedTexSubImage1D(...) GLStats::glCompressedTexSubImage1D(__VA_ARGS__)
+#define glGetCompressedTexImage(...) GLStats::glGetCompressedTexImage(__VA_ARGS__)
+#define glBlendFuncSeparate(...) GLStats::glBlendFuncSeparate(__VA_ARGS__)
+#define glMultiDrawArrays(...) GLStats::glMultiDrawArrays(__VA_ARGS__)
+#define glMultiDrawElements(...) GLStats::glMultiDrawElements(__VA_ARGS__)
+#define glPointParameterf(...) GLStats::glPointParameterf(__VA_ARGS__)
+#define glPointParameterfv(...) GLStats::glPointParameterfv(__VA_ARGS__)
+#define glPointParameteri(...) GLStats::glPointParameteri(__VA_ARGS__)
+#define glPointParameteriv(...) GLStats::glPointParameteriv(__VA_ARGS__)
+#define glBlendColor(...) GLStats::glBlendColor(__VA_ARGS__)
+#define glBlendEquation(...) GLStats::glBlendEquation(__VA_ARGS__)
+#define glGenQueries(...) GLStats::glGenQueries(__VA_ARGS__)
+#define glDeleteQueries(...) GLStats::glDeleteQueries(__VA_ARGS__)
+#define glIsQuery(...) GLStats::glIsQuery(__VA_ARGS__)
+#define glBeginQuery(...) GLStats::glBeginQuery(__VA_ARGS__)
+#define glEndQuery(...) GLStats::glEndQuery(__VA_ARGS__)
+#define glGetQueryiv(...) GLStats::glGetQueryiv(__VA_ARGS__)
+#define glGetQueryObjectiv(...) GLStats::glGetQueryObjectiv(__VA_ARGS__)
+#define glGetQueryObjectuiv(...) GLStats::glGetQueryObjectuiv(__VA_ARGS__)
+#define glBindBuffer(...) GLStats::glBindBuffer(__VA_ARGS__)
+#define glDeleteBuffers(...) GLStats::glDeleteBuffers(__VA_ARGS__)
+#define glGenBuffers(...) GLStats::glGenBuffers(__VA_ARGS__)
+#define glIsBuffer(...) GLStats::glIsBuffer(__VA_ARGS__)
+#define glBufferData(...) GLStats::glBufferData(__VA_ARGS__)
+#define glBufferSubData(...) GLStats::glBufferSubData(__VA_ARGS__)
+#define glGetBufferSubData(...) GLStats::glGetBufferSubData(__VA_ARGS__)
+#define glMapBuffer(...) GLStats::glMapBuffer(__VA_ARGS__)
+#define glUnmapBuffer(...) GLStats::glUnmapBuffer(__VA_ARGS__)
+#define glGetBufferParameteriv(...) GLStats::glGetBufferParameteriv(__VA_ARGS__)
+#define glGetBufferPointerv(...) GLStats::glGetBufferPointerv(__VA_ARGS__)
+#define glBlendEquationSeparate(...) GLStats::glBlendEquationSeparate(__VA_ARGS__)
+#define glDrawBuffers(...) GLStats::glDrawBuffers(__VA_ARGS__)
+#define glStencilOpSeparate(...) GLStats::glStencilOpSeparate(__VA_ARGS__)
+#define glStencilFuncSeparate(...) GLStats::glStencilFuncSeparate(__VA_ARGS__)
+#define glStencilMaskSeparate(...) GLStats::glStencilMaskSeparate(__VA_ARGS__)
+#define glAttachShader(...) GLStats::glAttachShader(__VA_ARGS__)
+#define glBindAttribLocation(...) GLStats::glBindAttribLocation(__VA_ARGS__)
+#define glCompileShader(...) GLStats::glCompileShader(__VA_ARGS__)
+#define glCreateProgram(...) GLStats::glCreateProgram(__VA_ARGS__)
+#define glCreateShader(...) GLStats::glCreateShader(__VA_ARGS__)
+#define glDeleteProgram(...) GLStats::glDeleteProgram(__VA_ARGS__)
+#define glDeleteShader(...) GLStats::glDeleteShader(__VA_ARGS__)
+#define glDetachShader(...) GLStats::glDetachShader(__VA_ARGS__)
+#define glDisableVertexAttribArray(...) GLStats::glDisableVertexAttribArray(__VA_ARGS__)
+#define glEnableVertexAttribArray(...) GLStats::glEnableVertexAttribArray(__VA_ARGS__)
+#define glGetActiveAttrib(...) GLStats::glGetActiveAttrib(__VA_ARGS__)
+#define glGetActiveUniform(...) GLStats::glGetActiveUniform(__VA_ARGS__)
+#define glGetAttachedShaders(...) GLStats::glGetAttachedShaders(__VA_ARGS__)
+#define glGetAttribLocation(...) GLStats::glGetAttribLocation(__VA_ARGS__)
+#define glGetProgramiv(...) GLStats::glGetProgramiv(__VA_ARGS__)
+#define glGetProgramInfoLog(...) GLStats::glGetProgramInfoLog(__VA_ARGS__)
+#define glGetShaderiv(...) GLStats::glGetShaderiv(__VA_ARGS__)
+#define glGetShaderInfoLog(...) GLStats::glGetShaderInfoLog(__VA_ARGS__)
+#define glGetShaderSource(...) GLStats::glGetShaderSource(__VA_ARGS__)
+#define glGetUniformLocation(...) GLStats::glGetUniformLocation(__VA_ARGS__)
+#define glGetUniformfv(...) GLStats::glGetUniformfv(__VA_ARGS__)
+#define glGetUniformiv(...) GLStats::glGetUniformiv(__VA_ARGS__)
+#define glGetVertexAttribdv(...) GLStats::glGetVertexAttribdv(__VA_ARGS__)
+#define glGetVertexAttribfv(...) GLStats::glGetVertexAttribfv(__VA_ARGS__)
+#define glGetVertexAttribiv(...) GLStats::glGetVertexAttribiv(__VA_ARGS__)
+#define glGetVertexAttribPointerv(...) GLStats::glGetVertexAttribPointerv(__VA_ARGS__)
+#define glIsProgram(...) GLStats::glIsProgram(__VA_ARGS__)
+#define glIsShader(...) GLStats::glIsShader(__VA_ARGS__)
+#define glLinkProgram(...) GLStats::glLinkProgram(__VA_ARGS__)
+#define glShaderSource(...) GLStats::glShaderSource(__VA_ARGS__)
+#define glUseProgram(...) GLStats::glUseProgram(__VA_ARGS__)
+#define glUniform1f(...) GLStats::glUniform1f(__VA_ARGS__)
+#define glUniform2f(...) GLStats::glUniform2f(__VA_ARGS__)
+#define glUniform3f(...) GLStats::glUniform3f(__VA_ARGS__)
+#define glUniform4f(...) GLStats::glUniform4f(__VA_ARGS__)
+#define glUniform1i(...) GLStats::glUniform1i(__VA_ARGS__)
+#define glUniform2i(...) GLStats::glUniform2i(__VA_ARGS__)
+#define glUniform3i(...) GLStats::glUniform3i(__VA_ARGS__)
+#define glUniform4i(...) GLStats::glUniform4i(__VA_ARGS__)
+#define glUniform1fv(...) GLStats::glUniform1fv(__VA_ARGS__)
+#define glUniform2fv(...) GLStats::glUniform2fv(__VA_ARGS__)
+#define glUniform3fv(...) GLStats::glUniform3fv(__VA_ARGS__)
+#define glUniform4fv(...) GLStats::glUniform4fv(__VA_ARGS__)
+#define glUniform1iv(...) GLStats::glUniform1iv(__VA_ARGS__)
+#define glUniform2iv(...) GLStats::glUniform2iv(__VA_ARGS__)
+#define glUniform3iv(...) GLStats::glUniform3iv(__VA_ARGS__)
+#define glUniform4iv(...) GLStats::glUniform4iv(__VA_ARGS__)
+#define glUniformMatrix2fv(...) GLStats::glUniformMatrix2fv(__VA_ARGS__)
+#define glUniformMatrix3fv(...) GLStats::glUniformMatrix3fv(__VA_ARGS__)
+#define glUniformMatrix4fv(...) GLStats::glUniformMatrix4fv(__VA_ARGS__)
+#define glValidateProgram(...) GLStats::glValidateProgram(__VA_ARGS__)
+#define glVertexAttrib1d(...) GLStats::glVertexAttrib1d(__VA_ARGS__)
+#define glVertexAttrib1dv(...) GLStats::glVertexAttrib1dv(__VA_ARGS__)
+#define glVertexAttrib1f(...) GLStats::glVertexAttrib1f(__VA_ARGS__)
+#define glVertexAttrib1fv(...) GLStats::glVertexAttrib1fv(__VA_ARGS__)
+#define glVertexAttrib1s(...) GLStats::glVertexAttrib1s(__VA_ARGS__)
+#define glVertexAttrib1sv(...) GLStats::glVertexAttrib1sv(__VA_ARGS__)
+#define glVertexAttrib2d(...) GLStats::glVertexAttrib2d(__VA_ARGS__)
+#define glVertexAttrib2dv(...) GLStats::glVertexAttrib2dv(__VA_ARGS__)
+#define glVertexAttrib2f(...) GLStats::glVertexAttrib2f(__VA_ARGS__)
+#define glVertexAttrib2fv(...) GLStats::glVertexAttrib2fv(__VA_ARGS__)
+#define glVertexAttrib2s(...) GLStats::glVertexAttrib2s(__VA_ARGS__)
+#define glVertexAttrib2sv(...) GLStats::glVertexAttrib2sv(__VA_ARGS__)
+#define glVertexAttrib3d(...) GLStats::glVertexAttrib3d(__VA_ARGS__)
+#define glVertexAttrib3dv(...) GLStats::glVertexAttrib3dv(__VA_ARGS__)
+#define glVertexAttrib3f(...) GLStats::glVertexAttrib3f(__VA_ARGS__)
+#define glVertexAttrib3fv(...) GLStats::glVertexAttrib3fv(__VA_ARGS__)
+#define glVertexAttrib3s(...) GLStats::glVertexAttrib3s(__VA_ARGS__)
+#define glVertexAttrib3sv(...) GLStats::glVertexAttrib3sv(__VA_ARGS__)
+#define glVertexAttrib4Nbv(...) GLStats::glVertexAttrib4Nbv(__VA_ARGS__)
+#define glVertexAttrib4Niv(...) GLStats::glVertexAttrib4Niv(__VA_ARGS__)
+#define glVertexAttrib4Nsv(...) GLStats::glVertexAttrib4Nsv(__VA_ARGS__)
+#define glVertexAttrib4Nub(...) GLStats::glVertexAttrib4Nub(__VA_ARGS__)
+#define glVertexAttrib4Nubv(...) GLStats::glVertexAttrib4Nubv(__VA_ARGS__)
+#define glVertexAttrib4Nuiv(...) GLStats::glVertexAttrib4Nuiv(__VA_ARGS__)
+#define glVertexAttrib4Nusv(...) GLStats::glVertexAttrib4Nusv(__VA_ARGS__)
+#define glVertexAttrib4bv(...) GLStats::glVertexAttrib4bv(__VA_ARGS__)
+#define glVertexAttrib4d(...) GLStats::glVertexAttrib4d(__VA_ARGS__)
+#define glVertexAttrib4dv(...) GLStats::glVertexAttrib4dv(__VA_ARGS__)
+#define glVertexAttrib4f(...) GLStats::glVertexAttrib4f(__VA_ARGS__)
+#define glVertexAttrib4fv(...) GLStats::glVertexAttrib4fv(__VA_ARGS__)
+#define glVertexAttrib4iv(...) GLStats::glVertexAttrib4iv(__VA_ARGS__)
+#define glVertexAttrib4s(...) GLStats::glVertexAttrib4s(__VA_ARGS__)
+#define glVertexAttrib4sv(...) GLStats::glVertexAttrib4sv(__VA_ARGS__)
+#define glVertexAttrib4ubv(...) GLStats::glVertexAttrib4ubv(__VA_ARGS__)
+#define glVertexAttrib4uiv(...) GLStats::glVertexAttrib4uiv(__VA_ARGS__)
+#define glVertexAttrib4usv(...) GLStats::glVertexAttrib4usv(__VA_ARGS__)
+#define glVertexAttribPointer(...) GLStats::glVertexAttribPointer(__VA_ARGS__)
+#define glUniformMatrix2x3fv(...) GLStats::glUniformMatrix2x3fv(__VA_ARGS__)
+#define glUniformMatrix3x2fv(...) GLStats::glUniformMatrix3x2fv(__VA_ARGS__)
+#define glUniformMatrix2x4fv(...) GLStats::glUniformMatrix2x4fv(__VA_ARGS__)
+#define glUniformMatrix4x2fv(...) GLStats::glUniformMatrix4x2fv(__VA_ARGS__)
+#define glUniformMatrix3x4fv(...) GLStats::glUniformMatrix3x4fv(__VA_ARGS__)
+#define glUniformMatrix4x3fv(...) GLStats::glUniformMatrix4x3fv(__VA_ARGS__)
+#define glColorMaski(...) GLStats::glColorMaski(__VA_ARGS__)
+#define glGetBooleani_v(...) GLStats::glGetBooleani_v(__VA_ARGS__)
+#define glGetIntegeri_v(...) GLStats::glGetIntegeri_v(__VA_ARGS__)
+#define glEnablei(...) GLStats::glEnablei(__VA_ARGS__)
+#define glDisablei(...) GLStats::glDisablei(__VA_ARGS__)
+#define glIsEnabledi(...) GLStats::glIsEnabledi(__VA_ARGS__)
+#define glBeginTransformFeedback(...) GLStats::glBeginTransformFeedback(__VA_ARGS__)
+#define glEndTransformFeedback(...) GLStats::glEndTransformFeedback(__VA_ARGS__)
+#define glBindBufferRange(...) GLStats::glBindBufferRange(__VA_ARGS__)
+#define glBindBufferBase(...) GLStats::glBindBufferBase(__VA_ARGS__)
+#define glTransformFeedbackVaryings(...) GLStats::glTransformFeedbackVaryings(__VA_ARGS__)
+#define glGetTransformFeedbackVarying(...) GLStats::glGetTransformFeedbackVarying(__VA_ARGS__)
+#define glClampColor(...) GLStats::glClampColor(__VA_ARGS__)
+#define glBeginConditionalRender(...) GLStats::glBeginConditionalRender(__VA_ARGS__)
+#define glEndConditionalRender(...) GLStats::glEndConditionalRender(__VA_ARGS__)
+#define glVertexAttribIPointer(...) GLStats::glVertexAttribIPointer(__VA_ARGS__)
+#define glGetVertexAttribIiv(...) GLStats::glGetVertexAttribIiv(__VA_ARGS__)
+#define glGetVertexAttribIuiv(...) GLStats::glGetVertexAttribIuiv(__VA_ARGS__)
+#define glVertexAttribI1i(...) GLStats::glVertexAttribI1i(__VA_ARGS__)
+#define glVertexAttribI2i(...) GLStats::glVertexAttribI2i(__VA_ARGS__)
+#define glVertexAttribI3i(...) GLStats::glVertexAttribI3i(__VA_ARGS__)
+#define glVertexAttribI4i(...) GLStats::glVertexAttribI4i(__VA_ARGS__)
+#define glVertexAttribI1ui(...) GLStats::glVertexAttribI1ui(__VA_ARGS__)
+#define glVertexAttribI2ui(...) GLStats::glVertexAttribI2ui(__VA_ARGS__)
+#define glVertexAttribI3ui(...) GLStats::glVertexAttribI3ui(__VA_ARGS__)
+#define glVertexAttribI4ui(...) GLStats::glVertexAttribI4ui(__VA_ARGS__)
+#define glVertexAttribI1iv(...) GLStats::glVertexAttribI1iv(__VA_ARGS__)
+#define glVertexAttribI2iv(...) GLStats::glVertexAttribI2iv(__VA_ARGS__)
+#define glVertexAttribI3iv(...) GLStats::glVertexAttribI3iv(__VA_ARGS__)
+#define glVertexAttribI4iv(...) GLStats::glVertexAttribI4iv(__VA_ARGS__)
+#define glVertexAttribI1uiv(...) GLStats::glVertexAttribI1uiv(__VA_ARGS__)
+#define glVertexAttribI2uiv(...) GLStats::glVertexAttribI2uiv(__VA_ARGS__)
+#define glVertexAttribI3uiv(...) GLStats::glVertexAttribI3uiv(__VA_ARGS__)
+#define glVertexAttribI4uiv(...) GLStats::glVertexAttribI4uiv(__VA_ARGS__)
+#define glVertexAttribI4bv(...) GLStats::glVertexAttribI4bv(__VA_ARGS__)
+#define glVertexAttribI4sv(...) GLStats::glVertexAttribI4sv(__VA_ARGS__)
+#define glVertexAttribI4ubv(...) GLStats::glVertexAttribI4ubv(__VA_ARGS__)
+#define glVertexAttribI4usv(...) GLStats::glVertexAttribI4usv(__VA_ARGS__)
+#define glGetUniformuiv(...) GLStats::glGetUniformuiv(__VA_ARGS__)
+#define glBindFragDataLocation(...) GLStats::glBindFragDataLocation(__VA_ARGS__)
+#define glGetFragDataLocation(...) GLStats::glGetFragDataLocation(__VA_ARGS__)
+#define glUniform1ui(...) GLStats::glUniform1ui(__VA_ARGS__)
+#define glUniform2ui(...) GLStats::glUniform2ui(__VA_ARGS__)
+#define glUniform3ui(...) GLStats::glUniform3ui(__VA_ARGS__)
+#define glUniform4ui(...) GLStats::glUniform4ui(__VA_ARGS__)
+#define glUniform1uiv(...) GLStats::glUniform1uiv(__VA_ARGS__)
+#define glUniform2uiv(...) GLStats::glUniform2uiv(__VA_ARGS__)
+#define glUniform3uiv(...) GLStats::glUniform3uiv(__VA_ARGS__)
+#define glUniform4uiv(...) GLStats::glUniform4uiv(__VA_ARGS__)
+#define glTexParameterIiv(...) GLStats::glTexParameterIiv(__VA_ARGS__)
+#define glTexParameterIuiv(...) GLStats::glTexParameterIuiv(__VA_ARGS__)
+#define glGetTexParameterIiv(...) GLStats::glGetTexParameterIiv(__VA_ARGS__)
+#define glGetTexParameterIuiv(...) GLStats::glGetTexParameterIuiv(__VA_ARGS__)
+#define glClearBufferiv(...) GLStats::glClearBufferiv(__VA_ARGS__)
+#define glClearBufferuiv(...) GLStats::glClearBufferuiv(__VA_ARGS__)
+#define glClearBufferfv(...) GLStats::glClearBufferfv(__VA_ARGS__)
+#define glClearBufferfi(...) GLStats::glClearBufferfi(__VA_ARGS__)
+#define glGetStringi(...) GLStats::glGetStringi(__VA_ARGS__)
+#define glIsRenderbuffer(...) GLStats::glIsRenderbuffer(__VA_ARGS__)
+#define glBindRenderbuffer(...) GLStats::glBindRenderbuffer(__VA_ARGS__)
+#define glDeleteRenderbuffers(...) GLStats::glDeleteRenderbuffers(__VA_ARGS__)
+#define glGenRenderbuffers(...) GLStats::glGenRenderbuffers(__VA_ARGS__)
+#define glRenderbufferStorage(...) GLStats::glRenderbufferStorage(__VA_ARGS__)
+#define glGetRenderbufferParameteriv(...) GLStats::glGetRenderbufferParameteriv(__VA_ARGS__)
+#define glIsFramebuffer(...) GLStats::glIsFramebuffer(__VA_ARGS__)
+#define glBindFramebuffer(...) GLStats::glBindFramebuffer(__VA_ARGS__)
+#define glDeleteFramebuffers(...) GLStats::glDeleteFramebuffers(__VA_ARGS__)
+#define glGenFramebuffers(...) GLStats::glGenFramebuffers(__VA_ARGS__)
+#define glCheckFramebufferStatus(...) GLStats::glCheckFramebufferStatus(__VA_ARGS__)
+#define glFramebufferTexture1D(...) GLStats::glFramebufferTexture1D(__VA_ARGS__)
+#define glFramebufferTexture2D(...) GLStats::glFramebufferTexture2D(__VA_ARGS__)
+#define glFramebufferTexture3D(...) GLStats::glFramebufferTexture3D(__VA_ARGS__)
+#define glFramebufferRenderbuffer(...) GLStats::glFramebufferRenderbuffer(__VA_ARGS__)
+#define glGetFramebufferAttachmentParameteriv(...) GLStats::glGetFramebufferAttachmentParameteriv(__VA_ARGS__)
+#define glGenerateMipmap(...) GLStats::glGenerateMipmap(__VA_ARGS__)
+#define glBlitFramebuffer(...) GLStats::glBlitFramebuffer(__VA_ARGS__)
+#define glRenderbufferStorageMultisample(...) GLStats::glRenderbufferStorageMultisample(__VA_ARGS__)
+#define glFramebufferTextureLayer(...) GLStats::glFramebufferTextureLayer(__VA_ARGS__)
+#define glMapBufferRange(...) GLStats::glMapBufferRange(__VA_ARGS__)
+#define glFlushMappedBufferRange(...) GLStats::glFlushMappedBufferRange(__VA_ARGS__)
+#define glBindVertexArray(...) GLStats::glBindVertexArray(__VA_ARGS__)
+#define glDeleteVertexArrays(...) GLStats::glDeleteVertexArrays(__VA_ARGS__)
+#define glGenVertexArrays(...) GLStats::glGenVertexArrays(__VA_ARGS__)
+#define glIsVertexArray(...) GLStats::glIsVertexArray(__VA_ARGS__)
+#define glDrawArraysInstanced(...) GLStats::glDrawArraysInstanced(__VA_ARGS__)
+#define glDrawElementsInstanced(...) GLStats::glDrawElementsInstanced(__VA_ARGS__)
+#define glTexBuffer(...) GLStats::glTexBuffer(__VA_ARGS__)
+#define glPrimitiveRestartIndex(...) GLStats::glPrimitiveRestartIndex(__VA_ARGS__)
+#define glCopyBufferSubData(...) GLStats::glCopyBufferSubData(__VA_ARGS__)
+#define glGetUniformIndices(...) GLStats::glGetUniformIndices(__VA_ARGS__)
+#define glGetActiveUniformsiv(...) GLStats::glGetActiveUniformsiv(__VA_ARGS__)
+#define glGetActiveUniformName(...) GLStats::glGetActiveUniformName(__VA_ARGS__)
+#define glGetUniformBlockIndex(...) GLStats::glGetUniformBlockIndex(__VA_ARGS__)
+#define glGetActiveUniformBlockiv(...) GLStats::glGetActiveUniformBlockiv(__VA_ARGS__)
+#define glGetActiveUniformBlockName(...) GLStats::glGetActiveUniformBlockName(__VA_ARGS__)
+#define glUniformBlockBinding(...) GLStats::glUniformBlockBinding(__VA_ARGS__)
+#define glDrawElementsBaseVertex(...) GLStats::glDrawElementsBaseVertex(__VA_ARGS__)
+#define glDrawRangeElementsBaseVertex(...) GLStats::glDrawRangeElementsBaseVertex(__VA_ARGS__)
+#define glDrawElementsInstancedBaseVertex(...) GLStats::glDrawElementsInstancedBaseVertex(__VA_ARGS__)
+#define glMultiDrawElementsBaseVertex(...) GLStats::glMultiDrawElementsBaseVertex(__VA_ARGS__)
+#define glProvokingVertex(...) GLStats::glProvokingVertex(__VA_ARGS__)
+#define glFenceSync(...) GLStats::glFenceSync(__VA_ARGS__)
+#define glIsSync(...) GLStats::glIsSync(__VA_ARGS__)
+#define glDeleteSync(...) GLStats::glDeleteSync(__VA_ARGS__)
+#define glClientWaitSync(...) GLStats::glClientWaitSync(__VA_ARGS__)
+#define glWaitSync(...) GLStats::glWaitSync(__VA_ARGS__)
+#define glGetInteger64v(...) GLStats::glGetInteger64v(__VA_ARGS__)
+#define glGetSynciv(...) GLStats::glGetSynciv(__VA_ARGS__)
+#define glGetInteger64i_v(...) GLStats::glGetInteger64i_v(__VA_ARGS__)
+#define glGetBufferParameteri64v(...) GLStats::glGetBufferParameteri64v(__VA_ARGS__)
+#define glFramebufferTexture(...) GLStats::glFramebufferTexture(__VA_ARGS__)
+#define glTexImage2DMultisample(...) GLStats::glTexImage2DMultisample(__VA_ARGS__)
+#define glTexImage3DMultisample(...) GLStats::glTexImage3DMultisample(__VA_ARGS__)
+#define glGetMultisamplefv(...) GLStats::glGetMultisamplefv(__VA_ARGS__)
+#define glSampleMaski(...) GLStats::glSampleMaski(__VA_ARGS__)
+#define glBindFragDataLocationIndexed(...) GLStats::glBindFragDataLocationIndexed(__VA_ARGS__)
+#define glGetFragDataIndex(...) GLStats::glGetFragDataIndex(__VA_ARGS__)
+#define glGenSamplers(...) GLStats::glGenSamplers(__VA_ARGS__)
+#define glDeleteSamplers(...) GLStats::glDeleteSamplers(__VA_ARGS__)
+#define glIsSampler(...) GLStats::glIsSampler(__VA_ARGS__)
+#define glBindSampler(...) GLStats::glBindSampler(__VA_ARGS__)
+#define glSamplerParameteri(...) GLStats::glSamplerParameteri(__VA_ARGS__)
+#define glSamplerParameteriv(...) GLStats::glSamplerParameteriv(__VA_ARGS__)
+#define glSamplerParameterf(...) GLStats::glSamplerParameterf(__VA_ARGS__)
+#define glSamplerParameterfv(...) GLStats::glSamplerParameterfv(__VA_ARGS__)
+#define glSamplerParameterIiv(...) GLStats::glSamplerParameterIiv(__VA_ARGS__)
+#define glSamplerParameterIuiv(...) GLStats::glSamplerParameterIuiv(__VA_ARGS__)
+#define glGetSamplerParameteriv(...) GLStats::glGetSamplerParameteriv(__VA_ARGS__)
+#define glGetSamplerParameterIiv(...) GLStats::glGetSamplerParameterIiv(__VA_ARGS__)
+#define glGetSamplerParameterfv(...) GLStats::glGetSamplerParameterfv(__VA_ARGS__)
+#define glGetSamplerParameterIuiv(...) GLStats::glGetSamplerParameterIuiv(__VA_ARGS__)
+#define glQueryCounter(...) GLStats::glQueryCounter(__VA_ARGS__)
+#define glGetQueryObjecti64v(...) GLStats::glGetQueryObjecti64v(__VA_ARGS__)
+#define glGetQueryObjectui64v(...) GLStats::glGetQueryObjectui64v(__VA_ARGS__)
+#define glVertexAttribDivisor(...) GLStats::glVertexAttribDivisor(__VA_ARGS__)
+#define glVertexAttribP1ui(...) GLStats::glVertexAttribP1ui(__VA_ARGS__)
+#define glVertexAttribP1uiv(...) GLStats::glVertexAttribP1uiv(__VA_ARGS__)
+#define glVertexAttribP2ui(...) GLStats::glVertexAttribP2ui(__VA_ARGS__)
+#define glVertexAttribP2uiv(...) GLStats::glVertexAttribP2uiv(__VA_ARGS__)
+#define glVertexAttribP3ui(...) GLStats::glVertexAttribP3ui(__VA_ARGS__)
+#define glVertexAttribP3uiv(...) GLStats::glVertexAttribP3uiv(__VA_ARGS__)
+#define glVertexAttribP4ui(...) GLStats::glVertexAttribP4ui(__VA_ARGS__)
+#define glVertexAttribP4uiv(...) GLStats::glVertexAttribP4uiv(__VA_ARGS__)
+
+#endif //ENABLE_GL_STATS
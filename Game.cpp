@@ -3,23 +3,28 @@
 #include "Game.hpp"
 
 #include "Connection.hpp"
+#include "read_write_message.hpp"
 
 #include <stdexcept>
 #include <iostream>
 #include <cstring>
+#include <cmath>
+#include <algorithm>
 
 #include <glm/gtx/norm.hpp>
 
-void Player::Controls::send_controls_message(Connection *connection_) const {
+void Player::Controls::send_controls_message(Connection *connection_, uint32_t tick) const {
 	assert(connection_);
 	auto &connection = *connection_;
 
-	uint32_t size = 8;
+	uint32_t size = 4 + 8;
 	connection.send(Message::C2S_Controls);
 	connection.send(uint8_t(size));
 	connection.send(uint8_t(size >> 8));
 	connection.send(uint8_t(size >> 16));
 
+	connection.send(tick);
+
 	auto send_button = [&](Button const &b) {
 		if (b.downs & 0x80) {
 			std::cerr << "Wow, you are really good at pressing buttons!" << std::endl;
@@ -35,7 +40,7 @@ void Player::Controls::send_controls_message(Connection *connection_) const {
 	}
 }
 
-bool Player::Controls::recv_controls_message(Connection *connection_) {
+bool Player::Controls::recv_controls_message(Connection *connection_, uint32_t *tick) {
 	assert(connection_);
 	auto &connection = *connection_;
 
@@ -47,7 +52,7 @@ bool Player::Controls::recv_controls_message(Connection *connection_) {
 	uint32_t size = (uint32_t(recv_buffer[3]) << 16)
 	              | (uint32_t(recv_buffer[2]) << 8)
 	              |  uint32_t(recv_buffer[1]);
-	if (size != 8) throw std::runtime_error("Controls message with size " + std::to_string(size) + " != 8!");
+	if (size != 4 + 8) throw std::runtime_error("Controls message with size " + std::to_string(size) + " != 12!");
 	
 	//expecting complete message:
 	if (recv_buffer.size() < 4 + size) return false;
@@ -62,11 +67,13 @@ bool Player::Controls::recv_controls_message(Connection *connection_) {
 		button->downs = uint8_t(d);
 	};
 
+	if (tick) std::memcpy(tick, &recv_buffer[4], sizeof(*tick));
+
 	for (size_t i = 0; i < left_buttons.size(); i++) {
-		recv_button(recv_buffer[4 + i], &left_buttons[i]);
+		recv_button(recv_buffer[4 + 4 + i], &left_buttons[i]);
 	}
 	for (size_t i = 0; i < right_buttons.size(); i++) {
-		recv_button(recv_buffer[4 + left_buttons.size() + i], &right_buttons[i]);
+		recv_button(recv_buffer[4 + 4 + left_buttons.size() + i], &right_buttons[i]);
 	}
 
 	//delete message from buffer:
@@ -78,64 +85,111 @@ bool Player::Controls::recv_controls_message(Connection *connection_) {
 
 //-----------------------------------------
 
-Game::Game() : mt(0x15466666) {
+Game::Game(uint32_t match_size) : mt(0x15466666) {
+	if (match_size < 2 || match_size > MaxPlayers) throw std::runtime_error("Match size " + std::to_string(match_size) + " is not in [2, " + std::to_string(MaxPlayers) + "].");
+	bary_score.assign(match_size, 1.f / float(match_size));
 }
 
-Player *Game::spawn_player() {
-	players.emplace_back();
+PlayerHandle Game::spawn_player() {
+	PlayerHandle handle = players.emplace();
 	Player &player = players.back();
 
-	player.index = (uint8_t)players.size() - 1;
+	//take the first empty seat:
+	player.index = 0;
+	while (seat(player.index)) ++player.index;
+	assert(uint32_t(player.index) < match_size() && "spawned more players than seats");
+	if (size_t(player.index) >= seats.size()) seats.resize(player.index + 1);
+	seats[player.index] = handle;
 
-	std::array<glm::u8vec4, 3> colors = {
-		glm::u8vec4(0xff, 0x00, 0x88, 0xff),
-		glm::u8vec4(0x00, 0xff, 0xee, 0xff),
-		glm::u8vec4(0xff, 0xbb, 0x00, 0xff)
-	};
-	player.color = colors[player.index];
+	player.color = seat_color(player.index);
+
+	return handle;
+}
+
+glm::u8vec4 Game::seat_color(int8_t index) {
+	static const std::array<glm::u8vec4, MaxPlayers> colors = [](){
+		std::array<glm::u8vec4, MaxPlayers> ret;
+		//the original three:
+		ret[0] = glm::u8vec4(0xff, 0x00, 0x88, 0xff);
+		ret[1] = glm::u8vec4(0x00, 0xff, 0xee, 0xff);
+		ret[2] = glm::u8vec4(0xff, 0xbb, 0x00, 0xff);
+		//everyone else gets a bright hue, spaced by the golden angle so neighbors differ:
+		auto channel = [](float x) { return uint8_t(std::clamp(x, 0.0f, 1.0f) * 255.0f); };
+		for (uint32_t i = 3; i < ret.size(); ++i) {
+			float hue = std::fmod(i * 0.381966f, 1.0f) * 6.0f;
+			ret[i] = glm::u8vec4(
+				channel(std::abs(hue - 3.0f) - 1.0f),
+				channel(2.0f - std::abs(hue - 2.0f)),
+				channel(2.0f - std::abs(hue - 4.0f)),
+				0xff
+			);
+		}
+		return ret;
+	}();
+	return colors[index % colors.size()];
+}
+
+void Game::remove_player(PlayerHandle handle) {
+	Player *player = players.get(handle);
+	assert(player);
+	seats[player->index] = PlayerHandle();
+	while (!seats.empty() && !players.contains(seats.back())) seats.pop_back();
+	players.erase(handle);
+}
+
+void Game::rebuild_seats() {
+	seats.clear();
+	for (size_t i = 0; i < players.size(); ++i) {
+		int8_t index = players[i].index;
+		if (index < 0) throw std::runtime_error("Player with negative seat index.");
+		if (size_t(index) >= seats.size()) seats.resize(index + 1);
+		if (players.contains(seats[index])) throw std::runtime_error("Two players in seat " + std::to_string(index) + ".");
+		seats[index] = players.handle_at(i);
+	}
+}
 
-	return &player;
+Hand Player::hand_for(std::array<Button, 4> const &buttons, float stamina) {
+	if (stamina <= 0) {
+		return Hand::None;
+	}
+	if (buttons[0].pressed && buttons[1].pressed && buttons[2].pressed && buttons[3].pressed) {
+		return Hand::Rock;
+	}
+	if (!buttons[0].pressed && !buttons[1].pressed && !buttons[2].pressed && !buttons[3].pressed) {
+		return Hand::Paper;
+	}
+	if (!buttons[0].pressed && !buttons[1].pressed && buttons[2].pressed && buttons[3].pressed) {
+		return Hand::Scissors;
+	}
+	return Hand::None;
 }
 
-void Game::remove_player(Player *player) {
-	bool found = false;
-	for (auto pi = players.begin(); pi != players.end(); ++pi) {
-		if (&*pi == player) {
-			players.erase(pi);
-			found = true;
-			break;
+void Player::update_stamina(float elapsed) {
+	// Expend stamina based on key presses
+	if (stamina > 0) {
+		for (size_t i = 0; i < controls.left_buttons.size(); i++) {
+			stamina -= controls.left_buttons[i].downs;
+		}
+		for (size_t i = 0; i < controls.right_buttons.size(); i++) {
+			stamina -= controls.right_buttons[i].downs;
 		}
 	}
-	assert(found);
+
+	// Recover stamina
+	stamina += stamina_recovery * elapsed;
+	stamina = std::min(stamina, max_stamina);
 }
 
 void Game::update(float elapsed) {
 	// Set hand state for all players
 	for (auto& p : players) {
-		// Helper to get the hand position for a given array of button presses
-		auto getHand = [&](std::array<Button, 4> buttons) -> Hand {
-			if (p.stamina <= 0) {
-				return Hand::None;
-			}
-			if (buttons[0].pressed && buttons[1].pressed && buttons[2].pressed && buttons[3].pressed) {
-				return Hand::Rock;
-			}
-			if (!buttons[0].pressed && !buttons[1].pressed && !buttons[2].pressed && !buttons[3].pressed) {
-				return Hand::Paper;
-			}
-			if (!buttons[0].pressed && !buttons[1].pressed && buttons[2].pressed && buttons[3].pressed) {
-				return Hand::Scissors;
-			}
-			return Hand::None;
-		};
-
-		// Set player hands
-		p.left_hand = getHand(p.controls.left_buttons);
-		p.right_hand = getHand(p.controls.right_buttons);
+		p.left_hand = Player::hand_for(p.controls.left_buttons, p.stamina);
+		p.right_hand = Player::hand_for(p.controls.right_buttons, p.stamina);
 	}
 
-	// Perform normal game updates only if there are three players and the game is not over
-	if (players.size() == 3 && !over) {
+	// Perform normal game updates only if every seat is filled and the game is not over
+	uint32_t const size = match_size();
+	if (players.size() == size && !over) {
 		for (auto& p : players) {
 			// Helper to determine whether hand 1 beats hand 2
 			auto winning = [](Hand h1, Hand h2) -> bool {
@@ -146,16 +200,8 @@ void Game::update(float elapsed) {
 			};
 
 			// Get pointers to the players on either side of this one
-			Player* left_player = nullptr;
-			Player* right_player = nullptr;
-			for (auto& p2 : players) {
-				if (p2.index == (int8_t)((players.size() + p.index - 1) % players.size())) {
-					left_player = &p2;
-				}
-				if (p2.index == (int8_t)((players.size() + p.index + 1) % players.size())) {
-					right_player = &p2;
-				}
-			}
+			Player* left_player = seat((int8_t)((size + p.index - 1) % size));
+			Player* right_player = seat((int8_t)((size + p.index + 1) % size));
 			assert(left_player != nullptr && right_player != nullptr && "Missing player");
 
 			// For each player that I'm beating, increase my barycentric score and decrease theirs
@@ -168,27 +214,15 @@ void Game::update(float elapsed) {
 				bary_score[right_player->index] -= elapsed * score_point_speed;
 			}
 
-			// Expend stamina based on key presses
-			if (p.stamina > 0) {
-				for (size_t i = 0; i < p.controls.left_buttons.size(); i++) {
-					p.stamina -= p.controls.left_buttons[i].downs;
-				}
-				for (size_t i = 0; i < p.controls.right_buttons.size(); i++) {
-					p.stamina -= p.controls.right_buttons[i].downs;
-				}
-			}
-
-			// Recover stamina
-			p.stamina += p.stamina_recovery * elapsed;
-			p.stamina = std::min(p.stamina, p.max_stamina);
+			p.update_stamina(elapsed);
 		}
 
-		// Check if the score point has left the triangle and the game is over
-		if (bary_score.x < 0 || bary_score.y < 0 || bary_score.z < 0) {
+		// Check if the score point has left the simplex and the game is over
+		if (*std::min_element(bary_score.begin(), bary_score.end()) < 0) {
 			// Find the winning player
 			float max_bary = 0;
 			int8_t win_index = 0;
-			for (int8_t i = 0; i < 3; i++) {
+			for (int8_t i = 0; i < int8_t(size); i++) {
 				if (bary_score[i] > max_bary) {
 					max_bary = bary_score[i];
 					win_index = i;
@@ -209,7 +243,7 @@ void Game::update(float elapsed) {
 		if (restart_timer > restart_duration) {
 			restart_timer = 0;
 			over = false;
-			bary_score = glm::vec3(1.f / 3.f, 1.f / 3.f, 1.f / 3.f);
+			bary_score.assign(size, 1.f / float(size));
 			for (auto& p : players) {
 				p.stamina = p.max_stamina;
 			}
@@ -229,34 +263,48 @@ void Game::update(float elapsed) {
 }
 
 
-void Game::send_state_message(Connection *connection_, Player *connection_player) const {
+void Game::send_state_message(Connection *connection_, Player const *connection_player, uint32_t tick, uint32_t input_tick, InputEcho const &echo) const {
 	assert(connection_);
-	auto &connection = *connection_;
+	send_state_message(&connection_->send_buffer, connection_player, tick, input_tick, echo);
+}
+
+void Game::send_state_message(std::vector< uint8_t > *to_, Player const *connection_player, uint32_t tick, uint32_t input_tick, InputEcho const &echo) const {
+	assert(to_);
+	auto &to = *to_;
+	auto send = [&](auto const &t) {
+		to.insert(to.end(), reinterpret_cast< uint8_t const * >(&t), reinterpret_cast< uint8_t const * >(&t) + sizeof(t));
+	};
 
-	connection.send(Message::S2C_State);
+	send(Message::S2C_State);
 	//will patch message size in later, for now placeholder bytes:
-	connection.send(uint8_t(0));
-	connection.send(uint8_t(0));
-	connection.send(uint8_t(0));
-	size_t mark = connection.send_buffer.size(); //keep track of this position in the buffer
+	send(uint8_t(0));
+	send(uint8_t(0));
+	send(uint8_t(0));
+	size_t mark = to.size(); //keep track of this position in the buffer
 
+	send(tick);
+	send(input_tick);
+	send(echo.tick);
+	send(echo.buffered);
+	send(echo.held);
 
-	connection.send(bary_score);
-	connection.send(over);
+	send(uint8_t(bary_score.size()));
+	for (float s : bary_score) send(s);
+	send(over);
 
 	//send player info helper:
 	auto send_player = [&](Player const &player) {
-		//connection.send(player.position);
-		connection.send(player.color);
-		connection.send(player.left_hand);
-		connection.send(player.right_hand);
-		connection.send(player.index);
-		connection.send(player.stamina);
-		connection.send(player.win);
+		//send(player.position);
+		send(player.color);
+		send(player.left_hand);
+		send(player.right_hand);
+		send(player.index);
+		send(player.stamina);
+		send(player.win);
 	};
 
 	//player count:
-	connection.send(uint8_t(players.size()));
+	send(uint8_t(players.size()));
 	if (connection_player) send_player(*connection_player);
 	for (auto const &player : players) {
 		if (&player == connection_player) continue;
@@ -264,13 +312,13 @@ void Game::send_state_message(Connection *connection_, Player *connection_player
 	}
 
 	//compute the message size and patch into the message header:
-	uint32_t size = uint32_t(connection.send_buffer.size() - mark);
-	connection.send_buffer[mark-3] = uint8_t(size);
-	connection.send_buffer[mark-2] = uint8_t(size >> 8);
-	connection.send_buffer[mark-1] = uint8_t(size >> 16);
+	uint32_t size = uint32_t(to.size() - mark);
+	to[mark-3] = uint8_t(size);
+	to[mark-2] = uint8_t(size >> 8);
+	to[mark-1] = uint8_t(size >> 16);
 }
 
-bool Game::recv_state_message(Connection *connection_) {
+bool Game::recv_state_message(Connection *connection_, uint32_t *tick_, uint32_t *input_tick_, InputEcho *echo_) {
 	assert(connection_);
 	auto &connection = *connection_;
 	auto &recv_buffer = connection.recv_buffer;
@@ -293,14 +341,29 @@ bool Game::recv_state_message(Connection *connection_) {
 		at += sizeof(*val);
 	};
 
-	read(&bary_score);
+	uint32_t tick, input_tick;
+	read(&tick);
+	read(&input_tick);
+	if (tick_) *tick_ = tick;
+	if (input_tick_) *input_tick_ = input_tick;
+	InputEcho echo;
+	read(&echo.tick);
+	read(&echo.buffered);
+	read(&echo.held);
+	if (echo_) *echo_ = echo;
+
+	uint8_t match_size;
+	read(&match_size);
+	if (match_size < 2 || match_size > MaxPlayers) throw std::runtime_error("Invalid match size in state message.");
+	bary_score.resize(match_size);
+	for (float &s : bary_score) read(&s);
 	read(&over);
 
 	players.clear();
 	uint8_t player_count;
 	read(&player_count);
 	for (uint8_t i = 0; i < player_count; ++i) {
-		players.emplace_back();
+		players.emplace();
 		Player &player = players.back();
 		read(&player.color);
 		read(&player.left_hand);
@@ -308,12 +371,151 @@ bool Game::recv_state_message(Connection *connection_) {
 		read(&player.index);
 		read(&player.stamina);
 		read(&player.win);
+		if (player.index < 0 || player.index >= int8_t(match_size)) throw std::runtime_error("Invalid seat in state message.");
 	}
 
 	if (at != size) throw std::runtime_error("Trailing data in state message.");
 
+	rebuild_seats();
+
 	//delete message from buffer:
 	recv_buffer.erase(recv_buffer.begin(), recv_buffer.begin() + 4 + size);
 
 	return true;
 }
+
+//-----------------------------------------
+
+void Game::save_checkpoint(std::vector< uint8_t > *to_) const {
+	assert(to_);
+	auto &to = *to_;
+	to.clear();
+
+	auto write = [&](auto const &val) {
+		to.insert(to.end(), reinterpret_cast< uint8_t const * >(&val), reinterpret_cast< uint8_t const * >(&val) + sizeof(val));
+	};
+
+	write(uint8_t(2)); //format version
+
+	write(uint8_t(bary_score.size()));
+	for (float s : bary_score) write(s);
+	write(score_point_speed);
+	write(over);
+	write(restart_timer);
+	write(restart_duration);
+	write(next_player_number);
+
+	//rng state, as raw words:
+	for (uint32_t word : mt.state) write(word);
+	write(mt.position);
+
+	write(uint8_t(players.size()));
+	for (auto const &player : players) {
+		write(player.index);
+		write(player.color);
+		write(uint8_t(player.left_hand));
+		write(uint8_t(player.right_hand));
+		write(player.stamina);
+		write(player.win);
+		//buttons in the same format as controls messages:
+		for (auto const &b : player.controls.left_buttons) write(uint8_t( (b.pressed ? 0x80 : 0x00) | (b.downs & 0x7f) ));
+		for (auto const &b : player.controls.right_buttons) write(uint8_t( (b.pressed ? 0x80 : 0x00) | (b.downs & 0x7f) ));
+	}
+}
+
+void Game::load_checkpoint(uint8_t const *data, size_t size) {
+	size_t at = 0;
+
+	//copy bytes from buffer and advance position:
+	auto read = [&](auto *val) {
+		if (at + sizeof(*val) > size) {
+			throw std::runtime_error("Ran out of bytes reading checkpoint.");
+		}
+		std::memcpy(val, data + at, sizeof(*val));
+		at += sizeof(*val);
+	};
+
+	uint8_t version;
+	read(&version);
+	if (version == 1) {
+		//(three-player matches only)
+		bary_score.resize(3);
+	} else if (version == 2) {
+		uint8_t match_size;
+		read(&match_size);
+		if (match_size < 2 || match_size > MaxPlayers) throw std::runtime_error("Invalid match size in checkpoint.");
+		bary_score.resize(match_size);
+	} else {
+		throw std::runtime_error("Unknown checkpoint version " + std::to_string(version) + ".");
+	}
+	for (float &s : bary_score) read(&s);
+	read(&score_point_speed);
+	read(&over);
+	read(&restart_timer);
+	read(&restart_duration);
+	read(&next_player_number);
+
+	//rng state:
+	for (uint32_t &word : mt.state) read(&word);
+	read(&mt.position);
+	if (mt.position > MT19937::N) throw std::runtime_error("Invalid rng state in checkpoint.");
+
+	players.clear();
+	uint8_t player_count;
+	read(&player_count);
+	for (uint8_t i = 0; i < player_count; ++i) {
+		players.emplace();
+		Player &player = players.back();
+		read(&player.index);
+		read(&player.color);
+		uint8_t left_hand, right_hand;
+		read(&left_hand);
+		read(&right_hand);
+		if (left_hand > Hand::Scissors || right_hand > Hand::Scissors) throw std::runtime_error("Invalid hand in checkpoint.");
+		player.left_hand = Hand(left_hand);
+		player.right_hand = Hand(right_hand);
+		read(&player.stamina);
+		read(&player.win);
+		auto read_button = [&](Button *button) {
+			uint8_t byte;
+			read(&byte);
+			button->pressed = (byte & 0x80);
+			button->downs = (byte & 0x7f);
+		};
+		for (auto &b : player.controls.left_buttons) read_button(&b);
+		for (auto &b : player.controls.right_buttons) read_button(&b);
+		if (player.index >= int8_t(bary_score.size())) throw std::runtime_error("Player seat outside of match in checkpoint.");
+	}
+
+	if (at != size) throw std::runtime_error("Trailing data in checkpoint.");
+
+	rebuild_seats();
+}
+
+//------ keepalive ------
+
+void send_ping_message(Connection *connection) {
+	assert(connection);
+	send_message_header(*connection, Message::S2C_Ping, 0);
+}
+
+bool recv_ping_message(Connection *connection) {
+	assert(connection);
+	uint32_t size;
+	if (!peek_message(*connection, Message::S2C_Ping, &size)) return false;
+	MessageReader(*connection, size, "ping").finish();
+	return true;
+}
+
+void send_pong_message(Connection *connection) {
+	assert(connection);
+	send_message_header(*connection, Message::C2S_Pong, 0);
+}
+
+bool recv_pong_message(Connection *connection) {
+	assert(connection);
+	uint32_t size;
+	if (!peek_message(*connection, Message::C2S_Pong, &size)) return false;
+	MessageReader(*connection, size, "pong").finish();
+	return true;
+}
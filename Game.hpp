@@ -1,9 +1,12 @@
 #pragma once
 
+#include "SlotMap.hpp"
+#include "MT19937.hpp"
+
 #include <glm/glm.hpp>
 
 #include <string>
-#include <list>
+#include <vector>
 #include <random>
 #include <array>
 
@@ -16,6 +19,17 @@ struct Connection;
 enum class Message : uint8_t {
 	C2S_Controls = 1, //Greg!
 	S2C_State = 's',
+	//match migration (see Migration.hpp):
+	S2S_Handoff = 'h',
+	S2S_HandoffAck = 'H',
+	S2C_Redirect = 'r',
+	C2S_Resume = 'R',
+	//lockstep mode (see Lockstep.hpp):
+	S2C_LockstepStart = 'L',
+	S2C_LockstepFrame = 'f',
+	//keepalive (sent when a connection goes quiet, see Connection::Timeouts):
+	S2C_Ping = 'p',
+	C2S_Pong = 'P',
 	//...
 };
 
@@ -41,40 +55,70 @@ struct Player {
 		std::array<Button, 4> right_buttons;
 		//Button l1, l2, l3, l4, l5, r1, r2, r3, r4, r5;
 
-		void send_controls_message(Connection *connection) const;
+		//controls are stamped with the client's tick counter (see InputBuffer.hpp):
+		void send_controls_message(Connection *connection, uint32_t tick = 0) const;
 
 		//returns 'false' if no message or not a controls message,
-		//returns 'true' if read a controls message,
+		//returns 'true' if read a controls message (adding its downs to these controls and storing its tick in *tick),
 		//throws on malformed controls message
-		bool recv_controls_message(Connection *connection);
+		bool recv_controls_message(Connection *connection, uint32_t *tick = nullptr);
 	} controls;
 
 	glm::u8vec4 color = glm::u8vec4(0x00, 0x00, 0x00, 0x00);
 	Hand left_hand = Hand::Paper;
 	Hand right_hand = Hand::Paper;
-	int8_t index;
-	const float max_stamina = 16;
-	const float stamina_recovery = 4;
+	int8_t index; //seat around the table
+	inline static constexpr float max_stamina = 16;
+	inline static constexpr float stamina_recovery = 4;
 	float stamina = max_stamina;
 	bool win = false;
+
+	//the rules for one player's hands and stamina, shared by Game::update and client-side prediction:
+	//hand shown for a set of held buttons (None when out of stamina):
+	static Hand hand_for(std::array<Button, 4> const &buttons, float stamina);
+	//spend stamina on this tick's presses (if any is left), then recover some:
+	void update_stamina(float elapsed);
 };
 
-struct Game {
-	std::list< Player > players; //(using list so they can have stable addresses)
-	Player *spawn_player(); //add player the end of the players list (may also, e.g., play some spawn anim)
-	void remove_player(Player *); //remove player from game (may also, e.g., play some despawn anim)
+typedef SlotMap< Player >::Handle PlayerHandle;
+
+//the newest input a state message reflects, and how long the server held on to it
+// (lets clients split their input latency into network and server time; see LatencyTrace.hpp):
+struct InputEcho {
+	static constexpr uint16_t Unknown = 0xffff;
+	uint32_t tick = 0; //client tick of the input
+	uint16_t buffered = Unknown; //from its arrival to the tick that played it (in units of 0.1ms)
+	uint16_t held = Unknown; //from that tick to the state message being sent (in units of 0.1ms)
+};
 
-	std::mt19937 mt; //used for spawning players
+struct Game {
+	SlotMap< Player > players; //(players move around in memory; hold on to them with PlayerHandles)
+	PlayerHandle spawn_player(); //add player the end of the players list (may also, e.g., play some spawn anim)
+	void remove_player(PlayerHandle); //remove player from game (may also, e.g., play some despawn anim)
+
+	//player in a given seat (Player::index), or nullptr if the seat is empty:
+	Player *seat(int8_t index) { return (index >= 0 && size_t(index) < seats.size()) ? players.get(seats[index]) : nullptr; }
+	Player const *seat(int8_t index) const { return (index >= 0 && size_t(index) < seats.size()) ? players.get(seats[index]) : nullptr; }
+	std::vector< PlayerHandle > seats; //indexed by Player::index
+	void rebuild_seats(); //(after replacing 'players' wholesale)
+	static glm::u8vec4 seat_color(int8_t index);
+
+	MT19937 mt; //used for spawning players (same sequence as std::mt19937, but with state checkpoints can copy directly)
 	uint32_t next_player_number = 1; //used for naming players
 
-	glm::vec3 bary_score = glm::vec3(1.f / 3.f, 1.f / 3.f, 1.f / 3.f);
+	//players sit in a ring and play against both neighbors; a match starts once every seat is full:
+	inline static constexpr uint32_t MaxPlayers = 64;
+	uint32_t match_size() const { return uint32_t(bary_score.size()); }
+
+	//score point, in barycentric coordinates (one per seat; the match ends when one goes negative):
+	std::vector< float > bary_score;
 	float score_point_speed = 0.3f;
 
 	bool over = false;
 	float restart_timer = 0;
 	float restart_duration = 3;
 
-	Game();
+	Game(uint32_t match_size = 3); //(throws if match_size isn't in [2, MaxPlayers])
 
 	//state update function:
 	void update(float elapsed);
@@ -100,10 +144,35 @@ struct Game {
 	//used by client:
 	//set game state from data in connection buffer
 	// (return true if data was read)
-	bool recv_state_message(Connection *connection);
+	//'tick' gets the server tick the state is from (see SnapshotBuffer.hpp),
+	//'input_tick' gets the first client tick whose controls are not yet reflected in the state,
+	//'echo' gets the server's timing for the newest controls that are:
+	bool recv_state_message(Connection *connection, uint32_t *tick = nullptr, uint32_t *input_tick = nullptr, InputEcho *echo = nullptr);
 
 	//used by server:
 	//send game state.
 	//  Will move "connection_player" to the front of the front of the sent list.
-	void send_state_message(Connection *connection, Player *connection_player = nullptr) const;
+	//  'tick' is the server's tick counter,
+	//  'input_tick' is the next of connection_player's client ticks the server will play (see InputBuffer.hpp),
+	//  'echo' is how long the server held the newest of those it has played.
+	void send_state_message(Connection *connection, Player const *connection_player = nullptr, uint32_t tick = 0, uint32_t input_tick = 0, InputEcho const &echo = InputEcho()) const;
+	//(the same message, appended to a plain buffer; e.g. to measure it without a Connection)
+	void send_state_message(std::vector< uint8_t > *to, Player const *connection_player = nullptr, uint32_t tick = 0, uint32_t input_tick = 0, InputEcho const &echo = InputEcho()) const;
+
+	//---- checkpoints ----
+	//compact binary snapshot of everything needed to continue the match elsewhere
+	// (scores, players and their held buttons, stamina, restart timer, rng state):
+	void save_checkpoint(std::vector< uint8_t > *to) const;
+	//replace current state with a checkpoint (throws on malformed data):
+	void load_checkpoint(std::vector< uint8_t > const &from) { load_checkpoint(from.data(), from.size()); }
+	void load_checkpoint(uint8_t const *data, size_t size);
 };
+
+//---- keepalive ----
+//the server pings a connection that has been quiet for Connection::Timeouts::keepalive seconds;
+// clients answer with a pong, which (like any other traffic) resets the server's read-idle deadline.
+//(both messages are empty; recv functions return false if a whole message of that type isn't at the front of the buffer)
+void send_ping_message(Connection *connection);
+bool recv_ping_message(Connection *connection);
+void send_pong_message(Connection *connection);
+bool recv_pong_message(Connection *connection);
@@ -0,0 +1,309 @@
+#include "GameBatch.hpp"
+
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+#include <cassert>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GAMEBATCH_SSE2
+#endif
+
+//----------------------------------------------
+//The update kernel is written once against a tiny "lanes" interface,
+// which is implemented for AVX (8 floats), SSE2 (4 floats), and plain scalar code.
+// F = a vector of floats, M = a vector of lane masks.
+
+namespace {
+
+#if defined(__AVX__)
+struct Lanes {
+	static constexpr size_t Width = 8;
+	static constexpr char const *Name = "AVX";
+	typedef __m256 F;
+	typedef __m256 M;
+	static F load(float const *p) { return _mm256_loadu_ps(p); }
+	static void store(float *p, F v) { _mm256_storeu_ps(p, v); }
+	static F set1(float v) { return _mm256_set1_ps(v); }
+	static F add(F a, F b) { return _mm256_add_ps(a, b); }
+	static F sub(F a, F b) { return _mm256_sub_ps(a, b); }
+	static F mul(F a, F b) { return _mm256_mul_ps(a, b); }
+	static F min(F a, F b) { return _mm256_min_ps(a, b); }
+	static M gt(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+	static M lt(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+	static M mask_load(uint32_t const *p) { return _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast< __m256i const * >(p))); }
+	static M mask_and(M a, M b) { return _mm256_and_ps(a, b); }
+	static M mask_or(M a, M b) { return _mm256_or_ps(a, b); }
+	static M mask_andnot(M a, M b) { return _mm256_andnot_ps(a, b); } //(!a && b)
+	static F select(M m, F a, F b) { return _mm256_blendv_ps(b, a, m); }
+	static uint32_t bits(M m) { return uint32_t(_mm256_movemask_ps(m)); }
+};
+#elif defined(GAMEBATCH_SSE2)
+struct Lanes {
+	static constexpr size_t Width = 4;
+	static constexpr char const *Name = "SSE2";
+	typedef __m128 F;
+	typedef __m128 M;
+	static F load(float const *p) { return _mm_loadu_ps(p); }
+	static void store(float *p, F v) { _mm_storeu_ps(p, v); }
+	static F set1(float v) { return _mm_set1_ps(v); }
+	static F add(F a, F b) { return _mm_add_ps(a, b); }
+	static F sub(F a, F b) { return _mm_sub_ps(a, b); }
+	static F mul(F a, F b) { return _mm_mul_ps(a, b); }
+	static F min(F a, F b) { return _mm_min_ps(a, b); }
+	static M gt(F a, F b) { return _mm_cmpgt_ps(a, b); }
+	static M lt(F a, F b) { return _mm_cmplt_ps(a, b); }
+	static M mask_load(uint32_t const *p) { return _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast< __m128i const * >(p))); }
+	static M mask_and(M a, M b) { return _mm_and_ps(a, b); }
+	static M mask_or(M a, M b) { return _mm_or_ps(a, b); }
+	static M mask_andnot(M a, M b) { return _mm_andnot_ps(a, b); } //(!a && b)
+	static F select(M m, F a, F b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+	static uint32_t bits(M m) { return uint32_t(_mm_movemask_ps(m)); }
+};
+#else
+struct Lanes {
+	static constexpr size_t Width = 1;
+	static constexpr char const *Name = "scalar";
+	typedef float F;
+	typedef bool M;
+	static F load(float const *p) { return *p; }
+	static void store(float *p, F v) { *p = v; }
+	static F set1(float v) { return v; }
+	static F add(F a, F b) { return a + b; }
+	static F sub(F a, F b) { return a - b; }
+	static F mul(F a, F b) { return a * b; }
+	static F min(F a, F b) { return std::min(a, b); }
+	static M gt(F a, F b) { return a > b; }
+	static M lt(F a, F b) { return a < b; }
+	static M mask_load(uint32_t const *p) { return *p != 0; }
+	static M mask_and(M a, M b) { return a && b; }
+	static M mask_or(M a, M b) { return a || b; }
+	static M mask_andnot(M a, M b) { return !a && b; }
+	static F select(M m, F a, F b) { return m ? a : b; }
+	static uint32_t bits(M m) { return m ? 1 : 0; }
+};
+#endif
+
+//hand for each 4-bit pressed mask (bit i = button i), as in Game::update's getHand:
+constexpr std::array< uint8_t, 16 > HandTable = []() {
+	std::array< uint8_t, 16 > table{};
+	for (auto &h : table) h = Hand::None;
+	table[0x0] = Hand::Paper; //no fingers down
+	table[0xf] = Hand::Rock; //all fingers down
+	table[0xc] = Hand::Scissors; //last two fingers down
+	return table;
+}();
+
+//1 if hand (row) beats neighboring hand (column), as in Game::update's winning:
+constexpr std::array< uint8_t, 16 > WinTable = []() {
+	std::array< uint8_t, 16 > table{};
+	for (uint32_t h1 = 0; h1 < 4; ++h1) {
+		for (uint32_t h2 = 0; h2 < 4; ++h2) {
+			table[h1 * 4 + h2] = (h2 == Hand::None)
+				|| (h1 == Hand::Rock && h2 == Hand::Scissors)
+				|| (h1 == Hand::Paper && h2 == Hand::Rock)
+				|| (h1 == Hand::Scissors && h2 == Hand::Paper);
+		}
+	}
+	return table;
+}();
+
+}
+
+char const *GameBatch::kernel() {
+	return Lanes::Name;
+}
+
+//----------------------------------------------
+
+GameBatch::GameBatch(size_t count_) {
+	resize(count_);
+}
+
+void GameBatch::resize(size_t count_) {
+	count = count_;
+	size_t padded = (count + Lanes::Width - 1) / Lanes::Width * Lanes::Width;
+
+	Game fresh;
+	for (uint32_t s = 0; s < Seats; ++s) {
+		score[s].resize(padded, fresh.bary_score[s]);
+		stamina[s].resize(padded, Player::max_stamina);
+		left_pressed[s].resize(padded, 0);
+		right_pressed[s].resize(padded, 0);
+		for (auto &d : downs[s]) d.resize(padded, 0.0f);
+		left_hand[s].resize(padded, Hand::Paper);
+		right_hand[s].resize(padded, Hand::Paper);
+		wins_left[s].resize(padded, 0.0f);
+		wins_right[s].resize(padded, 0.0f);
+	}
+	over.resize(padded, 0);
+	restart_timer.resize(padded, 0.0f);
+	win_index.resize(padded, -1);
+}
+
+void GameBatch::load(size_t game, Game const &from) {
+	assert(game < count);
+	if (from.match_size() != Seats || from.players.size() != Seats) throw std::runtime_error("GameBatch only holds three-player games.");
+	if (from.score_point_speed != score_point_speed || from.restart_duration != restart_duration) {
+		throw std::runtime_error("GameBatch games must share score_point_speed and restart_duration.");
+	}
+
+	win_index[game] = -1;
+	for (uint32_t s = 0; s < Seats; ++s) {
+		Player const *player = from.seat(int8_t(s));
+		if (!player) throw std::runtime_error("GameBatch games must have players in seats 0, 1, and 2.");
+		score[s][game] = from.bary_score[s];
+		stamina[s][game] = player->stamina;
+		left_hand[s][game] = uint8_t(player->left_hand);
+		right_hand[s][game] = uint8_t(player->right_hand);
+		if (player->win) win_index[game] = int8_t(s);
+		for (auto &d : downs[s]) d[game] = 0.0f;
+		set_controls(game, s, player->controls);
+	}
+	over[game] = from.over ? ~0U : 0U;
+	restart_timer[game] = from.restart_timer;
+}
+
+void GameBatch::store(size_t game, Game *to) const {
+	assert(game < count);
+	assert(to);
+	to->bary_score.resize(Seats);
+	for (uint32_t s = 0; s < Seats; ++s) {
+		to->bary_score[s] = score[s][game];
+	}
+	to->over = (over[game] != 0);
+	to->restart_timer = restart_timer[game];
+	for (uint32_t s = 0; s < Seats; ++s) {
+		Player *player = to->seat(int8_t(s));
+		assert(player && "GameBatch::store needs players in seats 0, 1, 2");
+		player->stamina = stamina[s][game];
+		player->left_hand = Hand(left_hand[s][game]);
+		player->right_hand = Hand(right_hand[s][game]);
+		player->win = (win_index[game] == int8_t(s));
+		for (uint32_t b = 0; b < 4; ++b) {
+			player->controls.left_buttons[b].pressed = (left_pressed[s][game] >> b) & 1;
+			player->controls.left_buttons[b].downs = uint8_t(downs[s][b][game]);
+			player->controls.right_buttons[b].pressed = (right_pressed[s][game] >> b) & 1;
+			player->controls.right_buttons[b].downs = uint8_t(downs[s][4 + b][game]);
+		}
+	}
+}
+
+void GameBatch::set_controls(size_t game, uint32_t seat, Player::Controls const &controls) {
+	assert(game < count && seat < Seats);
+	uint8_t left = 0, right = 0;
+	for (uint32_t b = 0; b < 4; ++b) {
+		left |= uint8_t(controls.left_buttons[b].pressed) << b;
+		right |= uint8_t(controls.right_buttons[b].pressed) << b;
+		downs[seat][b][game] = std::min(255.0f, downs[seat][b][game] + controls.left_buttons[b].downs);
+		downs[seat][4 + b][game] = std::min(255.0f, downs[seat][4 + b][game] + controls.right_buttons[b].downs);
+	}
+	left_pressed[seat][game] = left;
+	right_pressed[seat][game] = right;
+}
+
+void GameBatch::update(float elapsed) {
+	size_t padded = over.size();
+
+	//hands (from stamina before this update), and who beats whom:
+	for (uint32_t s = 0; s < Seats; ++s) {
+		for (size_t g = 0; g < padded; ++g) {
+			bool rested = stamina[s][g] > 0;
+			left_hand[s][g] = rested ? HandTable[left_pressed[s][g]] : uint8_t(Hand::None);
+			right_hand[s][g] = rested ? HandTable[right_pressed[s][g]] : uint8_t(Hand::None);
+		}
+	}
+	for (uint32_t s = 0; s < Seats; ++s) {
+		uint32_t l = (s + Seats - 1) % Seats;
+		uint32_t r = (s + 1) % Seats;
+		for (size_t g = 0; g < padded; ++g) {
+			float playing = over[g] ? 0.0f : 1.0f;
+			wins_left[s][g] = playing * WinTable[left_hand[s][g] * 4 + right_hand[l][g]];
+			wins_right[s][g] = playing * WinTable[right_hand[s][g] * 4 + left_hand[r][g]];
+		}
+	}
+
+	typedef Lanes L;
+	L::F const score_step = L::set1(elapsed * score_point_speed);
+	L::F const zero = L::set1(0.0f);
+	L::F const recovery = L::set1(Player::stamina_recovery * elapsed);
+	L::F const max_stamina = L::set1(Player::max_stamina);
+	L::F const step = L::set1(elapsed);
+	L::F const duration = L::set1(restart_duration);
+
+	for (size_t g = 0; g < padded; g += L::Width) {
+		L::M ended = L::mask_load(&over[g]);
+
+		//scores (games that are over have no wins, so they don't change):
+		// (same order of operations as Game::update, so rounding matches)
+		L::F s[Seats];
+		for (uint32_t i = 0; i < Seats; ++i) s[i] = L::load(&score[i][g]);
+		for (uint32_t i = 0; i < Seats; ++i) {
+			uint32_t l = (i + Seats - 1) % Seats;
+			uint32_t r = (i + 1) % Seats;
+			L::F dl = L::mul(score_step, L::load(&wins_left[i][g]));
+			s[i] = L::add(s[i], dl);
+			s[l] = L::sub(s[l], dl);
+			L::F dr = L::mul(score_step, L::load(&wins_right[i][g]));
+			s[i] = L::add(s[i], dr);
+			s[r] = L::sub(s[r], dr);
+		}
+		for (uint32_t i = 0; i < Seats; ++i) L::store(&score[i][g], s[i]);
+
+		//stamina: spend on presses (if any left), then recover:
+		for (uint32_t i = 0; i < Seats; ++i) {
+			L::F st = L::load(&stamina[i][g]);
+			L::F spent = st;
+			for (uint32_t b = 0; b < Buttons; ++b) {
+				spent = L::sub(spent, L::load(&downs[i][b][g]));
+			}
+			st = L::select(L::gt(st, zero), spent, st);
+			st = L::min(L::add(st, recovery), max_stamina);
+			L::store(&stamina[i][g], L::select(ended, L::load(&stamina[i][g]), st));
+		}
+
+		//games that just ended (rare, so handled one at a time):
+		L::M left_triangle = L::mask_or(L::mask_or(L::lt(s[0], zero), L::lt(s[1], zero)), L::lt(s[2], zero));
+		if (uint32_t lanes = L::bits(L::mask_andnot(ended, left_triangle))) {
+			for (uint32_t lane = 0; lane < L::Width; ++lane) {
+				if (!(lanes & (1 << lane))) continue;
+				size_t game = g + lane;
+				float max_bary = 0;
+				int8_t win = 0;
+				for (uint32_t i = 0; i < Seats; ++i) {
+					if (score[i][game] > max_bary) {
+						max_bary = score[i][game];
+						win = int8_t(i);
+					}
+				}
+				win_index[game] = win;
+				over[game] = ~0U;
+			}
+		}
+
+		//games that were already over count down to a restart:
+		L::F timer = L::load(&restart_timer[g]);
+		timer = L::select(ended, L::add(timer, step), timer);
+		L::store(&restart_timer[g], timer);
+		if (uint32_t lanes = L::bits(L::mask_and(ended, L::gt(timer, duration)))) {
+			for (uint32_t lane = 0; lane < L::Width; ++lane) {
+				if (!(lanes & (1 << lane))) continue;
+				size_t game = g + lane;
+				restart_timer[game] = 0.0f;
+				over[game] = 0;
+				for (uint32_t i = 0; i < Seats; ++i) {
+					score[i][game] = 1.f / 3.f;
+					stamina[i][game] = Player::max_stamina;
+				}
+			}
+		}
+	}
+
+	//controls have been handled:
+	for (auto &seat : downs) {
+		for (auto &d : seat) std::fill(d.begin(), d.end(), 0.0f);
+	}
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+/*
+ * GameBatch holds many three-player matches in structure-of-arrays form and
+ * updates them all at once, for servers hosting lots of matches.
+ *
+ * GameBatch batch(count);
+ * batch.load(i, game); //copy state in from a Game (players must be in seats 0, 1, 2)
+ * ...
+ * batch.set_controls(i, seat, controls); //deliver inputs
+ * batch.update(Game::Tick);
+ * ...
+ * batch.store(i, &game); //copy state back out
+ *
+ * update() does the same arithmetic, in the same order, as Game::update on a
+ * game whose players are listed in seat order, so results match bit-for-bit.
+ *
+ * Hands are resolved with a lookup table on each hand's 4-bit pressed mask;
+ * scores and stamina are updated 8 (AVX) or 4 (SSE2) matches at a time.
+ */
+
+#include "Game.hpp"
+
+#include <vector>
+#include <array>
+#include <cstdint>
+
+struct GameBatch {
+	static constexpr uint32_t Seats = 3;
+	static constexpr uint32_t Buttons = 8; //(4 per hand)
+
+	GameBatch(size_t count = 0);
+
+	void resize(size_t count); //new matches start in the same state as a new Game with three players
+	size_t size() const { return count; }
+
+	void load(size_t game, Game const &from); //(throws if 'from' isn't a three-player game with this batch's constants)
+	void store(size_t game, Game *to) const; //(to must have players in seats 0, 1, 2)
+
+	//latest controls for a player (downs accumulate until the next update, as on the server):
+	void set_controls(size_t game, uint32_t seat, Player::Controls const &controls);
+
+	void update(float elapsed);
+
+	//which update kernel this build uses ("AVX", "SSE2", or "scalar"):
+	static char const *kernel();
+
+	//shared by all matches in the batch:
+	float score_point_speed = Game().score_point_speed;
+	float restart_duration = Game().restart_duration;
+
+	//----- per-match state -----
+	// (arrays are padded to a multiple of the SIMD width; padding lanes are never read back)
+	size_t count = 0;
+	std::array< std::vector< float >, Seats > score; //bary_score component for each seat
+	std::array< std::vector< float >, Seats > stamina;
+	std::vector< uint32_t > over; //0 or ~0 (so it can be loaded directly as a SIMD mask)
+	std::vector< float > restart_timer;
+	std::vector< int8_t > win_index; //(valid when over)
+
+	//inputs:
+	std::array< std::vector< uint8_t >, Seats > left_pressed, right_pressed; //bit i = button i held
+	std::array< std::array< std::vector< float >, Buttons >, Seats > downs; //(float so they can be subtracted from stamina directly)
+
+	//outputs of the hand lookup:
+	std::array< std::vector< uint8_t >, Seats > left_hand, right_hand;
+
+	//scratch: 1.0f where a hand beats its neighbor this tick, 0.0f otherwise:
+	std::array< std::vector< float >, Seats > wins_left, wins_right;
+};
@@ -0,0 +1,106 @@
+#include "InputBuffer.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+//apply one tick's worth of controls on top of 'into' (downs accumulate until the next update):
+static void merge_controls(Player::Controls *into, Player::Controls const &from, bool pressed) {
+	auto merge = [pressed](std::array< Button, 4 > &to, std::array< Button, 4 > const &buttons) {
+		for (size_t i = 0; i < to.size(); ++i) {
+			if (pressed) to[i].pressed = buttons[i].pressed;
+			to[i].downs = uint8_t(std::min(255, int(to[i].downs) + int(buttons[i].downs)));
+		}
+	};
+	merge(into->left_buttons, from.left_buttons);
+	merge(into->right_buttons, from.right_buttons);
+}
+
+void InputBuffer::push(uint32_t client_tick, Player::Controls const &controls, uint32_t server_tick, Clock::time_point arrived) {
+	int64_t offset = int64_t(server_tick) - int64_t(client_tick);
+
+	if (started && client_tick >= next + Slots) {
+		//client's clock jumped way ahead (or it reset); start over:
+		started = false;
+		for (auto &slot : slots) slot.full = false;
+	}
+	if (!started) {
+		started = true;
+		next = client_tick;
+		offset_min = offset_min_prev = offset;
+		jitter_peak = jitter_peak_prev = 0;
+		window_start = server_tick;
+	}
+
+	//arrival statistics, over the current and previous window:
+	if (server_tick - window_start >= WindowTicks) {
+		offset_min_prev = offset_min;
+		offset_min = offset;
+		jitter_peak_prev = jitter_peak;
+		jitter_peak = 0;
+		window_start = server_tick;
+	}
+	offset_min = std::min(offset_min, offset);
+	uint32_t jitter = uint32_t(offset - std::min(offset_min, offset_min_prev));
+	jitter_peak = std::max(jitter_peak, jitter);
+	max_jitter = std::max(max_jitter, jitter);
+	depth = std::min(MaxDepth, std::max(jitter_peak, jitter_peak_prev));
+
+	if (client_tick < next) {
+		//too late to play at its tick; keep its presses for the next one:
+		late += 1;
+		merge_controls(&carry, controls, false);
+		return;
+	}
+
+	Slot &slot = slots[client_tick % Slots];
+	if (slot.full && slot.tick == client_tick) {
+		//(several messages in one client tick)
+		merge_controls(&slot.controls, controls, true);
+	} else {
+		slot.full = true;
+		slot.tick = client_tick;
+		slot.controls = controls;
+		slot.arrived = arrived;
+	}
+}
+
+void InputBuffer::pop(uint32_t server_tick, Player::Controls *controls, Clock::time_point now) {
+	assert(controls);
+	if (!started) return;
+
+	merge_controls(controls, carry, false);
+	carry = Player::Controls();
+
+	//client tick due now:
+	int64_t due = int64_t(server_tick) - std::min(offset_min, offset_min_prev) - int64_t(depth);
+	if (due - int64_t(next) >= int64_t(Slots)) {
+		//(fell far behind, e.g. after a long pause; skip to the present)
+		next = uint32_t(due - Slots + 1);
+	}
+
+	uint32_t played = 0;
+	while (int64_t(next) <= due) {
+		Slot &slot = slots[next % Slots];
+		if (slot.full && slot.tick == next) {
+			merge_controls(controls, slot.controls, true);
+			slot.full = false;
+			last_played.any = true;
+			last_played.tick = next;
+			last_played.arrived = slot.arrived;
+			last_played.applied = now;
+		} else if (int64_t(next) == due) {
+			starved += 1;
+		}
+		next += 1;
+		played += 1;
+	}
+	if (played > 1) merged += played - 1;
+}
+
+uint32_t InputBuffer::buffered() const {
+	uint32_t count = 0;
+	for (auto const &slot : slots) {
+		if (slot.full && slot.tick >= next) count += 1;
+	}
+	return count;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+/*
+ * InputBuffer is the server's per-player jitter buffer.
+ *
+ * Clients stamp every controls message with their own tick counter. Rather
+ * than applying controls the moment they arrive (so network jitter decides
+ * which tick they land on, and a burst of messages collapses into one tick),
+ * the server files them by client tick and plays them back one client tick per
+ * server tick, a few ticks behind the newest arrivals:
+ *
+ *  InputBuffer buffer;
+ *  buffer.push(client_tick, controls, server_tick); //as messages arrive
+ *  buffer.pop(server_tick, &player.controls); //once per server tick, before Game::update
+ *
+ * Playback runs 'depth' ticks behind the fastest arrivals seen recently. The
+ * depth adapts to the observed jitter: it grows (by skipping a tick of playback)
+ * right away when inputs arrive later than that, and shrinks (by merging two
+ * ticks into one) once the network has been calm for a while.
+ *
+ * Inputs that arrive after their tick has already been played are counted as
+ * late; their presses are carried into the next tick rather than dropped.
+ *
+ * If given arrival and playback times, the buffer also remembers how long the
+ * newest played input waited (echoed to the client for latency reports).
+ */
+
+#include "Game.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+struct InputBuffer {
+	static constexpr uint32_t Slots = 64; //ticks of input that can be held
+	static constexpr uint32_t MaxDepth = 10; //(1/3 second at 30Hz)
+	static constexpr uint32_t WindowTicks = 300; //how long arrival statistics are remembered
+
+	using Clock = std::chrono::steady_clock;
+
+	//file controls the client meant for 'client_tick' (arriving during 'server_tick', at time 'arrived'):
+	void push(uint32_t client_tick, Player::Controls const &controls, uint32_t server_tick, Clock::time_point arrived = Clock::time_point());
+
+	//play back the controls for 'server_tick' (at time 'now'): sets pressed state and adds downs to 'controls'
+	// (if no input is due this tick, buttons stay as they were):
+	void pop(uint32_t server_tick, Player::Controls *controls, Clock::time_point now = Clock::time_point());
+
+	//newest input played so far:
+	struct Played {
+		bool any = false;
+		uint32_t tick = 0; //client tick
+		Clock::time_point arrived; //(as passed to push)
+		Clock::time_point applied; //(as passed to pop)
+	} last_played;
+
+	uint32_t depth = 1; //ticks of buffering (adapted from jitter)
+	uint32_t buffered() const; //inputs waiting to be played
+
+	//stats (since construction; see reset_stats):
+	uint32_t late = 0; //inputs that arrived after their tick was played
+	uint32_t merged = 0; //ticks played together with the next one (when catching up)
+	uint32_t starved = 0; //ticks where the input due hadn't arrived
+	uint32_t max_jitter = 0; //largest lateness (in ticks) relative to the fastest arrivals
+	void reset_stats() { late = merged = starved = max_jitter = 0; }
+
+	//---- internals ----
+	struct Slot {
+		bool full = false;
+		uint32_t tick = 0;
+		Player::Controls controls;
+		Clock::time_point arrived; //(of the first message for this tick)
+	};
+	std::array< Slot, Slots > slots; //indexed by client tick % Slots
+
+	bool started = false;
+	uint32_t next = 0; //next client tick to play
+
+	//server_tick - client_tick of the fastest arrival, over the last one or two windows
+	// (so the estimate can recover if the client's clock drifts):
+	int64_t offset_min = 0, offset_min_prev = 0;
+	uint32_t jitter_peak = 0, jitter_peak_prev = 0; //(largest lateness in each window)
+	uint32_t window_start = 0;
+
+	Player::Controls carry; //downs from late inputs, applied next pop
+};
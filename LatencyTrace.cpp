@@ -0,0 +1,122 @@
+#include "LatencyTrace.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+std::array< char const *, LatencyTrace::StageCount > const LatencyTrace::StageNames{{
+	"input", "batching", "network", "server buffer", "server hold", "display", "total", "predicted"
+}};
+
+void LatencyTrace::add(Stage stage, Clock::duration duration) {
+	Samples &s = samples[stage];
+	float seconds = std::max(0.0f, std::chrono::duration< float >(duration).count());
+	if (s.seconds.size() < MaxSamples) s.seconds.emplace_back(seconds);
+	else s.seconds[s.added % MaxSamples] = seconds;
+	s.added += 1;
+}
+
+void LatencyTrace::key(Clock::time_point at) {
+	if (!unsent) unsent = at;
+	undrawn.emplace_back(at);
+}
+
+void LatencyTrace::sent(uint32_t tick, Clock::time_point at) {
+	//(the server times a tick's input from its first message)
+	Send &send = sends[tick % sends.size()];
+	if (!send.valid || send.tick != tick) {
+		send.tick = tick;
+		send.valid = true;
+		send.at = at;
+	}
+
+	if (!unsent) return;
+	add(Input, at - *unsent);
+	in_flight.emplace_back(InFlight{ tick, *unsent, at });
+	unsent.reset();
+	if (in_flight.size() > MaxInFlight) in_flight.pop_front();
+}
+
+void LatencyTrace::state(uint32_t input_tick, InputEcho const &echo, Clock::time_point at) {
+	if (in_flight.empty() || in_flight.front().tick >= input_tick) return;
+
+	//server's timing for the newest input in this state, and when we sent it:
+	Send const &send = sends[echo.tick % sends.size()];
+	bool timed = echo.buffered != InputEcho::Unknown && echo.held != InputEcho::Unknown
+		&& send.valid && send.tick == echo.tick && echo.tick < input_tick;
+	auto units = [](uint16_t u) { //(0.1ms units)
+		return std::chrono::duration_cast< Clock::duration >(std::chrono::microseconds(uint32_t(u) * 100));
+	};
+
+	while (!in_flight.empty() && in_flight.front().tick < input_tick) {
+		InFlight const &press = in_flight.front();
+		if (timed) {
+			add(Batching, send.at - press.sent);
+			add(Network, (at - send.at) - units(echo.buffered) - units(echo.held));
+			add(ServerBuffer, units(echo.buffered));
+			add(ServerHold, units(echo.held));
+		}
+		arrived.emplace_back(Arrived{ press.pressed, at });
+		in_flight.pop_front();
+	}
+}
+
+void LatencyTrace::drawn(Clock::time_point at) {
+	for (auto const &pressed : undrawn) {
+		add(Predicted, at - pressed);
+	}
+	undrawn.clear();
+
+	for (auto const &a : arrived) {
+		add(Display, at - a.received);
+		add(Total, at - a.pressed);
+	}
+	arrived.clear();
+}
+
+LatencyTrace::Summary LatencyTrace::summary(Stage stage) const {
+	Summary ret;
+	std::vector< float > sorted = samples[stage].seconds;
+	if (sorted.empty()) return ret;
+	std::sort(sorted.begin(), sorted.end());
+	auto percentile = [&](double p) {
+		return sorted[std::min< size_t >(sorted.size() - 1, size_t(p * sorted.size()))];
+	};
+	ret.count = uint32_t(sorted.size());
+	ret.p50 = percentile(0.50);
+	ret.p95 = percentile(0.95);
+	ret.p99 = percentile(0.99);
+	ret.max = sorted.back();
+	return ret;
+}
+
+std::string LatencyTrace::report() const {
+	std::ostringstream out;
+	out << std::left << std::setw(16) << "input latency" << std::right
+		<< std::setw(8) << "count" << std::setw(9) << "p50 ms" << std::setw(9) << "p95 ms"
+		<< std::setw(9) << "p99 ms" << std::setw(9) << "max ms" << "\n";
+	out << std::fixed << std::setprecision(2);
+	for (uint32_t s = 0; s < StageCount; ++s) {
+		Summary sum = summary(Stage(s));
+		out << "  " << std::left << std::setw(14) << StageNames[s] << std::right
+			<< std::setw(8) << sum.count << std::setw(9) << (sum.p50 * 1000.0f) << std::setw(9) << (sum.p95 * 1000.0f)
+			<< std::setw(9) << (sum.p99 * 1000.0f) << std::setw(9) << (sum.max * 1000.0f) << "\n";
+	}
+	return out.str();
+}
+
+void LatencyTrace::write_json(std::ostream &out) const {
+	out << "{\"stages\":[\n";
+	out << std::fixed << std::setprecision(3);
+	for (uint32_t s = 0; s < StageCount; ++s) {
+		Summary sum = summary(Stage(s));
+		out << "\t{\"name\":\"" << StageNames[s] << "\""
+			<< ",\"count\":" << sum.count
+			<< ",\"p50_ms\":" << (sum.p50 * 1000.0f)
+			<< ",\"p95_ms\":" << (sum.p95 * 1000.0f)
+			<< ",\"p99_ms\":" << (sum.p99 * 1000.0f)
+			<< ",\"max_ms\":" << (sum.max * 1000.0f) << "}"
+			<< (s + 1 < StageCount ? ",\n" : "\n");
+	}
+	out << "]}\n";
+}
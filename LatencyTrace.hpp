@@ -0,0 +1,115 @@
+#pragma once
+
+/*
+ * LatencyTrace follows key presses from the moment the client handles them to
+ * the first frame drawn from a server state that includes them, and keeps the
+ * time spent in each stage along the way:
+ *
+ *  LatencyTrace trace;
+ *  trace.key(); //in handle_event, on a (non-repeat) key down
+ *  trace.sent(tick); //after send_controls_message for 'tick'
+ *  trace.state(input_tick, echo); //after recv_state_message
+ *  trace.drawn(); //at the end of draw
+ *  std::cout << trace.report();
+ *
+ * Presses are identified by the client tick their controls message was sent
+ * for; a state message reflects every tick before its 'input_tick'. The server
+ * echoes how long it held the newest of those inputs (see InputEcho in
+ * Game.hpp), which splits the round trip into network and server time. Those
+ * timings are for the newest input in the state, which may have been sent a
+ * little after the press itself; that gap is the 'batching' stage.
+ *
+ * Stages (all in seconds):
+ *  Input -- key handled to controls sent
+ *  Batching -- to the newest input in the same state message being sent
+ *  Network -- round trip, less the time the server held the input (including
+ *    waits for either side's next socket poll)
+ *  ServerBuffer -- waiting in the server's InputBuffer for its tick
+ *  ServerHold -- from that tick to the state message being sent
+ *  Display -- state received to the end of the next draw
+ *  Total -- key handled to the end of the first draw that includes the server's response
+ *  Predicted -- key handled to the end of the next draw (what client-side prediction shows)
+ *
+ * Time spent in SDL's event queue before handle_event, and from the end of
+ * draw to the frame actually being scanned out, is not included.
+ */
+
+#include "Game.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+struct LatencyTrace {
+	using Clock = std::chrono::steady_clock;
+
+	enum Stage : uint32_t {
+		Input,
+		Batching,
+		Network,
+		ServerBuffer,
+		ServerHold,
+		Display,
+		Total,
+		Predicted,
+		StageCount
+	};
+	static std::array< char const *, StageCount > const StageNames;
+
+	static constexpr size_t MaxSamples = 4096; //per stage (older samples are replaced)
+	static constexpr size_t MaxInFlight = 256; //presses waiting on the server (older ones are dropped)
+
+	void key(Clock::time_point at = Clock::now());
+	void sent(uint32_t tick, Clock::time_point at = Clock::now());
+	void state(uint32_t input_tick, InputEcho const &echo, Clock::time_point at = Clock::now());
+	void drawn(Clock::time_point at = Clock::now());
+
+	struct Summary {
+		uint32_t count = 0;
+		float p50 = 0.0f, p95 = 0.0f, p99 = 0.0f, max = 0.0f; //seconds
+	};
+	Summary summary(Stage stage) const;
+
+	//table of every stage's percentiles, in milliseconds:
+	std::string report() const;
+	//the same, as JSON:
+	void write_json(std::ostream &out) const;
+
+	//---- internals ----
+	void add(Stage stage, Clock::duration duration);
+
+	struct Samples {
+		std::vector< float > seconds; //(ring once full)
+		uint64_t added = 0;
+	};
+	std::array< Samples, StageCount > samples;
+
+	std::optional< Clock::time_point > unsent; //earliest press not yet sent
+	std::vector< Clock::time_point > undrawn; //presses not yet drawn at all
+
+	//first send time for each recent tick (ring, by tick):
+	struct Send {
+		uint32_t tick = 0;
+		bool valid = false;
+		Clock::time_point at;
+	};
+	std::array< Send, 256 > sends;
+
+	//presses sent but not yet reflected in a state message:
+	struct InFlight {
+		uint32_t tick = 0;
+		Clock::time_point pressed, sent;
+	};
+	std::deque< InFlight > in_flight;
+
+	//presses reflected in a state message, waiting to be drawn:
+	struct Arrived {
+		Clock::time_point pressed, received;
+	};
+	std::vector< Arrived > arrived;
+};
@@ -1,31 +1,47 @@
 #include "Load.hpp"
+#include "LoadProfile.hpp"
+#include "FlightRecorder.hpp"
 
 #include <array>
 #include <list>
+#include <string>
 #include <cassert>
 
 namespace {
-	std::array< std::list< std::function< void() > >, MaxLoadTag > &get_load_lists() {
-		static std::array< std::list< std::function< void() > >, MaxLoadTag > load_lists;
+	struct LoadFunction {
+		std::function< void() > fn;
+		std::source_location where;
+	};
+	std::array< std::list< LoadFunction >, MaxLoadTag > &get_load_lists() {
+		static std::array< std::list< LoadFunction >, MaxLoadTag > load_lists;
 		return load_lists;
 	}
+	std::array< char const *, MaxLoadTag > const TagNames{{ "load (early)", "load", "load (late)" }};
 }
 
-void add_load_function(LoadTag tag, std::function< void() > const &fn) {
+void add_load_function(LoadTag tag, std::function< void() > const &fn, std::source_location where) {
 	auto &load_lists = get_load_lists();
 	assert(tag < load_lists.size());
-	load_lists[tag].emplace_back(fn);
+	load_lists[tag].emplace_back(LoadFunction{ fn, where });
 }
 
 void call_load_functions() {
-	static bool has_been_called = false;
+	[[maybe_unused]] static bool has_been_called = false; //(only checked in debug builds)
 	assert(!has_been_called && "call_load_functions should only be called *once*");
 	has_been_called = true;
 
+	//event names ("load Foo.cpp:12"), kept for good since recorded events point to them:
+	static auto *labels = new std::list< std::string >;
+
 	auto &load_lists = get_load_lists();
-	for (auto &fn_list : load_lists) {
+	for (uint32_t tag = 0; tag < load_lists.size(); ++tag) {
+		auto &fn_list = load_lists[tag];
 		while (!fn_list.empty()) {
-			(*fn_list.begin())(); //call first function in the list
+			std::source_location const &where = fn_list.begin()->where;
+			char const *label = labels->emplace_back("load " + std::string(where.file_name()) + ":" + std::to_string(where.line())).c_str();
+			RECORD_SCOPE(label);
+			LoadProfile::Scope profile(TagNames[tag], where);
+			fn_list.begin()->fn(); //call first function in the list
 			fn_list.pop_front(); //remove from list
 		}
 	}
@@ -16,6 +16,7 @@
  * }
  *
  * Load<> is built on the add_load_function() call that adds a function to one of several lists of functions that are called after the OpenGL canvas is initialized.
+ * Each call is timed (along with its disk reads and GL uploads) under the source location that added it; see LoadProfile.hpp.
  *
  * These functions are grouped by 'tags', which allow some sequencing of calls.
  * (particularly, this is useful for loading large data blobs [e.g. Meshes] before looking up individual elements within them.)
@@ -23,6 +24,7 @@
  */
 
 #include <functional>
+#include <source_location>
 #include <stdexcept>
 
 enum LoadTag : uint32_t {
@@ -34,7 +36,7 @@ enum LoadTag : uint32_t {
 
 //Add a function to an internal list of loading functions:
 // (only call *before* "call_load_functions()")
-void add_load_function(LoadTag tag, std::function< void() > const &fn);
+void add_load_function(LoadTag tag, std::function< void() > const &fn, std::source_location where = std::source_location::current());
 
 //Call all loading functions:
 // (loading functions may throw exceptions if they fail.)
@@ -49,13 +51,13 @@ T const *new_T() { return new T; }
 template< typename T >
 struct Load {
 	//Constructing a Load< T > adds the passed function to the list of functions to call:
-	Load(LoadTag tag, const std::function< T const *() > &load_fn = new_T< T >) : value(nullptr) {
+	Load(LoadTag tag, const std::function< T const *() > &load_fn = new_T< T >, std::source_location where = std::source_location::current()) : value(nullptr) {
 		add_load_function(tag, [this,load_fn](){
 			this->value = load_fn();
 			if (!(this->value)) {
 				throw std::runtime_error("Loading failed.");
 			}
-		});
+		}, where);
 	}
 
 	//Make a "Load< T >" behave like a "T const *":
@@ -73,8 +75,8 @@ struct Load {
 template< >
 struct Load< void > {
 	//Constructing a Load< T > adds the passed function to the list of functions to call:
-	Load( LoadTag tag, const std::function< void() > &load_fn) {
-		add_load_function(tag, load_fn);
+	Load( LoadTag tag, const std::function< void() > &load_fn, std::source_location where = std::source_location::current()) {
+		add_load_function(tag, load_fn, where);
 	}
 };
 
@@ -0,0 +1,139 @@
+#include "LoadProfile.hpp"
+
+#include "GL.hpp"
+#include "write_json.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+	std::vector< LoadProfile::Entry > recorded;
+	std::vector< size_t > open_scopes; //indices into 'recorded'
+
+	//running totals (entries take the difference from when they began):
+	uint64_t read_total = 0;
+	uint64_t upload_total = 0; //(only counted by hand without GL stats)
+	struct Begun {
+		uint64_t read_total, upload_total;
+	};
+	std::vector< Begun > begun; //(parallel to 'recorded')
+
+	uint64_t uploads_so_far() {
+		#ifdef ENABLE_GL_STATS
+		//the GL wrappers count every upload (this assumes GLStats::end_frame() isn't called mid-scope, which startup doesn't do):
+		return GLStats::current.upload_bytes;
+		#else
+		return upload_total;
+		#endif
+	}
+}
+
+void LoadProfile::read_file(std::string const &path) {
+	std::error_code ec;
+	uintmax_t size = std::filesystem::file_size(path, ec);
+	if (!ec) read(size_t(size));
+}
+
+void LoadProfile::read(size_t bytes) {
+	read_total += bytes;
+}
+
+void LoadProfile::uploaded(size_t bytes) {
+	upload_total += bytes;
+}
+
+LoadProfile::Scope::Scope(std::string const &name, std::source_location where) : index(recorded.size()) {
+	Entry entry;
+	entry.name = name;
+	entry.where = std::string(where.file_name()) + ":" + std::to_string(where.line());
+	entry.depth = uint32_t(open_scopes.size());
+	entry.parent = (open_scopes.empty() ? Entry::NoParent : open_scopes.back());
+	recorded.emplace_back(std::move(entry));
+	begun.emplace_back(Begun{ read_total, uploads_so_far() });
+	open_scopes.emplace_back(index);
+	recorded.back().begin = Clock::now(); //(last, so the bookkeeping isn't timed)
+}
+
+void LoadProfile::Scope::finish() {
+	if (finished) return;
+	finished = true;
+	Entry &entry = recorded[index];
+	entry.end = Clock::now();
+	entry.read_bytes = read_total - begun[index].read_total;
+	entry.upload_bytes = std::max(uploads_so_far(), begun[index].upload_total) - begun[index].upload_total;
+	auto open = std::find(open_scopes.begin(), open_scopes.end(), index); //(usually the last one)
+	if (open != open_scopes.end()) open_scopes.erase(open);
+}
+
+std::vector< LoadProfile::Entry > const &LoadProfile::entries() {
+	return recorded;
+}
+
+std::string LoadProfile::report() {
+	auto ms = [](Clock::duration d) { return std::chrono::duration< double, std::milli >(d).count(); };
+
+	//children of each entry (and the top-level entries), slowest first:
+	std::vector< std::vector< size_t > > children(recorded.size());
+	std::vector< size_t > top;
+	for (size_t i = 0; i < recorded.size(); ++i) {
+		(recorded[i].parent == Entry::NoParent ? top : children[recorded[i].parent]).emplace_back(i);
+	}
+	auto slowest_first = [](std::vector< size_t > &list) {
+		std::stable_sort(list.begin(), list.end(), [](size_t a, size_t b) {
+			return (recorded[a].end - recorded[a].begin) > (recorded[b].end - recorded[b].begin);
+		});
+	};
+
+	std::ostringstream out;
+	out << std::left << std::setw(34) << "startup" << std::right
+		<< std::setw(10) << "ms" << std::setw(12) << "read KiB" << std::setw(12) << "upload KiB" << "  where\n";
+	out << std::fixed << std::setprecision(1);
+
+	//each entry, followed by its children (indented):
+	std::function< void(size_t) > print = [&](size_t i) {
+		Entry const &entry = recorded[i];
+		std::string name = std::string(2 + 2 * entry.depth, ' ') + entry.name;
+		out << std::left << std::setw(34) << name << std::right
+			<< std::setw(10) << ms(entry.end - entry.begin)
+			<< std::setw(12) << (entry.read_bytes / 1024.0)
+			<< std::setw(12) << (entry.upload_bytes / 1024.0)
+			<< "  " << entry.where << "\n";
+		slowest_first(children[i]);
+		for (size_t c : children[i]) print(c);
+	};
+
+	double total_ms = 0.0;
+	uint64_t total_read = 0, total_upload = 0;
+	slowest_first(top);
+	for (size_t i : top) {
+		print(i);
+		total_ms += ms(recorded[i].end - recorded[i].begin);
+		total_read += recorded[i].read_bytes;
+		total_upload += recorded[i].upload_bytes;
+	}
+	out << std::left << std::setw(34) << "  total" << std::right
+		<< std::setw(10) << total_ms << std::setw(12) << (total_read / 1024.0) << std::setw(12) << (total_upload / 1024.0) << "\n";
+	return out.str();
+}
+
+bool LoadProfile::write_trace(std::string const &path) {
+	std::ofstream out(path, std::ios::binary);
+	if (!out) return false;
+
+	auto us = [](Clock::duration d) { return std::chrono::duration< double, std::micro >(d).count(); };
+
+	Clock::time_point origin = (recorded.empty() ? Clock::time_point() : recorded[0].begin);
+	ChromeTraceWriter trace(out);
+	for (auto const &entry : recorded) {
+		std::string args = "\"where\":" + json_string(entry.where)
+			+ ",\"read_bytes\":" + std::to_string(entry.read_bytes)
+			+ ",\"upload_bytes\":" + std::to_string(entry.upload_bytes);
+		trace.complete(entry.name, 1, us(entry.begin - origin), us(entry.end - entry.begin), "startup", args);
+	}
+	trace.finish();
+	return bool(out);
+}
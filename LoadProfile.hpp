@@ -0,0 +1,70 @@
+#pragma once
+
+/*
+ * LoadProfile times the work done at startup -- every Load< T > function (see
+ * Load.hpp) plus any other scopes marked with LoadProfile::Scope -- along with
+ * the bytes each one read from disk and uploaded to OpenGL:
+ *
+ *  LoadProfile::Scope glyphs("glyph tiles"); //(times until destroyed or finish())
+ *  LoadProfile::read_file(path); //in file loaders: counts the file's size as read
+ *  LoadProfile::uploaded(bytes); //next to glBufferData / glTexImage2D calls (see below)
+ *
+ *  std::cout << LoadProfile::report(); //slowest first
+ *  LoadProfile::write_trace("startup.json"); //Chrome trace (chrome://tracing or https://ui.perfetto.dev)
+ *
+ * Each entry keeps the source location it came from (the Load< T > declaration,
+ * for load functions). Byte counts are inclusive of nested scopes, and count
+ * whole files when they're opened, which is what the loaders here read anyway
+ * (FreeType reads its font lazily, so that's an estimate).
+ *
+ * In builds with ENABLE_GL_STATS, uploads are taken from the GL call wrappers
+ * (see make-GL.py), which see every upload, and uploaded() is ignored.
+ * Otherwise only the uploads marked with uploaded() are counted.
+ *
+ * Scopes are cheap, but they're kept forever; they're meant for startup, not
+ * every frame. Only time the main thread with them.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <source_location>
+#include <string>
+#include <vector>
+
+namespace LoadProfile {
+	using Clock = std::chrono::steady_clock;
+
+	void read_file(std::string const &path);
+	void read(size_t bytes);
+	void uploaded(size_t bytes);
+
+	struct Scope {
+		explicit Scope(std::string const &name, std::source_location where = std::source_location::current());
+		~Scope() { finish(); }
+		Scope(Scope const &) = delete;
+		Scope &operator=(Scope const &) = delete;
+
+		void finish(); //(only the first call counts)
+
+		size_t index; //into entries()
+		bool finished = false;
+	};
+
+	struct Entry {
+		std::string name;
+		std::string where; //file:line
+		uint32_t depth = 0; //scopes open around this one
+		static constexpr size_t NoParent = size_t(-1);
+		size_t parent = NoParent; //innermost of those (index into entries())
+		Clock::time_point begin, end;
+		uint64_t read_bytes = 0;
+		uint64_t upload_bytes = 0;
+	};
+	std::vector< Entry > const &entries();
+
+	//table of top-level entries, slowest first, each followed by its nested entries (indented), with totals:
+	std::string report();
+	//entries as Chrome trace events; returns false if the file couldn't be written:
+	bool write_trace(std::string const &path);
+}
@@ -0,0 +1,195 @@
+#include "Lockstep.hpp"
+
+#include "read_write_message.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <cassert>
+
+LockstepGame::Input LockstepGame::input_from(Player::Controls const &controls) {
+	Input input;
+	uint32_t downs = 0;
+	for (uint32_t b = 0; b < 4; ++b) {
+		if (controls.left_buttons[b].pressed) input.pressed |= uint8_t(1 << b);
+		if (controls.right_buttons[b].pressed) input.pressed |= uint8_t(1 << (4 + b));
+		downs += controls.left_buttons[b].downs + controls.right_buttons[b].downs;
+	}
+	input.downs = uint8_t(std::min(downs, 255U));
+	return input;
+}
+
+void LockstepGame::join(uint32_t seat) {
+	assert(seat < Seats);
+	present |= uint8_t(1 << seat);
+	stamina[seat] = MaxStamina;
+	left_hand[seat] = right_hand[seat] = Hand::Paper;
+}
+
+void LockstepGame::leave(uint32_t seat) {
+	assert(seat < Seats);
+	present &= uint8_t(~(1 << seat));
+}
+
+void LockstepGame::update(Inputs const &inputs) {
+	//same rules as Game::update, in integer arithmetic:
+
+	//hand for each 4-bit pressed mask:
+	auto get_hand = [](uint32_t mask) -> uint8_t {
+		if (mask == 0xf) return Hand::Rock;
+		if (mask == 0x0) return Hand::Paper;
+		if (mask == 0xc) return Hand::Scissors;
+		return Hand::None;
+	};
+	for (uint32_t s = 0; s < Seats; ++s) {
+		if (!(present & (1 << s))) continue;
+		bool rested = stamina[s] > 0;
+		left_hand[s] = rested ? get_hand(inputs[s].pressed & 0xf) : uint8_t(Hand::None);
+		right_hand[s] = rested ? get_hand(inputs[s].pressed >> 4) : uint8_t(Hand::None);
+	}
+
+	if (present == (1 << Seats) - 1 && !over) {
+		auto winning = [](uint8_t h1, uint8_t h2) -> bool {
+			return h2 == Hand::None ||
+			      (h1 == Hand::Rock && h2 == Hand::Scissors) ||
+			      (h1 == Hand::Paper && h2 == Hand::Rock) ||
+			      (h1 == Hand::Scissors && h2 == Hand::Paper);
+		};
+		for (uint32_t s = 0; s < Seats; ++s) {
+			uint32_t l = (s + Seats - 1) % Seats;
+			uint32_t r = (s + 1) % Seats;
+			if (winning(left_hand[s], right_hand[l])) {
+				score[s] += ScoreStep;
+				score[l] -= ScoreStep;
+			}
+			if (winning(right_hand[s], left_hand[r])) {
+				score[s] += ScoreStep;
+				score[r] -= ScoreStep;
+			}
+			if (stamina[s] > 0) stamina[s] -= Fixed(inputs[s].downs) * One;
+			stamina[s] = std::min(stamina[s] + StaminaRecovery, MaxStamina);
+		}
+
+		if (score[0] < 0 || score[1] < 0 || score[2] < 0) {
+			Fixed max_score = 0;
+			win_index = 0;
+			for (uint32_t s = 0; s < Seats; ++s) {
+				if (score[s] > max_score) {
+					max_score = score[s];
+					win_index = int8_t(s);
+				}
+			}
+			over = 1;
+		}
+	} else if (over) {
+		restart_ticks += 1;
+		if (restart_ticks > RestartTicks) {
+			restart_ticks = 0;
+			over = 0;
+			score = {One / 3, One / 3, One / 3};
+			stamina = {MaxStamina, MaxStamina, MaxStamina};
+		}
+	}
+
+	tick += 1;
+}
+
+uint32_t LockstepGame::hash() const {
+	uint32_t h = 0x811c9dc5;
+	auto mix = [&h](auto const &val) {
+		uint8_t const *bytes = reinterpret_cast< uint8_t const * >(&val);
+		for (size_t i = 0; i < sizeof(val); ++i) {
+			h ^= bytes[i];
+			h *= 0x01000193;
+		}
+	};
+	for_each_field(*this, mix);
+	return h;
+}
+
+void LockstepGame::to_game(Game *game, int8_t local_seat) const {
+	assert(game);
+	game->bary_score.resize(Seats);
+	for (uint32_t s = 0; s < Seats; ++s) {
+		game->bary_score[s] = score[s] / float(One);
+	}
+	game->over = (over != 0);
+	game->restart_timer = restart_ticks * Game::Tick;
+
+	game->players.clear();
+	auto add_player = [&](uint32_t s) {
+		game->players.emplace();
+		Player &player = game->players.back();
+		player.index = int8_t(s);
+		player.color = Game::seat_color(player.index);
+		player.stamina = stamina[s] / float(One);
+		player.left_hand = Hand(left_hand[s]);
+		player.right_hand = Hand(right_hand[s]);
+		player.win = (win_index == int8_t(s));
+	};
+	if (local_seat >= 0 && uint32_t(local_seat) < Seats && (present & (1 << local_seat))) add_player(local_seat);
+	for (uint32_t s = 0; s < Seats; ++s) {
+		if ((present & (1 << s)) && int8_t(s) != local_seat) add_player(s);
+	}
+	game->rebuild_seats();
+}
+
+//-----------------------------------------
+
+void send_lockstep_start_message(Connection *connection_, LockstepGame const &game, int8_t seat) {
+	assert(connection_);
+	auto &connection = *connection_;
+
+	send_message_header(connection, Message::S2C_LockstepStart, LockstepGame::SerializedSize + 1);
+	LockstepGame::for_each_field(game, [&](auto const &field){ connection.send(field); });
+	connection.send(seat);
+}
+
+bool recv_lockstep_start_message(Connection *connection_, LockstepGame *game, int8_t *seat) {
+	assert(connection_);
+	assert(game);
+	assert(seat);
+	auto &connection = *connection_;
+
+	uint32_t size;
+	if (!peek_message(connection, Message::S2C_LockstepStart, &size)) return false;
+	if (size != LockstepGame::SerializedSize + 1) throw std::runtime_error("Lockstep start message with size " + std::to_string(size) + " != " + std::to_string(LockstepGame::SerializedSize + 1) + "!");
+	MessageReader reader(connection, size, "lockstep start");
+	LockstepGame::for_each_field(*game, [&](auto &field){ reader.read(&field); });
+	reader.read(seat);
+	if (game->present >= (1 << LockstepGame::Seats)) throw std::runtime_error("Invalid seats in lockstep start message.");
+	//(the seat indexes per-seat arrays on the client, so it must be in range and actually occupied)
+	if (*seat < 0 || *seat >= int8_t(LockstepGame::Seats) || !(game->present & (1 << *seat))) throw std::runtime_error("Invalid seat in lockstep start message.");
+	reader.finish();
+	return true;
+}
+
+void send_lockstep_frame_message(Connection *connection_, LockstepFrame const &frame) {
+	assert(connection_);
+	auto &connection = *connection_;
+
+	send_message_header(connection, Message::S2C_LockstepFrame, 4 + 2 * LockstepGame::Seats + 4);
+	connection.send(frame.tick);
+	for (auto const &input : frame.inputs) {
+		connection.send(input.pressed);
+		connection.send(input.downs);
+	}
+	connection.send(frame.hash);
+}
+
+bool recv_lockstep_frame_message(Connection *connection_, LockstepFrame *frame) {
+	assert(connection_);
+	assert(frame);
+	auto &connection = *connection_;
+
+	uint32_t size;
+	if (!peek_message(connection, Message::S2C_LockstepFrame, &size)) return false;
+	MessageReader reader(connection, size, "lockstep frame");
+	reader.read(&frame->tick);
+	for (auto &input : frame->inputs) {
+		reader.read(&input.pressed);
+		reader.read(&input.downs);
+	}
+	reader.read(&frame->hash);
+	reader.finish();
+	return true;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+/*
+ * Deterministic lockstep mode.
+ *
+ * LockstepGame is a fixed-point (Q16.16) version of Game's rules. It uses only
+ * integer arithmetic, so every machine that applies the same inputs computes
+ * exactly the same state, and it is plain data (memcpy-able).
+ *
+ * In lockstep mode (./server <port> --lockstep) the server never sends state:
+ *  - S2C_LockstepStart [LockstepGame, your seat] is sent whenever the set of players changes;
+ *  - S2C_LockstepFrame [tick, one 2-byte input per seat, state hash] is sent every tick.
+ * Clients apply each frame with LockstepGame::update and compare the result's
+ * hash() with the server's to detect desyncs.
+ */
+
+#include "Game.hpp"
+
+#include <array>
+#include <cstdint>
+
+struct Connection;
+
+struct LockstepGame {
+	typedef int32_t Fixed; //Q16.16
+	static constexpr int32_t One = 1 << 16;
+	static constexpr uint32_t Seats = 3;
+
+	//per-tick rule constants (Game's per-second values at Game::Tick = 1/30 s):
+	static constexpr Fixed ScoreStep = 655; //0.3 / 30
+	static constexpr Fixed MaxStamina = 16 * One; //Player::max_stamina
+	static constexpr Fixed StaminaRecovery = 8738; //4 / 30
+	static constexpr uint32_t RestartTicks = 90; //3 seconds
+
+	//one player's input for one tick:
+	struct Input {
+		uint8_t pressed = 0; //bits 0-3: left buttons, bits 4-7: right buttons
+		uint8_t downs = 0; //total presses since the last tick (saturating)
+		bool operator==(Input const &) const = default;
+	};
+	typedef std::array< Input, Seats > Inputs;
+	static Input input_from(Player::Controls const &controls);
+
+	uint32_t tick = 0; //number of updates so far
+	uint8_t present = 0; //bit s set if seat s is occupied
+	uint8_t over = 0;
+	int8_t win_index = -1; //(-1 until someone wins)
+	uint32_t restart_ticks = 0;
+	std::array< Fixed, Seats > score = {One / 3, One / 3, One / 3};
+	std::array< Fixed, Seats > stamina = {MaxStamina, MaxStamina, MaxStamina};
+	std::array< uint8_t, Seats > left_hand = {Hand::Paper, Hand::Paper, Hand::Paper};
+	std::array< uint8_t, Seats > right_hand = {Hand::Paper, Hand::Paper, Hand::Paper};
+
+	void join(uint32_t seat); //(new players start rested)
+	void leave(uint32_t seat);
+
+	//advance one tick (inputs for empty seats are ignored):
+	void update(Inputs const &inputs);
+
+	//32-bit FNV-1a of the whole state:
+	uint32_t hash() const;
+
+	//call f(field) on every field, in a fixed order (used for hashing and serialization):
+	template< typename Self, typename F >
+	static void for_each_field(Self &self, F &&f) {
+		f(self.tick);
+		f(self.present);
+		f(self.over);
+		f(self.win_index);
+		f(self.restart_ticks);
+		for (uint32_t s = 0; s < Seats; ++s) {
+			f(self.score[s]);
+			f(self.stamina[s]);
+			f(self.left_hand[s]);
+			f(self.right_hand[s]);
+		}
+	}
+	static constexpr uint32_t SerializedSize = 4 + 1 + 1 + 1 + 4 + Seats * (4 + 4 + 1 + 1);
+
+	//copy into a Game for drawing (local_seat, if present, becomes players.front()):
+	void to_game(Game *game, int8_t local_seat) const;
+};
+
+struct LockstepFrame {
+	uint32_t tick = 0; //tick these inputs are applied on (== LockstepGame::tick before the update)
+	LockstepGame::Inputs inputs;
+	uint32_t hash = 0; //LockstepGame::hash() after the update
+};
+
+//"send" functions append to connection->send_buffer;
+//"recv" functions consume a message and return true, or return false if there isn't a whole one
+// of that type at the front of connection->recv_buffer (and throw on malformed messages).
+void send_lockstep_start_message(Connection *connection, LockstepGame const &game, int8_t seat);
+bool recv_lockstep_start_message(Connection *connection, LockstepGame *game, int8_t *seat);
+
+void send_lockstep_frame_message(Connection *connection, LockstepFrame const &frame);
+bool recv_lockstep_frame_message(Connection *connection, LockstepFrame *frame);
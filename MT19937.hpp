@@ -0,0 +1,58 @@
+#pragma once
+
+/*
+ * MT19937 is a Mersenne Twister that produces the same sequence as std::mt19937,
+ * but keeps its state where code can read and write it directly.
+ * (std::mt19937 only exposes its state as text, which is slow to save and restore.)
+ *
+ * MT19937 mt(seed);
+ * uint32_t r = mt();
+ * ...
+ * //state is mt.state (the 624 words of the current block) and mt.position (next word to temper):
+ * write(mt.state); write(mt.position);
+ *
+ * (the state/position layout is the same one libstdc++ prints for std::mt19937,
+ *  so checkpoints written with either can be read with either)
+ */
+
+#include <array>
+#include <cstdint>
+
+struct MT19937 {
+	typedef uint32_t result_type;
+	static constexpr uint32_t N = 624; //words of state
+	static constexpr uint32_t M = 397; //twist offset
+
+	explicit MT19937(uint32_t seed = 5489u) {
+		state[0] = seed;
+		for (uint32_t i = 1; i < N; ++i) {
+			state[i] = 1812433253u * (state[i-1] ^ (state[i-1] >> 30)) + i;
+		}
+		position = N;
+	}
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return 0xffffffffu; }
+
+	result_type operator()() {
+		if (position >= N) twist();
+		uint32_t y = state[position++];
+		y ^= (y >> 11);
+		y ^= (y << 7) & 0x9d2c5680u;
+		y ^= (y << 15) & 0xefc60000u;
+		y ^= (y >> 18);
+		return y;
+	}
+
+	std::array< uint32_t, N > state;
+	uint32_t position; //index of the next state word to use (N: time to twist)
+
+	//generate the next block of state:
+	void twist() {
+		for (uint32_t k = 0; k < N; ++k) {
+			uint32_t y = (state[k] & 0x80000000u) | (state[(k + 1) % N] & 0x7fffffffu);
+			state[k] = state[(k + M) % N] ^ (y >> 1) ^ ((y & 1u) ? 0x9908b0dfu : 0u);
+		}
+		position = 0;
+	}
+};
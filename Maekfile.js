@@ -102,6 +102,21 @@ if (maek.OS === "windows") {
 		`-L${NEST_LIBS}/freetype/lib`, `-lfreetype`
 	);
 }
+//build with 'RELEASE=1 node Maekfile.js' to leave out debug checks (asserts, GL_ERRORS(), and the OpenGL debug context):
+if (process.env.RELEASE) {
+	maek.options.CPPFlags.push(maek.OS === "windows" ? `/DNDEBUG` : `-DNDEBUG`);
+}
+
+//build with 'TRACE=1 node Maekfile.js' to compile in trace-event timers (see Trace.hpp):
+if (process.env.TRACE) {
+	maek.options.CPPFlags.push(maek.OS === "windows" ? `/DENABLE_TRACE` : `-DENABLE_TRACE`);
+}
+
+//build with 'GL_STATS=1 node Maekfile.js' to count (and time some) OpenGL calls each frame (see make-GL.py; shown in the F2 overlay):
+if (process.env.GL_STATS) {
+	maek.options.CPPFlags.push(maek.OS === "windows" ? `/DENABLE_GL_STATS` : `-DENABLE_GL_STATS`);
+}
+
 //use COPY to copy a file
 // 'COPY(from, to)'
 // from: file to copy from
@@ -136,22 +151,61 @@ if (maek.OS === 'windows') {
 // cppFile: name of c++ file to compile
 // objFileBase (optional): base name object file to produce (if not supplied, set to options.objDir + '/' + cppFile without the extension)
 //returns objFile: objFileBase + a platform-dependant suffix ('.o' or '.obj')
+
+//audio (also used by the microbenchmarks):
+const sound_names = [
+	maek.CPP('Sound.cpp'),
+	maek.CPP('load_wav.cpp'),
+	maek.CPP('load_opus.cpp')
+];
+
+//input latency tracing (shared by the client and the latency probe):
+const latency_trace_obj = maek.CPP('LatencyTrace.cpp');
+
+//snapshot interpolation (shared by the client and the migration test):
+const snapshot_buffer_obj = maek.CPP('SnapshotBuffer.cpp');
+
 const client_names = [
 	maek.CPP('client.cpp'),
 	maek.CPP('PlayMode.cpp'),
+	snapshot_buffer_obj,
+	maek.CPP('FrameStats.cpp'),
+	latency_trace_obj,
 	maek.CPP('LitColorTextureProgram.cpp'),
 	//maek.CPP('ColorTextureProgram.cpp'),  //not used right now, but you might want it
-	maek.CPP('Sound.cpp'),
-	maek.CPP('load_wav.cpp'),
-	maek.CPP('load_opus.cpp')
+	...sound_names
 ];
 
 const server_names = [
 	maek.CPP('server.cpp')
 ];
 
-const common_names = [
+//networking (also used by the benchmarks):
+const connection_names = [
+	maek.CPP('Connection.cpp'),
+	maek.CPP('Metrics.cpp'),
+	maek.CPP('Memory.cpp'),
+	maek.CPP('Trace.cpp'),
+	maek.CPP('FlightRecorder.cpp'),
+	maek.CPP('write_json.cpp'),
+	maek.CPP('TimingWheel.cpp'),
+	maek.CPP('ConnectionTask.cpp'),
+	maek.CPP('Migration.cpp')
+];
+
+//simulation (no networking or SDL needed):
+const game_names = [
 	maek.CPP('Game.cpp'),
+	maek.CPP('GameBatch.cpp'),
+	maek.CPP('Replay.cpp'),
+	maek.CPP('InputBuffer.cpp'),
+	maek.CPP('Lockstep.cpp'),
+	maek.CPP('Rollback.cpp')
+];
+
+const common_names = [
+	...game_names,
+	...connection_names,
 	maek.CPP('data_path.cpp'),
 	maek.CPP('PathFont.cpp'),
 	maek.CPP('PathFont-font.cpp'),
@@ -161,10 +215,11 @@ const common_names = [
 	maek.CPP('Mesh.cpp'),
 	maek.CPP('load_save_png.cpp'),
 	maek.CPP('gl_compile_program.cpp'),
+	maek.CPP('gl_debug_output.cpp'),
 	maek.CPP('Mode.cpp'),
 	maek.CPP('GL.cpp'),
 	maek.CPP('Load.cpp'),
-	maek.CPP('Connection.cpp'),
+	maek.CPP('LoadProfile.cpp'),
 	maek.CPP('hex_dump.cpp')
 ];
 
@@ -189,8 +244,21 @@ const server_exe = maek.LINK([...server_names, ...common_names], 'dist/server');
 const show_meshes_exe = maek.LINK([...show_meshes_names, ...common_names], 'scenes/show-meshes');
 const show_scene_exe = maek.LINK([...show_scene_names, ...common_names], 'scenes/show-scene');
 
+//benchmarks (not built by default):
+const count_allocations_obj = maek.CPP('count_allocations.cpp'); //(replaces operator new to count heap allocations)
+const dispatch_bench_exe = maek.LINK([maek.CPP('dispatch-bench.cpp'), ...game_names, ...connection_names], 'dist/dispatch-bench', { LINKLibs: [] }); //(headless)
+const replay_player_exe = maek.LINK([maek.CPP('replay-player.cpp'), ...game_names], 'dist/replay-player', { LINKLibs: [] }); //(headless)
+const bench_exe = maek.LINK([maek.CPP('bench.cpp'), count_allocations_obj, ...sound_names, ...common_names], 'dist/bench');
+const sim_bench_exe = maek.LINK([maek.CPP('sim-bench.cpp'), count_allocations_obj, ...game_names], 'dist/sim-bench', { LINKLibs: [] }); //(headless: no libraries needed)
+const latency_probe_exe = maek.LINK([maek.CPP('latency-probe.cpp'), latency_trace_obj, ...game_names, ...connection_names], 'dist/latency-probe', { LINKLibs: [] }); //(headless)
+
+//tests (not built by default; each exits with a nonzero status if any check fails):
+const timing_wheel_test_exe = maek.LINK([maek.CPP('timing-wheel-test.cpp'), ...game_names, ...connection_names], 'dist/timing-wheel-test', { LINKLibs: [] }); //(headless)
+const connection_task_test_exe = maek.LINK([maek.CPP('connection-task-test.cpp'), ...game_names, ...connection_names], 'dist/connection-task-test', { LINKLibs: [] }); //(headless; listens on localhost:15479)
+const migration_test_exe = maek.LINK([maek.CPP('migration-test.cpp'), snapshot_buffer_obj, ...game_names, ...connection_names], 'dist/migration-test', { LINKLibs: [] }); //(headless)
+
 //set the default target to the game (and copy the readme files):
-maek.TARGETS = [client_exe, server_exe, show_meshes_exe, show_scene_exe, ...copies];
+maek.TARGETS = [client_exe, server_exe, show_meshes_exe, show_scene_exe, replay_player_exe, ...copies];
 
 //the '[targets =] RULE(targets, prerequisites[, recipe])' rule defines a Makefile-style task
 // targets: array of targets the task produces (can include both files and ':abstract targets')
@@ -201,6 +269,35 @@ maek.RULE([':run'], [client_exe], [
 	[client_exe, '--some-command-line-option']
 ]);
 
+//run the poll() event dispatch benchmark:
+maek.RULE([':dispatch-bench'], [dispatch_bench_exe], [
+	[dispatch_bench_exe]
+]);
+
+//run the headless simulation benchmark:
+// (with default arguments, g++ on x86-64 linux gives final state hash c5d7ac59b3b92aca;
+//  pass it with --expect to catch changes in simulation behavior)
+maek.RULE([':sim-bench'], [sim_bench_exe], [
+	[sim_bench_exe]
+]);
+
+//run the microbenchmarks (JSON results on stdout; see bench.cpp for saving and comparing runs):
+maek.RULE([':bench'], [bench_exe], [
+	[bench_exe]
+]);
+
+//measure input latency against a server already running locally on port 15466 (see latency-probe.cpp):
+maek.RULE([':latency-probe'], [latency_probe_exe], [
+	[latency_probe_exe, 'localhost', '15466']
+]);
+
+//run the tests:
+maek.RULE([':test'], [timing_wheel_test_exe, connection_task_test_exe, migration_test_exe], [
+	[timing_wheel_test_exe],
+	[connection_task_test_exe],
+	[migration_test_exe]
+]);
+
 //Note that tasks that produce ':abstract targets' are never cached.
 // This is similar to how .PHONY targets behave in make.
 
@@ -273,14 +370,14 @@ function init_maek() {
 	}
 
 	if (OS === 'windows') {
-		DEFAULT_OPTIONS.CPP = ['cl.exe', '/nologo', '/EHsc', '/Z7', '/std:c++17', '/W4', '/WX', '/MD'];
+		DEFAULT_OPTIONS.CPP = ['cl.exe', '/nologo', '/EHsc', '/Z7', '/std:c++20', '/W4', '/WX', '/MD'];
 		DEFAULT_OPTIONS.LINK = ['link.exe', '/nologo', '/SUBSYSTEM:CONSOLE', '/DEBUG:FASTLINK', '/INCREMENTAL:NO'];
 	} else if (OS === 'linux') {
-		DEFAULT_OPTIONS.CPP = ['g++', '-std=c++17', '-Wall', '-Werror', '-g'];
-		DEFAULT_OPTIONS.LINK = ['g++', '-std=c++17', '-Wall', '-Werror', '-g'];
+		DEFAULT_OPTIONS.CPP = ['g++', '-std=c++20', '-Wall', '-Werror', '-g'];
+		DEFAULT_OPTIONS.LINK = ['g++', '-std=c++20', '-Wall', '-Werror', '-g'];
 	} else if (OS === 'macos') {
-		DEFAULT_OPTIONS.CPP = ['clang++', '-std=c++17', '-Wall', '-Werror', '-Wshadow', '-g'];
-		DEFAULT_OPTIONS.LINK = ['clang++', '-std=c++17', '-Wall', '-Werror', '-Wshadow', '-g'];
+		DEFAULT_OPTIONS.CPP = ['clang++', '-std=c++20', '-Wall', '-Werror', '-Wshadow', '-g'];
+		DEFAULT_OPTIONS.LINK = ['clang++', '-std=c++20', '-Wall', '-Werror', '-Wshadow', '-g'];
 	}
 
 	//any settings here override 'DEFAULT_OPTIONS':
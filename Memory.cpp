@@ -0,0 +1,56 @@
+#include "Memory.hpp"
+
+#include <iomanip>
+#include <sstream>
+
+namespace {
+	std::array< std::atomic< int64_t >, Memory::CategoryCount > live_bytes{};
+	std::array< std::atomic< int64_t >, Memory::CategoryCount > peak_bytes{};
+
+	bool is_gl(Memory::Category category) {
+		return category >= Memory::MeshBuffersGL;
+	}
+}
+
+std::array< char const *, Memory::CategoryCount > const Memory::CategoryNames{{
+	"mesh data", "scene graph", "sound samples", "glyph textures", "connection buffers", "frame temporaries",
+	"mesh buffers (GL)", "textures (GL)", "stream buffers (GL)"
+}};
+
+void Memory::add(Category category, int64_t bytes) {
+	int64_t now = live_bytes[category].fetch_add(bytes, std::memory_order_relaxed) + bytes;
+	int64_t peak = peak_bytes[category].load(std::memory_order_relaxed);
+	while (now > peak && !peak_bytes[category].compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+	}
+}
+
+int64_t Memory::live(Category category) {
+	return live_bytes[category].load(std::memory_order_relaxed);
+}
+
+int64_t Memory::peak(Category category) {
+	return peak_bytes[category].load(std::memory_order_relaxed);
+}
+
+std::string Memory::report() {
+	std::ostringstream out;
+	auto kib = [](int64_t bytes) {
+		std::ostringstream str;
+		str << std::fixed << std::setprecision(1) << (bytes / 1024.0);
+		return str.str();
+	};
+	out << std::left << std::setw(22) << "memory" << std::right << std::setw(12) << "live KiB" << std::setw(12) << "peak KiB" << "\n";
+
+	int64_t cpu_live = 0, gl_live = 0;
+	for (uint32_t c = 0; c < CategoryCount; ++c) {
+		Category category = Category(c);
+		(is_gl(category) ? gl_live : cpu_live) += live(category);
+		if (peak(category) == 0) continue; //(never used in this program)
+		out << "  " << std::left << std::setw(20) << CategoryNames[c] << std::right
+			<< std::setw(12) << kib(live(category)) << std::setw(12) << kib(peak(category)) << "\n";
+	}
+	//(categories peak at different times, so there's no total peak)
+	out << "  " << std::left << std::setw(20) << "total (CPU)" << std::right << std::setw(12) << kib(cpu_live) << "\n";
+	out << "  " << std::left << std::setw(20) << "total (GL, est.)" << std::right << std::setw(12) << kib(gl_live) << "\n";
+	return out.str();
+}
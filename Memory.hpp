@@ -0,0 +1,72 @@
+#pragma once
+
+/*
+ * Memory keeps live and peak byte counts for the kinds of memory that set the
+ * client's and server's footprints (for picking budgets, not for finding leaks):
+ *
+ *  Memory::add(Memory::SoundSamples, bytes); //(negative to release)
+ *
+ *  struct Thing {
+ *  	std::vector< Item > items;
+ *  	Memory::Tracked memory{Memory::SceneGraph}; //(released when its owner goes away)
+ *  	void grow() { items.emplace_back(); memory.set(items.capacity() * sizeof(Item)); }
+ *  };
+ *
+ *  std::cout << Memory::report(); //live and peak bytes by category
+ *
+ * Counts are what the tracked code says it holds (container capacities and
+ * the like), not allocator overhead. GL categories are estimates: the bytes
+ * passed to glBufferData / glTexImage2D, which drivers may pad or shadow.
+ *
+ * Updates are a couple of relaxed atomic operations, so they're fine from any
+ * thread, but they're meant for loads and buffer growth, not every allocation.
+ */
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace Memory {
+	enum Category : uint32_t {
+		MeshData, //MeshBuffer mesh tables (plus vertex data while it's being loaded)
+		SceneGraph, //Scene transforms, drawables, cameras, and lights
+		SoundSamples, //decoded audio
+		GlyphTextures, //glyph tiles rasterized for PlayMode's text (while being uploaded)
+		ConnectionBuffers, //socket send and receive buffers
+		FrameTemporaries, //vertex lists built each frame (DrawLines, PlayMode's triangle strips)
+		MeshBuffersGL, //(estimated) MeshBuffer vertex buffers
+		TexturesGL, //(estimated) PlayMode's glyph tile texture
+		StreamBuffersGL, //(estimated) vertex buffers uploaded every frame (DrawLines, PlayMode's triangle strips)
+		CategoryCount
+	};
+	extern std::array< char const *, CategoryCount > const CategoryNames;
+
+	void add(Category category, int64_t bytes);
+
+	int64_t live(Category category);
+	int64_t peak(Category category); //(largest live value so far)
+
+	//table of live and peak bytes by category (plus CPU and GL totals; unused categories are left out):
+	std::string report();
+
+	//follows one object's changing size in a category (copies count again; destruction releases):
+	struct Tracked {
+		constexpr explicit Tracked(Category category_) : category(category_) { }
+		Tracked(Tracked const &other) : category(other.category) { set(other.bytes); }
+		Tracked &operator=(Tracked const &other) {
+			if (this != &other) { set(0); category = other.category; set(other.bytes); }
+			return *this;
+		}
+		~Tracked() { set(0); }
+
+		void set(size_t bytes_) {
+			if (bytes_ != bytes) add(category, int64_t(bytes_) - int64_t(bytes));
+			bytes = bytes_;
+		}
+
+		Category category;
+		size_t bytes = 0;
+	};
+}
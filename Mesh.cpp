@@ -1,5 +1,7 @@
 #include "Mesh.hpp"
 #include "read_write_chunk.hpp"
+#include "LoadProfile.hpp"
+#include "FlightRecorder.hpp"
 
 #include <glm/glm.hpp>
 
@@ -12,9 +14,11 @@
 #include <cstddef>
 
 MeshBuffer::MeshBuffer(std::string const &filename) {
+	RECORD_SCOPE("MeshBuffer::MeshBuffer");
 	glGenBuffers(1, &buffer);
 
 	std::ifstream file(filename, std::ios::binary);
+	LoadProfile::read_file(filename);
 
 	GLuint total = 0;
 
@@ -26,15 +30,19 @@ MeshBuffer::MeshBuffer(std::string const &filename) {
 	};
 	static_assert(sizeof(Vertex) == 3*4+3*4+4*1+2*4, "Vertex is packed.");
 	std::vector< Vertex > data;
+	Memory::Tracked data_memory(Memory::MeshData); //(vertex data is only held until it's uploaded)
 
 	//read + upload data chunk:
 	if (filename.size() >= 5 && filename.substr(filename.size()-5) == ".pnct") {
 		read_chunk(file, "pnct", &data);
+		data_memory.set(data.capacity() * sizeof(Vertex));
 
 		//upload data:
 		glBindBuffer(GL_ARRAY_BUFFER, buffer);
 		glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(Vertex), data.data(), GL_STATIC_DRAW);
 		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		buffer_memory.set(data.size() * sizeof(Vertex));
+		LoadProfile::uploaded(data.size() * sizeof(Vertex));
 
 		total = GLuint(data.size()); //store total for later checks on index
 
@@ -83,6 +91,15 @@ MeshBuffer::MeshBuffer(std::string const &filename) {
 		}
 	}
 
+	{ //mesh table size (each map node holds a name, a mesh, and a few pointers of bookkeeping):
+		size_t bytes = 0;
+		for (auto const &[name, mesh] : meshes) {
+			bytes += sizeof(decltype(meshes)::value_type) + 4 * sizeof(void *);
+			if (name.capacity() > std::string().capacity()) bytes += name.capacity() + 1;
+		}
+		memory.set(bytes);
+	}
+
 	if (file.peek() != EOF) {
 		std::cerr << "WARNING: trailing data in mesh file '" << filename << "'" << std::endl;
 	}
@@ -10,6 +10,7 @@
  */
 
 #include "GL.hpp"
+#include "Memory.hpp"
 #include <glm/glm.hpp>
 #include <map>
 #include <limits>
@@ -67,4 +68,8 @@ struct MeshBuffer {
 	Attrib Normal;
 	Attrib Color;
 	Attrib TexCoord;
+
+	//memory used by the mesh table and (estimated) by the vertex buffer:
+	Memory::Tracked memory{Memory::MeshData};
+	Memory::Tracked buffer_memory{Memory::MeshBuffersGL};
 };
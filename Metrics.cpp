@@ -0,0 +1,162 @@
+#include "Metrics.hpp"
+
+#include "Game.hpp"
+#include "Memory.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+
+static std::array< Metrics::Shard, Metrics::MaxShards > shards;
+static std::atomic< size_t > shards_claimed{0};
+
+Metrics::Shard *Metrics::claim_shard() {
+	size_t index = shards_claimed.fetch_add(1, std::memory_order_relaxed);
+	if (index < MaxShards - 1) return &shards[index];
+	//out of private shards; the last one is shared by everyone else:
+	shards.back().shared.store(true, std::memory_order_relaxed);
+	return &shards.back();
+}
+
+//label for a message type byte:
+static std::string message_name(uint8_t type) {
+	switch (Message(type)) {
+		case Message::C2S_Controls: return "controls";
+		case Message::S2C_State: return "state";
+		case Message::S2S_Handoff: return "handoff";
+		case Message::S2S_HandoffAck: return "handoff_ack";
+		case Message::S2C_Redirect: return "redirect";
+		case Message::C2S_Resume: return "resume";
+		case Message::S2C_LockstepStart: return "lockstep_start";
+		case Message::S2C_LockstepFrame: return "lockstep_frame";
+		case Message::S2C_Ping: return "ping";
+		case Message::C2S_Pong: return "pong";
+	}
+	return "unknown_" + std::to_string(int(type));
+}
+
+uint64_t Metrics::total(Counter counter) {
+	size_t used = std::min(shards_claimed.load(std::memory_order_relaxed), MaxShards);
+	uint64_t sum = 0;
+	for (size_t i = 0; i < used; ++i) sum += shards[i].counters[counter].load(std::memory_order_relaxed);
+	return sum;
+}
+
+std::string Metrics::prometheus_text() {
+	size_t used = std::min(shards_claimed.load(std::memory_order_relaxed), MaxShards);
+
+	//sum an atomic field over every shard in use:
+	auto total = [&](auto field) {
+		int64_t sum = 0;
+		for (size_t i = 0; i < used; ++i) sum += int64_t(field(shards[i]).load(std::memory_order_relaxed));
+		return sum;
+	};
+
+	std::ostringstream out;
+	auto header = [&](char const *name, char const *type, char const *help) {
+		out << "# HELP " << name << " " << help << "\n";
+		out << "# TYPE " << name << " " << type << "\n";
+	};
+
+	struct Info {
+		char const *name;
+		char const *help;
+	};
+	static std::array< Info, CounterCount > const counter_info{{
+		{"server_connections_opened_total", "Connections accepted."},
+		{"server_connections_closed_total", "Connections closed (by either side)."},
+		{"server_connection_timeouts_total", "Connections dropped for missing the handshake deadline or going idle."},
+		{"server_socket_errors_total", "Connections dropped because a socket call failed."},
+		{"server_socket_received_bytes_total", "Bytes read from sockets."},
+		{"server_socket_sent_bytes_total", "Bytes written to sockets."},
+		{"server_parse_errors_total", "Malformed or unexpected messages (the connection is dropped)."},
+		{"server_queue_full_total", "Hand-offs between threads that found the queue full."},
+		{"server_ticks_total", "Simulation ticks run."},
+		{"server_ticks_over_budget_total", "Ticks whose work took longer than the tick length."},
+	}};
+	for (uint32_t c = 0; c < CounterCount; ++c) {
+		header(counter_info[c].name, "counter", counter_info[c].help);
+		out << counter_info[c].name << " " << total([c](Shard &s) -> auto & { return s.counters[c]; }) << "\n";
+	}
+
+	static std::array< Info, GaugeCount > const gauge_info{{
+		{"server_connections", "Open connections."},
+		{"server_players", "Players in the match."},
+		{"server_to_simulation_queue_depth", "Events waiting in the network -> simulation queue."},
+		{"server_to_network_queue_depth", "Events waiting in the simulation -> network queue."},
+		{"server_backlog_events", "Events waiting for room in a full queue."},
+		{"server_send_buffer_bytes", "Bytes waiting in connection send buffers."},
+		{"server_send_buffer_max_bytes", "Bytes waiting in the fullest connection send buffer."},
+	}};
+	for (uint32_t g = 0; g < GaugeCount; ++g) {
+		header(gauge_info[g].name, "gauge", gauge_info[g].help);
+		out << gauge_info[g].name << " " << total([g](Shard &s) -> auto & { return s.gauges[g]; }) << "\n";
+	}
+
+	static std::array< Info, HistogramCount > const histogram_info{{
+		{"server_tick_seconds", "Simulation thread work per tick."},
+		{"server_tick_late_seconds", "How late the simulation thread woke up for each tick."},
+	}};
+	for (uint32_t h = 0; h < HistogramCount; ++h) {
+		char const *name = histogram_info[h].name;
+		header(name, "histogram", histogram_info[h].help);
+		int64_t cumulative = 0;
+		for (size_t b = 0; b <= Buckets.size(); ++b) {
+			cumulative += total([h, b](Shard &s) -> auto & { return s.histograms[h].buckets[b]; });
+			out << name << "_bucket{le=\"";
+			if (b < Buckets.size()) out << Buckets[b];
+			else out << "+Inf";
+			out << "\"} " << cumulative << "\n";
+		}
+		out << name << "_sum " << (total([h](Shard &s) -> auto & { return s.histograms[h].sum_ns; }) * 1e-9) << "\n";
+		out << name << "_count " << total([h](Shard &s) -> auto & { return s.histograms[h].count; }) << "\n";
+	}
+
+	//per message type, only for types that have been seen:
+	auto by_type = [&](char const *name, char const *help, auto field) {
+		header(name, "counter", help);
+		for (uint32_t type = 0; type < 256; ++type) {
+			int64_t value = total([&](Shard &s) -> auto & { return field(s)[type]; });
+			if (value == 0) continue;
+			out << name << "{type=\"" << message_name(uint8_t(type)) << "\"} " << value << "\n";
+		}
+	};
+	by_type("server_messages_received_total", "Messages received, by type.", [](Shard &s) -> auto & { return s.messages_received; });
+	by_type("server_message_received_bytes_total", "Bytes of messages received (including headers), by type.", [](Shard &s) -> auto & { return s.bytes_received; });
+	by_type("server_messages_sent_total", "Messages queued for sending, by type.", [](Shard &s) -> auto & { return s.messages_sent; });
+	by_type("server_message_sent_bytes_total", "Bytes of messages queued for sending (including headers), by type.", [](Shard &s) -> auto & { return s.bytes_sent; });
+
+	//tracked memory (see Memory.hpp), for categories the server has used:
+	auto by_category = [&](char const *name, char const *help, int64_t (*value)(Memory::Category)) {
+		header(name, "gauge", help);
+		for (uint32_t c = 0; c < Memory::CategoryCount; ++c) {
+			if (Memory::peak(Memory::Category(c)) == 0) continue;
+			out << name << "{category=\"" << Memory::CategoryNames[c] << "\"} " << value(Memory::Category(c)) << "\n";
+		}
+	};
+	by_category("server_memory_bytes", "Tracked memory in use, by category.", Memory::live);
+	by_category("server_memory_peak_bytes", "Most tracked memory in use at once, by category.", Memory::peak);
+
+	return out.str();
+}
+
+bool Metrics::write_file(std::string const &path) {
+	std::string temp = path + ".tmp";
+	{
+		std::ofstream file(temp, std::ios::binary);
+		file << prometheus_text();
+		if (!file) {
+			std::cerr << "[metrics] failed to write '" << temp << "'." << std::endl;
+			return false;
+		}
+	}
+	#ifdef _WIN32
+	std::remove(path.c_str()); //(rename won't replace an existing file on windows)
+	#endif
+	if (std::rename(temp.c_str(), path.c_str()) != 0) {
+		std::cerr << "[metrics] failed to replace '" << path << "'." << std::endl;
+		return false;
+	}
+	return true;
+}
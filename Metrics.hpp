@@ -0,0 +1,126 @@
+#pragma once
+
+/*
+ * Metrics collects counters, gauges and histograms from the server's
+ * threads and formats them as Prometheus-style text:
+ *
+ *  Metrics::add(Metrics::ParseErrors); //count something
+ *  Metrics::set(Metrics::Players, game.players.size()); //report a current value
+ *  Metrics::observe(Metrics::TickSeconds, seconds); //record a duration
+ *  Metrics::message_received(type, bytes); //per-message-type traffic
+ *
+ *  Metrics::write_file("server.prom"); //(atomically) replace a file with the current values
+ *
+ * Each thread records into its own cache-line-aligned shard, so recording is
+ * a couple of uncontended memory operations: no locks and no shared writes.
+ * Readers merge the shards when formatting. Values from different threads
+ * are summed, so a gauge set from several threads (say, the backlog of each
+ * thread's outgoing queue) reports the total.
+ */
+
+#include <atomic>
+#include <array>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+struct Metrics {
+	enum Counter : uint32_t {
+		ConnectionsOpened,
+		ConnectionsClosed,
+		ConnectionTimeouts, //(handshake or idle)
+		SocketErrors,
+		SocketBytesReceived,
+		SocketBytesSent,
+		ParseErrors, //malformed or unexpected messages (connection dropped)
+		QueueFull, //hand-offs between threads that found the queue full
+		Ticks,
+		TicksOverBudget, //ticks whose work took longer than Game::Tick
+		CounterCount
+	};
+	enum Gauge : uint32_t {
+		Connections,
+		Players,
+		ToSimulationDepth, //network -> simulation queue
+		ToNetworkDepth, //simulation -> network queue
+		BacklogEvents, //events waiting for room in either queue
+		SendBufferBytes, //bytes waiting in connections' send buffers
+		SendBufferMaxBytes, //(the largest single buffer)
+		GaugeCount
+	};
+	enum Histogram : uint32_t {
+		TickSeconds, //simulation work per tick
+		TickLateSeconds, //how late the simulation thread woke for each tick
+		HistogramCount
+	};
+	//histogram bucket upper bounds, in seconds (plus a final +Inf bucket):
+	static constexpr std::array< double, 12 > Buckets{
+		0.00005, 0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.02, 1.0 / 30.0, 0.05, 0.1
+	};
+
+	static constexpr size_t MaxShards = 16; //threads with their own shard (more than this share one)
+
+	struct alignas(64) Shard {
+		std::atomic< bool > shared{false}; //(overflow shard, written by several threads)
+		void bump(std::atomic< uint64_t > &value, uint64_t amount) {
+			if (shared.load(std::memory_order_relaxed)) value.fetch_add(amount, std::memory_order_relaxed);
+			else value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+		}
+
+		std::array< std::atomic< uint64_t >, CounterCount > counters{};
+		std::array< std::atomic< int64_t >, GaugeCount > gauges{};
+		struct HistogramData {
+			std::array< std::atomic< uint64_t >, Buckets.size() + 1 > buckets{};
+			std::atomic< uint64_t > count{0};
+			std::atomic< uint64_t > sum_ns{0};
+		};
+		std::array< HistogramData, HistogramCount > histograms;
+		//by message type byte:
+		std::array< std::atomic< uint64_t >, 256 > messages_received{}, bytes_received{}, messages_sent{}, bytes_sent{};
+	};
+
+	//this thread's shard:
+	static Shard &local() {
+		thread_local Shard *shard = claim_shard();
+		return *shard;
+	}
+	static Shard *claim_shard();
+
+	static void add(Counter counter, uint64_t amount = 1) {
+		Shard &shard = local();
+		shard.bump(shard.counters[counter], amount);
+	}
+	static void set(Gauge gauge, int64_t value) {
+		local().gauges[gauge].store(value, std::memory_order_relaxed);
+	}
+	static void observe(Histogram histogram, double seconds) {
+		Shard &shard = local();
+		auto &h = shard.histograms[histogram];
+		size_t bucket = 0;
+		while (bucket < Buckets.size() && seconds > Buckets[bucket]) ++bucket;
+		shard.bump(h.buckets[bucket], 1);
+		shard.bump(h.count, 1);
+		shard.bump(h.sum_ns, uint64_t(std::max(0.0, seconds) * 1e9));
+	}
+	static void message_received(uint8_t type, size_t bytes) {
+		Shard &shard = local();
+		shard.bump(shard.messages_received[type], 1);
+		shard.bump(shard.bytes_received[type], bytes);
+	}
+	static void message_sent(uint8_t type, size_t bytes) {
+		Shard &shard = local();
+		shard.bump(shard.messages_sent[type], 1);
+		shard.bump(shard.bytes_sent[type], bytes);
+	}
+
+	//a counter's value summed over every thread:
+	static uint64_t total(Counter counter);
+
+	//everything recorded so far, in Prometheus text exposition format:
+	static std::string prometheus_text();
+
+	//write prometheus_text() to 'path' (via a temporary file and a rename, so readers never see a partial file);
+	// returns false (with a message on std::cerr) on failure:
+	static bool write_file(std::string const &path);
+};
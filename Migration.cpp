@@ -0,0 +1,137 @@
+#include "Migration.hpp"
+
+#include "read_write_message.hpp"
+
+#include <stdexcept>
+#include <random>
+#include <cassert>
+
+void send_handoff_message(Connection *connection_, Handoff const &handoff) {
+	assert(connection_);
+	auto &connection = *connection_;
+
+	if (handoff.secret.size() > 255) throw std::runtime_error("Handoff secret too long.");
+
+	uint32_t size = uint32_t(1 + handoff.secret.size() + 4 + 4 + handoff.checkpoint.size() + 1 + 8 * handoff.tokens.size());
+	send_message_header(connection, Message::S2S_Handoff, size);
+	connection.send(uint8_t(handoff.secret.size()));
+	connection.send_raw(handoff.secret.data(), handoff.secret.size());
+	connection.send(handoff.server_tick);
+	connection.send(uint32_t(handoff.checkpoint.size()));
+	connection.send_raw(handoff.checkpoint.data(), handoff.checkpoint.size());
+	connection.send(uint8_t(handoff.tokens.size()));
+	for (uint64_t token : handoff.tokens) {
+		connection.send(token);
+	}
+}
+
+bool recv_handoff_message(Connection *connection_, Handoff *handoff) {
+	assert(connection_);
+	assert(handoff);
+	auto &connection = *connection_;
+
+	uint32_t size;
+	if (!peek_message(connection, Message::S2S_Handoff, &size)) return false;
+	MessageReader reader(connection, size, "handoff");
+
+	reader.read(&handoff->secret);
+	reader.read(&handoff->server_tick);
+
+	uint32_t checkpoint_size;
+	reader.read(&checkpoint_size);
+	if (checkpoint_size > size) throw std::runtime_error("Handoff checkpoint larger than message.");
+	handoff->checkpoint.resize(checkpoint_size);
+	reader.read(handoff->checkpoint.data(), checkpoint_size);
+
+	uint8_t token_count;
+	reader.read(&token_count);
+	handoff->tokens.resize(token_count);
+	for (auto &token : handoff->tokens) {
+		reader.read(&token);
+	}
+
+	reader.finish();
+	return true;
+}
+
+void send_handoff_ack_message(Connection *connection_) {
+	assert(connection_);
+	send_message_header(*connection_, Message::S2S_HandoffAck, 0);
+}
+
+bool recv_handoff_ack_message(Connection *connection_) {
+	assert(connection_);
+	auto &connection = *connection_;
+
+	uint32_t size;
+	if (!peek_message(connection, Message::S2S_HandoffAck, &size)) return false;
+	MessageReader reader(connection, size, "handoff ack");
+	reader.finish();
+	return true;
+}
+
+void send_redirect_message(Connection *connection_, Redirect const &redirect) {
+	assert(connection_);
+	auto &connection = *connection_;
+
+	if (redirect.host.size() > 255 || redirect.port.size() > 255) throw std::runtime_error("Redirect host or port too long.");
+
+	uint32_t size = uint32_t(8 + 1 + redirect.host.size() + 1 + redirect.port.size());
+	send_message_header(connection, Message::S2C_Redirect, size);
+	connection.send(redirect.token);
+	connection.send(uint8_t(redirect.host.size()));
+	connection.send_raw(redirect.host.data(), redirect.host.size());
+	connection.send(uint8_t(redirect.port.size()));
+	connection.send_raw(redirect.port.data(), redirect.port.size());
+}
+
+bool recv_redirect_message(Connection *connection_, Redirect *redirect) {
+	assert(connection_);
+	assert(redirect);
+	auto &connection = *connection_;
+
+	uint32_t size;
+	if (!peek_message(connection, Message::S2C_Redirect, &size)) return false;
+	MessageReader reader(connection, size, "redirect");
+	reader.read(&redirect->token);
+	reader.read(&redirect->host);
+	reader.read(&redirect->port);
+	reader.finish();
+	return true;
+}
+
+void send_resume_message(Connection *connection_, uint64_t token) {
+	assert(connection_);
+	auto &connection = *connection_;
+
+	send_message_header(connection, Message::C2S_Resume, 8);
+	connection.send(token);
+}
+
+bool recv_resume_message(Connection *connection_, uint64_t *token) {
+	assert(connection_);
+	assert(token);
+	auto &connection = *connection_;
+
+	uint32_t size;
+	if (!peek_message(connection, Message::C2S_Resume, &size)) return false;
+	if (size != 8) throw std::runtime_error("Resume message with size " + std::to_string(size) + " != 8!");
+	MessageReader reader(connection, size, "resume");
+	reader.read(token);
+	reader.finish();
+	return true;
+}
+
+uint64_t make_resume_token() {
+	static std::random_device rd;
+	return (uint64_t(rd()) << 32) | uint64_t(rd());
+}
+
+bool handoff_secret_matches(std::string const &expected, std::string const &got) {
+	if (expected.empty() || got.size() != expected.size()) return false;
+	uint8_t differences = 0;
+	for (size_t i = 0; i < expected.size(); ++i) {
+		differences |= uint8_t(expected[i] ^ got[i]);
+	}
+	return differences == 0;
+}
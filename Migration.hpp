@@ -0,0 +1,64 @@
+#pragma once
+
+/*
+ * Messages used to move a running match from one server process to another
+ * (e.g., to drain a machine for maintenance) without ending it:
+ *
+ *  1. source -> target: S2S_Handoff [shared secret, server tick, checkpoint (see Game::save_checkpoint), resume tokens]
+ *     The source pauses the game (but not its tick loop) as soon as it takes the checkpoint.
+ *     The target only takes handoffs carrying the secret both servers were configured with,
+ *     and only while it isn't hosting a match of its own.
+ *     The target carries on counting ticks from the source's tick, so the state messages clients
+ *     get after following the match don't jump backward (or far ahead) in time.
+ *  2. target -> source: S2S_HandoffAck
+ *     The target has loaded the checkpoint and is holding each player's slot for its token.
+ *  3. source -> each client: S2C_Redirect [token, host, port]
+ *  4. client -> target (on a new connection): C2S_Resume [token]
+ *     The target resumes ticking once every player is back (or a short deadline passes).
+ *
+ * Players see the match pause for roughly the time it takes to complete steps 1-4.
+ */
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+struct Connection;
+
+struct Handoff {
+	std::string secret; //shared by the servers allowed to hand matches to each other (at most 255 bytes)
+	uint32_t server_tick = 0; //source's tick when the checkpoint was taken (state messages are stamped with it)
+	std::vector< uint8_t > checkpoint;
+	//one token per player, in the same order as the checkpoint's player list:
+	std::vector< uint64_t > tokens;
+};
+
+struct Redirect {
+	uint64_t token = 0;
+	std::string host;
+	std::string port;
+};
+
+//"send" functions append to connection->send_buffer;
+//"recv" functions consume a message from connection->recv_buffer and return true,
+// or return false if a whole message of that type isn't at the front of the buffer.
+//(recv functions throw on malformed messages)
+
+void send_handoff_message(Connection *connection, Handoff const &handoff);
+bool recv_handoff_message(Connection *connection, Handoff *handoff);
+
+void send_handoff_ack_message(Connection *connection);
+bool recv_handoff_ack_message(Connection *connection);
+
+void send_redirect_message(Connection *connection, Redirect const &redirect);
+bool recv_redirect_message(Connection *connection, Redirect *redirect);
+
+void send_resume_message(Connection *connection, uint64_t token);
+bool recv_resume_message(Connection *connection, uint64_t *token);
+
+//unguessable token for a resume slot:
+uint64_t make_resume_token();
+
+//compare a handoff's secret with the expected one (taking the same time wherever they differ):
+// (an empty 'expected' secret matches nothing)
+bool handoff_secret_matches(std::string const &expected, std::string const &got);
@@ -7,6 +7,9 @@
 #include "gl_compile_program.hpp"
 #include "read_write_chunk.hpp"
 #include "Load.hpp"
+#include "LoadProfile.hpp"
+#include "Migration.hpp"
+#include "FlightRecorder.hpp"
 
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/string_cast.hpp>
@@ -15,6 +18,10 @@
 #include <array>
 #include <fstream>
 #include <filesystem>
+#include <optional>
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
 
 //#include "../nest-libs/windows/glm/include/glm/gtc/type_ptr.hpp"
 //#include "../nest-libs/windows/harfbuzz/include/hb.h"
@@ -30,7 +37,10 @@
 Load< PlayMode::PPUTileProgram > tile_program(LoadTagEarly); //will 'new PPUTileProgram()' by default
 Load< PlayMode::PPUDataStream > data_stream(LoadTagDefault);
 
-PlayMode::PlayMode(Client &client_) : client(client_) {
+PlayMode::PlayMode(Client &client_, bool rollback) : client(client_) {
+	LoadProfile::Scope profile("PlayMode::PlayMode");
+	lockstep.rollback = rollback;
+
 	// Adapted from Harfbuzz example linked on assignment page
 	// This font was obtained from https://fonts.google.com/noto/specimen/Noto+Emoji
 	// See the license in dist/Noto_Emoji/OFL.txt
@@ -38,6 +48,8 @@ PlayMode::PlayMode(Client &client_) : client(client_) {
 	const char* fontfile = fontfilestring.c_str();
 
 	// Initialize FreeType and create FreeType font face.
+	LoadProfile::Scope font_profile("font setup");
+	LoadProfile::read_file(fontfilestring);
 	if (FT_Init_FreeType(&ft_library))
 		abort();
 	if (FT_New_Face(ft_library, fontfile, 0, &ft_face))
@@ -47,7 +59,10 @@ PlayMode::PlayMode(Client &client_) : client(client_) {
 
 	// Create hb-ft font.
 	hb_font = hb_ft_font_create(ft_face, NULL);
+	font_profile.finish();
 
+	//(every glyph gets rasterized twice below: once to size the tiles, once to fill them)
+	LoadProfile::Scope glyphs_profile("glyph tiles");
 	// Determine a fixed size and baseline for all character tiles
 	for (size_t i = 1; i <= characters.size(); i++) {
 		FT_UInt glyph_index = FT_Get_Char_Index(ft_face, (FT_ULong)characters[i]);
@@ -74,6 +89,8 @@ PlayMode::PlayMode(Client &client_) : client(client_) {
 	//interpret tiles and build a 1 x num_chars color texture (adapated from PPU466)
 	std::vector<glm::u8vec4> data;
 	data.resize(characters.size() * char_width * char_height);
+	Memory::Tracked data_memory(Memory::GlyphTextures);
+	data_memory.set(data.capacity() * sizeof(glm::u8vec4));
 	for (uint32_t i = 0; i < characters.size(); i++) {
 		FT_UInt glyph_index = FT_Get_Char_Index(ft_face, characters[i]);//min_char + i);
 		FT_Load_Glyph(ft_face, glyph_index, FT_LOAD_DEFAULT);
@@ -102,15 +119,19 @@ PlayMode::PlayMode(Client &client_) : client(client_) {
 	glBindTexture(GL_TEXTURE_2D, data_stream->tile_tex);
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, char_width * (int)characters.size(), char_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
 	glBindTexture(GL_TEXTURE_2D, 0);
+	data_stream->tile_memory.set(data.size() * 4); //(RGBA8)
+	LoadProfile::uploaded(data.size() * 4);
 }
 
 PlayMode::~PlayMode() {
+	if (latency.summary(LatencyTrace::Predicted).count) std::cout << latency.report();
 }
 
 bool PlayMode::handle_event(SDL_Event const &evt, glm::uvec2 const &window_size) {
 	auto pressFinger = [&](std::array<Button, 4>& hand, int finger) {
 		hand[finger].downs += 1;
 		hand[finger].pressed = true;
+		latency.key();
 	};
 
 	auto releaseFinger = [&](std::array<Button, 4>& hand, int finger) {
@@ -120,6 +141,9 @@ bool PlayMode::handle_event(SDL_Event const &evt, glm::uvec2 const &window_size)
 	if (evt.type == SDL_KEYDOWN) {
 		if (evt.key.repeat) {
 			//ignore repeats
+		} else if (evt.key.keysym.sym == SDLK_F3) {
+			show_prediction = !show_prediction;
+			return true;
 		} else if (evt.key.keysym.sym == SDLK_f) {
 			pressFinger(controls.left_buttons, 0);
 			return true;
@@ -178,8 +202,29 @@ bool PlayMode::handle_event(SDL_Event const &evt, glm::uvec2 const &window_size)
 
 void PlayMode::update(float elapsed) {
 
-	//queue data for sending to server:
-	controls.send_controls_message(&client.connection);
+	//queue data for sending to server (stamped with our tick, so the server can apply it at the right one):
+	input_clock += elapsed;
+	uint32_t input_tick = uint32_t(input_clock / Game::Tick);
+	controls.send_controls_message(&client.connection, input_tick);
+	latency.sent(input_tick);
+	if (!lockstep.active) record_prediction_input(input_tick);
+
+	if (lockstep.active && lockstep.rollback) {
+		//run our copy of the game ahead of the server, using our own input as soon as we have it:
+		lockstep.downs += LockstepGame::input_from(controls).downs;
+		lockstep.tick_acc += elapsed;
+		while (lockstep.tick_acc >= Game::Tick) {
+			LockstepGame::Input input = LockstepGame::input_from(controls);
+			input.downs = uint8_t(std::min(lockstep.downs, 255U));
+			if (!lockstep.predicted.predict(input)) {
+				//too far ahead of the server; wait for its frames:
+				lockstep.tick_acc = 0.0f;
+				break;
+			}
+			lockstep.downs = 0;
+			lockstep.tick_acc -= Game::Tick;
+		}
+	}
 
 	//reset button press counters:
 	for (size_t i = 0; i < controls.left_buttons.size(); i++) {
@@ -190,7 +235,8 @@ void PlayMode::update(float elapsed) {
 	}
 
 	//send/receive data:
-	client.poll([this](Connection *c, Connection::Event event){
+	std::optional< Redirect > redirect; //(set if the server is moving the match elsewhere)
+	client.poll([this, &redirect](Connection *c, Connection::Event event){
 		if (event == Connection::OnOpen) {
 			std::cout << "[" << c->socket << "] opened" << std::endl;
 		} else if (event == Connection::OnClose) {
@@ -202,7 +248,53 @@ void PlayMode::update(float elapsed) {
 			try {
 				do {
 					handled_message = false;
-					if (game.recv_state_message(c)) handled_message = true;
+					Redirect r;
+					LockstepFrame frame;
+					uint32_t state_tick, state_input_tick;
+					InputEcho echo;
+					if (game.recv_state_message(c, &state_tick, &state_input_tick, &echo)) {
+						latency.state(state_input_tick, echo);
+						reconcile_prediction(state_input_tick);
+
+						snapshot_values.assign(game.bary_score.begin(), game.bary_score.end());
+						for (uint32_t i = 0; i < game.match_size(); ++i) {
+							Player const *player = game.seat(int8_t(i));
+							snapshot_values.emplace_back(player ? player->stamina : 0.0f);
+						}
+						snapshots.push(state_tick, snapshot_values, game.over != snapshot_over, input_clock);
+						snapshot_over = game.over;
+
+						handled_message = true;
+					}
+					else if (recv_ping_message(c)) {
+						//server hasn't heard from us in a while:
+						send_pong_message(c);
+						handled_message = true;
+					} else if (recv_redirect_message(c, &r)) {
+						redirect = r;
+						handled_message = true;
+					} else if (recv_lockstep_start_message(c, &lockstep.game, &lockstep.seat)) {
+						lockstep.active = true;
+						lockstep.predicted.start(lockstep.game, lockstep.seat);
+						lockstep.tick_acc = 0.0f;
+						lockstep.downs = 0;
+						handled_message = true;
+					} else if (recv_lockstep_frame_message(c, &frame)) {
+						if (!lockstep.active) throw std::runtime_error("Lockstep frame before lockstep start.");
+						bool in_sync;
+						if (lockstep.rollback) {
+							in_sync = lockstep.predicted.confirm(frame);
+						} else {
+							if (frame.tick != lockstep.game.tick) throw std::runtime_error("Lockstep frame for tick " + std::to_string(frame.tick) + " out of sequence.");
+							lockstep.game.update(frame.inputs);
+							in_sync = (lockstep.game.hash() == frame.hash);
+						}
+						if (!in_sync) {
+							lockstep.desyncs += 1;
+							std::cerr << "Lockstep desync at tick " << frame.tick << " (" << lockstep.desyncs << " so far)." << std::endl;
+						}
+						handled_message = true;
+					}
 				} while (handled_message);
 			} catch (std::exception const &e) {
 				std::cerr << "[" << c->socket << "] malformed message from server: " << e.what() << std::endl;
@@ -211,6 +303,120 @@ void PlayMode::update(float elapsed) {
 			}
 		}
 	}, 0.0);
+
+	if (lockstep.active) {
+		(lockstep.rollback ? lockstep.predicted.current : lockstep.game).to_game(&game, lockstep.seat);
+	} else if (snapshots.sample(input_clock, &snapshot_values) && snapshot_values.size() == 2 * game.match_size()) {
+		//show the interpolated score point and stamina:
+		uint32_t const match_size = game.match_size();
+		std::copy(snapshot_values.begin(), snapshot_values.begin() + match_size, game.bary_score.begin());
+		for (uint32_t i = 0; i < match_size; ++i) {
+			if (Player *player = game.seat(int8_t(i))) player->stamina = snapshot_values[match_size + i];
+		}
+	}
+
+	if (!lockstep.active && prediction.have_server && !game.players.empty()) {
+		//show our own hands and stamina as predicted from this frame's input, not as the server last saw them:
+		replay_prediction();
+		prediction.stamina_offset *= std::pow(0.5f, elapsed / 0.1f); //(blend corrections in over ~0.1s)
+		Player &local = game.players.front();
+		if (!prediction.pending.empty()) {
+			local.left_hand = prediction.pending.back().left_hand;
+			local.right_hand = prediction.pending.back().right_hand;
+			local.stamina = prediction.pending.back().stamina;
+		}
+		local.stamina += prediction.stamina_offset;
+	}
+
+	if (redirect) {
+		//follow the match to its new server and reclaim our player:
+		// (reconnect() doesn't wait for the connection to open; the resume message goes out once it does)
+		std::cout << "Match is moving to " << redirect->host << ":" << redirect->port << "." << std::endl;
+		client.reconnect(redirect->host, redirect->port);
+		send_resume_message(&client.connection, redirect->token);
+		//the new server's ticks pick up from the source's checkpoint, which may be behind the (paused) states
+		// the source kept sending while handing off (if the checkpoint was slow to arrive), so start the snapshot timeline over:
+		snapshots = SnapshotBuffer();
+		snapshot_over = false;
+	}
+}
+
+void PlayMode::record_prediction_input(uint32_t tick) {
+	auto &pending = prediction.pending;
+	if (pending.empty() || tick > pending.back().tick) {
+		//ticks that passed without a frame of their own held the same buttons, with no presses:
+		uint32_t first = pending.empty() ? tick : pending.back().tick + 1;
+		if (tick - first >= Prediction::MaxPending) first = tick - uint32_t(Prediction::MaxPending) + 1;
+		for (uint32_t t = first; t <= tick; ++t) {
+			pending.emplace_back();
+			pending.back().tick = t;
+			pending.back().controls = controls;
+			for (auto &b : pending.back().controls.left_buttons) b.downs = 0;
+			for (auto &b : pending.back().controls.right_buttons) b.downs = 0;
+		}
+		while (pending.size() > Prediction::MaxPending) pending.pop_front();
+	}
+
+	auto &now = pending.back().controls;
+	for (size_t i = 0; i < controls.left_buttons.size(); i++) {
+		now.left_buttons[i].pressed = controls.left_buttons[i].pressed;
+		now.left_buttons[i].downs += controls.left_buttons[i].downs;
+	}
+	for (size_t i = 0; i < controls.right_buttons.size(); i++) {
+		now.right_buttons[i].pressed = controls.right_buttons[i].pressed;
+		now.right_buttons[i].downs += controls.right_buttons[i].downs;
+	}
+}
+
+void PlayMode::reconcile_prediction(uint32_t input_tick) {
+	if (game.players.empty()) return;
+	Player const &server = game.players.front(); //(the server lists our player first)
+	auto &pending = prediction.pending;
+	auto predicted_stamina = [&]() {
+		return pending.empty() ? prediction.server.stamina : pending.back().stamina;
+	};
+
+	std::optional< float > shown; //(stamina predicted before this correction)
+	if (prediction.have_server) {
+		//bring predictions up to date with the input recorded since the last frame:
+		replay_prediction();
+		shown = predicted_stamina();
+
+		//compare the state the server reached after our input for 'input_tick - 1' with our prediction of it:
+		for (auto const &t : pending) {
+			if (t.tick + 1 != input_tick) continue;
+			size_t slot = prediction.checked % Prediction::History;
+			prediction.stamina_errors[slot] = server.stamina - t.stamina;
+			prediction.hand_misses[slot] = (server.left_hand != t.left_hand || server.right_hand != t.right_hand);
+			prediction.checked += 1;
+			break;
+		}
+	}
+
+	prediction.server = server;
+	prediction.server_active = (game.players.size() == game.match_size() && !game.over);
+	prediction.have_server = true;
+	while (!pending.empty() && pending.front().tick < input_tick) {
+		pending.pop_front();
+	}
+
+	replay_prediction();
+	if (shown) {
+		//keep showing the old prediction for now, blending toward the corrected one (see update):
+		prediction.stamina_offset += *shown - predicted_stamina();
+	}
+}
+
+void PlayMode::replay_prediction() {
+	//the same rules Game::update applies to each player, one tick of our input at a time:
+	Player player = prediction.server;
+	for (auto &t : prediction.pending) {
+		player.controls = t.controls;
+		t.left_hand = Player::hand_for(player.controls.left_buttons, player.stamina);
+		t.right_hand = Player::hand_for(player.controls.right_buttons, player.stamina);
+		if (prediction.server_active) player.update_stamina(Game::Tick);
+		t.stamina = player.stamina;
+	}
 }
 
 // Draws a single character centered at pos to a triangle strip (adapted from PPU466)
@@ -232,10 +438,16 @@ void PlayMode::drawCharacter(glm::vec2 pos, uint32_t tile_index, glm::u8vec4 til
 }
 
 void PlayMode::drawTriangleStrip(const std::vector<PPUDataStream::Vertex>& triangle_strip) {
+	RECORD_SCOPE("PlayMode::drawTriangleStrip");
+	//(the strip is counted while it's drawn)
+	Memory::Tracked strip_memory(Memory::FrameTemporaries);
+	strip_memory.set(triangle_strip.capacity() * sizeof(PPUDataStream::Vertex));
+
 	// Upload vertex buffer
 	glBindBuffer(GL_ARRAY_BUFFER, data_stream->vertex_buffer);
 	glBufferData(GL_ARRAY_BUFFER, sizeof(decltype(triangle_strip[0])) * triangle_strip.size(), triangle_strip.data(), GL_STREAM_DRAW);
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	data_stream->vertex_memory.set(sizeof(PPUDataStream::Vertex) * triangle_strip.size());
 
 	//set up the pipeline:
 	// set blending function for output fragments:
@@ -298,7 +510,8 @@ void PlayMode::draw(glm::uvec2 const &drawable_size) {
 	);
 	DrawLines lines(world_to_clip);
 	
-	if (game.players.size() == 3) {
+	uint32_t const match_size = game.match_size();
+	if (game.players.size() == match_size) {
 		// Helper to draw a line from a to b of width w, with normals n1 and n2 at the endpoints (to make lines join together nicely)
 		auto thickLine = [&](glm::vec2 a, glm::vec2 b, int w, glm::u8vec4 c, glm::vec2 n1, glm::vec2 n2) {
 			n1 = glm::normalize(n1);
@@ -323,31 +536,28 @@ void PlayMode::draw(glm::uvec2 const &drawable_size) {
 		std::vector<glm::vec2> positions;
 		std::vector<float> angles;
 		std::vector<glm::u8vec4> colors;
-		positions.resize(game.players.size());
-		angles.resize(game.players.size());
-		colors.resize(game.players.size());
-		for (auto const& player : game.players) {
-			//positions[player.index] = player.position;
-			if (game.players.size() == 1) {
-				positions[player.index] = glm::vec2(0, 0);
-			} else {
-				float base_angle = 3 * (float)M_PI / 2;
-				for (auto& p : game.players) {
-					int8_t relative_index = (p.index + (int8_t)game.players.size() - game.players.front().index) % game.players.size();
-					angles[p.index] = base_angle + relative_index * 2 * (float)M_PI / game.players.size();
-					positions[p.index] = glm::vec2(cosf(angles[p.index]) * game.triangle_radius, sinf(angles[p.index]) * game.triangle_radius);
-					colors[p.index] = p.color;
-				}
-			}
+		positions.resize(match_size);
+		angles.resize(match_size);
+		colors.resize(match_size);
+		// (the local player, players.front(), sits at the bottom)
+		float base_angle = 3 * (float)M_PI / 2;
+		for (auto const& p : game.players) {
+			int8_t relative_index = (p.index + (int8_t)match_size - game.players.front().index) % match_size;
+			angles[p.index] = base_angle + relative_index * 2 * (float)M_PI / match_size;
+			positions[p.index] = glm::vec2(cosf(angles[p.index]) * game.triangle_radius, sinf(angles[p.index]) * game.triangle_radius);
+			colors[p.index] = p.color;
 		}
 
 		// Set background color to blend into that of the winning player
-		glm::vec4 clear_color = game.bary_score[0] * (glm::vec4)colors[0] + game.bary_score[1] * (glm::vec4)colors[1] + game.bary_score[2] * (glm::vec4)colors[2];
+		glm::vec4 clear_color = glm::vec4(0.f);
+		for (uint32_t i = 0; i < match_size; i++) {
+			clear_color += game.bary_score[i] * (glm::vec4)colors[i];
+		}
 		clear_color = clear_color / (float)(2 * 0xFF);
 		glClearColor(clear_color.x, clear_color.y, clear_color.z, 1.f);
 		glClear(GL_COLOR_BUFFER_BIT);
 
-		// Draw triangle
+		// Draw ring
 		for (size_t i = 0; i < positions.size(); i++) {
 			size_t next_i = (i + 1) % positions.size();
 			thickLine(glm::vec3(positions[i], 0.f), glm::vec3(positions[next_i], 0.f), 8, glm::u8vec4(0xff, 0xff, 0xff, 0xff), positions[i], positions[next_i]);
@@ -362,7 +572,8 @@ void PlayMode::draw(glm::uvec2 const &drawable_size) {
 		
 
 		
-		float player_radius = glm::length(positions[game.players.front().index] - positions[game.players.back().index]) / 2.f;
+		// (half the distance between neighbors, so circles touch)
+		float player_radius = glm::length(positions[0] - positions[1]) / 2.f;
 		std::vector< PPUDataStream::Vertex > triangle_strip;
 		for (auto const &player : game.players) {
 			// Draw stamina circle
@@ -400,16 +611,8 @@ void PlayMode::draw(glm::uvec2 const &drawable_size) {
 			}
 
 			// Get pointers to the players on either side of this one
-			Player* left_player = nullptr;
-			Player* right_player = nullptr;
-			for (auto& p2 : game.players) {
-				if (p2.index == (int8_t)((game.players.size() + player.index - 1) % game.players.size())) {
-					left_player = &p2;
-				}
-				if (p2.index == (int8_t)((game.players.size() + player.index + 1) % game.players.size())) {
-					right_player = &p2;
-				}
-			}
+			Player* left_player = game.seat((int8_t)((match_size + player.index - 1) % match_size));
+			Player* right_player = game.seat((int8_t)((match_size + player.index + 1) % match_size));
 			assert(left_player != nullptr && right_player != nullptr && "Missing player");
 
 			// Determine where to draw the hands
@@ -422,7 +625,7 @@ void PlayMode::draw(glm::uvec2 const &drawable_size) {
 				// Color the active player's hands based on whether they are winning or losing against the neighbors
 				glm::u8vec4 left_color = default_color;
 				glm::u8vec4 right_color = default_color;
-				if (&player == &game.players.front() && game.players.size() == 3) {
+				if (&player == &game.players.front()) {
 					auto winning = [](Hand h1, Hand h2) -> bool {
 						return h2 == Hand::None ||
 							(h1 == Hand::Rock && h2 == Hand::Scissors) ||
@@ -505,8 +708,73 @@ void PlayMode::draw(glm::uvec2 const &drawable_size) {
 		drawCharacter(glm::vec2(0, 0), game.players.size() == 1 ? Char_One : Char_Scissors, default_color, &triangle_strip);
 		drawTriangleStrip(triangle_strip);
 	}
-	
+
+	if (show_prediction && !lockstep.active) {
+		//debug overlay: how far ahead of the server we predict, and how wrong predictions turned out:
+		uint32_t count = std::min< uint32_t >(prediction.checked, uint32_t(Prediction::History));
+		float max_error = 0.0f;
+		uint32_t misses = 0;
+		for (uint32_t i = 0; i < count; ++i) {
+			max_error = std::max(max_error, std::abs(prediction.stamina_errors[i]));
+			misses += prediction.hand_misses[i];
+		}
+
+		std::vector< std::string > text;
+		{
+			std::ostringstream line;
+			line << "predicting " << prediction.pending.size() << " ticks ("
+				<< std::fixed << std::setprecision(0) << (prediction.pending.size() * Game::Tick * 1000.0f) << "ms) ahead of server";
+			text.emplace_back(line.str());
+		}
+		{
+			std::ostringstream line;
+			line << "stamina error: max " << std::fixed << std::setprecision(2) << max_error
+				<< ", correcting " << prediction.stamina_offset;
+			text.emplace_back(line.str());
+		}
+		text.emplace_back("hand mispredictions: " + std::to_string(misses) + " of last " + std::to_string(count) + " states");
+		{
+			std::ostringstream line;
+			line << "interpolation delay " << std::fixed << std::setprecision(0) << (snapshots.delay * 1000.0)
+				<< "ms, jitter " << (snapshots.max_jitter * 1000.0) << "ms, "
+				<< snapshots.extrapolated << " frames extrapolated";
+			text.emplace_back(line.str());
+		}
+		{
+			LatencyTrace::Summary total = latency.summary(LatencyTrace::Total);
+			std::ostringstream line;
+			line << "input latency p50 " << std::fixed << std::setprecision(0) << (total.p50 * 1000.0f)
+				<< "ms, p95 " << (total.p95 * 1000.0f) << "ms (network " << (latency.summary(LatencyTrace::Network).p50 * 1000.0f)
+				<< "ms, server " << ((latency.summary(LatencyTrace::ServerBuffer).p50 + latency.summary(LatencyTrace::ServerHold).p50) * 1000.0f)
+				<< "ms) over " << total.count << " presses";
+			text.emplace_back(line.str());
+		}
+
+		float const H = 0.04f;
+		glm::vec3 at = glm::vec3(-aspect + 0.05f, 0.95f - H, 0.0f);
+		for (auto const &line : text) {
+			lines.draw_text(line, at, glm::vec3(H, 0.0f, 0.0f), glm::vec3(0.0f, H, 0.0f), glm::u8vec4(0xff, 0xff, 0x00, 0xff));
+			at.y -= 1.5f * H;
+		}
+
+		//stamina error per state message (oldest to newest), red where the hands were mispredicted:
+		float const bar = 0.01f; //(width per state)
+		float const unit = 0.05f; //(height per point of stamina error)
+		glm::vec3 base = at - glm::vec3(0.0f, 2.0f * unit, 0.0f);
+		lines.draw(base, base + glm::vec3(bar * Prediction::History, 0.0f, 0.0f), glm::u8vec4(0x88, 0x88, 0x88, 0xff));
+		for (uint32_t i = 0; i < count; ++i) {
+			uint32_t slot = (prediction.checked - count + i) % Prediction::History;
+			float error = std::clamp(prediction.stamina_errors[slot], -2.0f, 2.0f);
+			glm::vec3 x = base + glm::vec3(bar * i, 0.0f, 0.0f);
+			glm::u8vec4 color = prediction.hand_misses[slot] ? glm::u8vec4(0xff, 0x00, 0x00, 0xff) : glm::u8vec4(0xff, 0xff, 0x00, 0xff);
+			lines.draw(x, x + glm::vec3(0.0f, error * unit, 0.0f), color);
+			if (prediction.hand_misses[slot]) lines.draw(x - glm::vec3(0.0f, 0.5f * unit, 0.0f), x + glm::vec3(0.0f, 0.5f * unit, 0.0f), color);
+		}
+	}
+
 	GL_ERRORS();
+
+	latency.drawn();
 }
 
 
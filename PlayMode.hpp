@@ -4,11 +4,16 @@
 
 #include "Connection.hpp"
 #include "Game.hpp"
+#include "LatencyTrace.hpp"
+#include "Memory.hpp"
+#include "Rollback.hpp"
+#include "SnapshotBuffer.hpp"
 
 #include <glm/glm.hpp>
 
 #include <vector>
 #include <deque>
+#include <array>
 
 //#include "../nest-libs/windows/glm/include/glm/glm.hpp"
 //#include "../nest-libs/windows/harfbuzz/include/hb.h"
@@ -22,7 +27,7 @@
 #include <freetype/fttypes.h>
 
 struct PlayMode : Mode {
-	PlayMode(Client &client);
+	PlayMode(Client &client, bool rollback = true);
 	virtual ~PlayMode();
 
 	//functions called by main loop:
@@ -35,9 +40,68 @@ struct PlayMode : Mode {
 	//input tracking for local player:
 	Player::Controls controls;
 
+	//seconds of play so far (controls are stamped with the tick this falls in):
+	double input_clock = 0.0;
+
 	//latest game state (from server):
 	Game game;
 
+	//the score point and other players' stamina are shown slightly in the past,
+	// blended between state messages (see SnapshotBuffer.hpp):
+	SnapshotBuffer snapshots;
+	std::vector< float > snapshot_values; //(bary_score, then each seat's stamina)
+	bool snapshot_over = false; //(to notice the match ending or restarting)
+
+	//in lockstep mode, the client runs the simulation itself from relayed inputs:
+	struct {
+		bool active = false; //(set by the server's first lockstep start message)
+		bool rollback = true; //predict ahead of the server's frames (otherwise, just show confirmed state)
+		LockstepGame game; //latest confirmed state (when not rolling back)
+		RollbackGame predicted; //(when rolling back)
+		float tick_acc = 0.0f; //time not yet simulated by predicted
+		uint32_t downs = 0; //local presses not yet used by a predicted tick
+		int8_t seat = -1;
+		uint32_t desyncs = 0; //ticks where our state hash didn't match the server's
+	} lockstep;
+
+	//otherwise, the local player's hands and stamina are predicted from our own input
+	// (so they respond the frame a key is pressed rather than a round trip later),
+	// and corrected as each state message arrives:
+	struct Prediction {
+		//our input for each client tick not yet reflected in the server's state, with what we predicted for it:
+		struct Tick {
+			uint32_t tick = 0;
+			Player::Controls controls; //(buttons held at the end of the tick, presses during it)
+			float stamina = 0.0f; //after the tick
+			Hand left_hand = Hand::None, right_hand = Hand::None;
+		};
+		std::deque< Tick > pending;
+		static constexpr size_t MaxPending = 90; //(older input is assumed to have been played)
+
+		Player server; //local player as of the latest state message
+		bool server_active = false; //(was the match running, so stamina changes?)
+		bool have_server = false;
+
+		float stamina_offset = 0.0f; //correction still being blended in on screen
+
+		//prediction error, checked against each state message:
+		static constexpr size_t History = 120;
+		std::array< float, History > stamina_errors{}; //(ring, by state message)
+		std::array< bool, History > hand_misses{};
+		uint32_t checked = 0; //state messages compared
+	} prediction;
+	bool show_prediction = false; //debug overlay (F3)
+
+	//time from key presses to the server's response being drawn (reported on exit and in the F3 overlay):
+	LatencyTrace latency;
+
+	//file this frame's input with the tick it was sent for:
+	void record_prediction_input(uint32_t tick);
+	//a state message arrived reflecting our input before 'input_tick':
+	void reconcile_prediction(uint32_t input_tick);
+	//re-run our pending input on top of the server's state of the local player:
+	void replay_prediction();
+
 	//last message from server:
 	std::string server_message;
 
@@ -102,6 +166,10 @@ struct PlayMode : Mode {
 
 		//texture object that will store tile table:
 		GLuint tile_tex = 0;
+
+		//(estimated) GPU memory for the above:
+		Memory::Tracked vertex_memory{Memory::StreamBuffersGL};
+		Memory::Tracked tile_memory{Memory::TexturesGL};
 	};
 
 	// Adapted from PPU466
@@ -0,0 +1,373 @@
+#include "Replay.hpp"
+
+//--------- OS-specific file mapping headers ---------
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN 1
+#endif
+#undef APIENTRY
+#include <windows.h>
+#undef max
+#undef min
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <cassert>
+
+static constexpr uint32_t ReplayVersion = 1;
+static constexpr size_t HeaderSize = 4 + 4 + 4 + 4;
+static constexpr size_t TrailerSize = 8 + 4;
+
+//append raw bytes of a value:
+template< typename T >
+static void append(std::vector< uint8_t > *to, T const &val) {
+	to->insert(to->end(), reinterpret_cast< uint8_t const * >(&val), reinterpret_cast< uint8_t const * >(&val) + sizeof(val));
+}
+
+ReplayWriter::ReplayWriter(std::string const &path, uint32_t keyframe_interval_) : keyframe_interval(keyframe_interval_) {
+	if (keyframe_interval == 0) throw std::runtime_error("Replay keyframe interval must be at least one tick.");
+	file = std::fopen(path.c_str(), "wb");
+	if (!file) throw std::runtime_error("Failed to open replay file '" + path + "' for writing.");
+
+	buffer.reserve(FlushSize);
+	buffer.insert(buffer.end(), {'r', 'p', 'l', 'y'});
+	append(&buffer, ReplayVersion);
+	append(&buffer, Game::Tick);
+	append(&buffer, keyframe_interval);
+
+	writer = std::thread([this](){
+		std::vector< uint8_t > bytes;
+		bool failed = false;
+		while (true) {
+			bool finishing = closing.load(std::memory_order_acquire);
+			while (to_disk.pop(&bytes)) {
+				if (!failed && std::fwrite(bytes.data(), 1, bytes.size(), file) != bytes.size()) {
+					std::cerr << "[ReplayWriter] failed to write to replay file; the rest of the replay will be lost." << std::endl;
+					failed = true;
+				}
+				std::fflush(file);
+				bytes.clear();
+				from_disk.push(std::move(bytes)); //(just dropped if the simulation thread has plenty)
+			}
+			if (finishing) break;
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		}
+	});
+}
+
+ReplayWriter::~ReplayWriter() {
+	//index, then trailer pointing at it:
+	uint64_t index_offset = buffer_offset + buffer.size();
+	buffer.emplace_back(uint8_t('I'));
+	append(&buffer, tick);
+	append(&buffer, uint32_t(keyframes.size()));
+	for (auto const &[kf_tick, kf_offset] : keyframes) {
+		append(&buffer, kf_tick);
+		append(&buffer, kf_offset);
+	}
+	append(&buffer, index_offset);
+	buffer.insert(buffer.end(), {'r', 'p', 'i', 'x'});
+
+	//(shutting down, so waiting on the disk is fine here)
+	while (!to_disk.push(std::move(buffer))) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	closing.store(true, std::memory_order_release);
+	writer.join();
+	std::fclose(file);
+
+	if (overflows) {
+		std::cerr << "[ReplayWriter] writer thread fell behind " << overflows << " times." << std::endl;
+	}
+}
+
+void ReplayWriter::record(Game const &game) {
+	bool players_changed = (game.seats != last_seats);
+	bool keyframe = players_changed || tick % keyframe_interval == 0;
+	if (keyframe) {
+		game.save_checkpoint(&checkpoint);
+		keyframes.emplace_back(tick, buffer_offset + buffer.size());
+		buffer.emplace_back(uint8_t('K'));
+		buffer.emplace_back(uint8_t(players_changed ? 1 : 0));
+		append(&buffer, tick);
+		append(&buffer, uint32_t(checkpoint.size()));
+		buffer.insert(buffer.end(), checkpoint.begin(), checkpoint.end());
+		if (players_changed) last_seats = game.seats;
+	}
+
+	buffer.emplace_back(uint8_t('T'));
+	size_t count_at = buffer.size();
+	buffer.emplace_back(uint8_t(0));
+	for (size_t i = 0; i < game.seats.size(); ++i) {
+		Player const *player = game.seat(int8_t(i));
+		if (!player) continue;
+		buffer[count_at] += 1;
+		uint8_t pressed = 0, downs_mask = 0;
+		for (uint32_t b = 0; b < 4; ++b) {
+			if (player->controls.left_buttons[b].pressed) pressed |= uint8_t(1 << b);
+			if (player->controls.right_buttons[b].pressed) pressed |= uint8_t(1 << (4 + b));
+			if (player->controls.left_buttons[b].downs) downs_mask |= uint8_t(1 << b);
+			if (player->controls.right_buttons[b].downs) downs_mask |= uint8_t(1 << (4 + b));
+		}
+		buffer.emplace_back(pressed);
+		buffer.emplace_back(downs_mask);
+		for (uint32_t b = 0; b < 4; ++b) {
+			if (player->controls.left_buttons[b].downs) buffer.emplace_back(player->controls.left_buttons[b].downs);
+		}
+		for (uint32_t b = 0; b < 4; ++b) {
+			if (player->controls.right_buttons[b].downs) buffer.emplace_back(player->controls.right_buttons[b].downs);
+		}
+	}
+	tick += 1;
+
+	//keyframes are flushed right away so a crash loses at most one keyframe interval:
+	if (keyframe || buffer.size() >= FlushSize) flush();
+}
+
+void ReplayWriter::flush() {
+	if (buffer.empty()) return;
+	size_t bytes = buffer.size();
+	if (!to_disk.push(std::move(buffer))) {
+		//writer thread is behind; keep appending and try again later:
+		overflows.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	buffer_offset += bytes;
+	if (!from_disk.pop(&buffer)) buffer = std::vector< uint8_t >();
+	buffer.clear();
+	buffer.reserve(FlushSize);
+}
+
+//-----------------------------------------
+
+//bounds-checked reads from the mapped file:
+namespace {
+struct FileReader {
+	uint8_t const *data;
+	uint64_t at;
+	uint64_t end;
+	template< typename T >
+	T read() {
+		if (end - at < sizeof(T)) throw std::runtime_error("Replay record runs past end of file.");
+		T val;
+		std::memcpy(&val, data + at, sizeof(T));
+		at += sizeof(T);
+		return val;
+	}
+	uint8_t const *skip(uint64_t bytes) {
+		if (end - at < bytes) throw std::runtime_error("Replay record runs past end of file.");
+		uint8_t const *ret = data + at;
+		at += bytes;
+		return ret;
+	}
+};
+}
+
+ReplayReader::ReplayReader(std::string const &path) {
+#ifdef _WIN32
+	file_handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file_handle == INVALID_HANDLE_VALUE) throw std::runtime_error("Failed to open replay file '" + path + "'.");
+	LARGE_INTEGER file_size;
+	GetFileSizeEx(file_handle, &file_size);
+	size = uint64_t(file_size.QuadPart);
+	if (size) {
+		mapping_handle = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping_handle) data = reinterpret_cast< uint8_t const * >(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+		if (!data) {
+			if (mapping_handle) CloseHandle(mapping_handle);
+			CloseHandle(file_handle);
+			throw std::runtime_error("Failed to map replay file '" + path + "'.");
+		}
+	}
+#else
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0) throw std::runtime_error("Failed to open replay file '" + path + "': " + std::strerror(errno));
+	struct stat info;
+	if (fstat(fd, &info) != 0) {
+		close(fd);
+		throw std::runtime_error("Failed to stat replay file '" + path + "'.");
+	}
+	size = uint64_t(info.st_size);
+	if (size) {
+		void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (mapped == MAP_FAILED) {
+			close(fd);
+			throw std::runtime_error("Failed to map replay file '" + path + "': " + std::strerror(errno));
+		}
+		data = reinterpret_cast< uint8_t const * >(mapped);
+	}
+	close(fd); //(the mapping stays valid)
+#endif
+
+	try {
+		FileReader header{data, 0, size};
+		uint8_t const *magic = header.skip(4);
+		if (std::memcmp(magic, "rply", 4) != 0) throw std::runtime_error("'" + path + "' is not a replay file.");
+		uint32_t version = header.read< uint32_t >();
+		if (version != ReplayVersion) throw std::runtime_error("Unknown replay version " + std::to_string(version) + ".");
+		tick_length = header.read< float >();
+		keyframe_interval = header.read< uint32_t >();
+
+		//index written at close:
+		if (size >= HeaderSize + TrailerSize && std::memcmp(data + size - 4, "rpix", 4) == 0) {
+			uint64_t index_offset;
+			std::memcpy(&index_offset, data + size - TrailerSize, 8);
+			if (index_offset < HeaderSize || index_offset >= size - TrailerSize || data[index_offset] != 'I') throw std::runtime_error("Replay index offset is invalid.");
+			FileReader index{data, index_offset + 1, size - TrailerSize};
+			ticks = index.read< uint32_t >();
+			keyframes.resize(index.read< uint32_t >());
+			for (auto &kf : keyframes) {
+				kf.tick = index.read< uint32_t >();
+				kf.offset = index.read< uint64_t >();
+				if (kf.offset < HeaderSize || kf.offset >= index_offset || data[kf.offset] != 'K') throw std::runtime_error("Replay index points at something that isn't a keyframe.");
+			}
+			if (index.at != index.end) throw std::runtime_error("Trailing data in replay index.");
+			records_end = index_offset;
+			indexed = true;
+		} else {
+			//no index (recording didn't finish); rebuild it from the records:
+			FileReader records{data, HeaderSize, size};
+			records_end = HeaderSize;
+			try {
+				while (records.at < records.end) {
+					uint64_t start = records.at;
+					uint8_t type = records.read< uint8_t >();
+					if (type == 'K') {
+						records.read< uint8_t >();
+						uint32_t kf_tick = records.read< uint32_t >();
+						records.skip(records.read< uint32_t >());
+						keyframes.emplace_back(Keyframe{kf_tick, start});
+					} else if (type == 'T') {
+						uint8_t count = records.read< uint8_t >();
+						for (uint32_t p = 0; p < count; ++p) {
+							records.read< uint8_t >();
+							uint8_t downs_mask = records.read< uint8_t >();
+							records.skip(std::popcount(downs_mask));
+						}
+						ticks += 1;
+					} else {
+						throw std::runtime_error("Unknown replay record type.");
+					}
+					records_end = records.at;
+				}
+			} catch (std::runtime_error &) {
+				//(truncated or damaged final record; keep everything before it)
+				if (!keyframes.empty() && keyframes.back().offset >= records_end) keyframes.pop_back();
+			}
+		}
+		if (!std::is_sorted(keyframes.begin(), keyframes.end(), [](Keyframe const &a, Keyframe const &b){ return a.tick < b.tick; })) {
+			throw std::runtime_error("Replay keyframes are out of order.");
+		}
+	} catch (...) {
+		unmap();
+		throw;
+	}
+
+	cursor = records_end;
+	position = ticks;
+}
+
+ReplayReader::~ReplayReader() {
+	unmap();
+}
+
+void ReplayReader::unmap() {
+#ifdef _WIN32
+	if (data) UnmapViewOfFile(data);
+	if (mapping_handle) CloseHandle(mapping_handle);
+	if (file_handle) CloseHandle(file_handle);
+	mapping_handle = file_handle = nullptr;
+#else
+	if (data) munmap(const_cast< uint8_t * >(data), size);
+#endif
+	data = nullptr;
+}
+
+void ReplayReader::seek(uint32_t tick, Game *game) {
+	assert(game);
+	tick = std::min(tick, ticks);
+
+	//latest keyframe at or before 'tick':
+	auto after = std::upper_bound(keyframes.begin(), keyframes.end(), tick, [](uint32_t t, Keyframe const &kf){ return t < kf.tick; });
+	if (after == keyframes.begin()) throw std::runtime_error("Replay has no keyframe at or before tick " + std::to_string(tick) + ".");
+	Keyframe const &keyframe = *(after - 1);
+
+	FileReader record{data, keyframe.offset + 1, records_end};
+	record.read< uint8_t >(); //(forced flag)
+	if (record.read< uint32_t >() != keyframe.tick) throw std::runtime_error("Replay keyframe tick doesn't match index.");
+	uint32_t checkpoint_size = record.read< uint32_t >();
+	game->load_checkpoint(record.skip(checkpoint_size), checkpoint_size);
+
+	cursor = record.at;
+	position = keyframe.tick;
+	while (position < tick) {
+		if (!step(game)) break;
+	}
+}
+
+bool ReplayReader::step(Game *game, uint32_t *mismatched) {
+	assert(game);
+	FileReader record{data, cursor, records_end};
+	uint8_t const *expected = nullptr; //(periodic keyframe to check against, once inputs are applied)
+	uint32_t expected_size = 0;
+	while (record.at < record.end) {
+		uint8_t type = record.read< uint8_t >();
+		if (type == 'K') {
+			bool forced = (record.read< uint8_t >() != 0);
+			uint32_t kf_tick = record.read< uint32_t >();
+			uint32_t checkpoint_size = record.read< uint32_t >();
+			uint8_t const *checkpoint = record.skip(checkpoint_size);
+			if (kf_tick != position) throw std::runtime_error("Replay keyframe for tick " + std::to_string(kf_tick) + " found at tick " + std::to_string(position) + ".");
+			if (forced) {
+				//players came or went; the input log can't reproduce that, so take the recorded state:
+				game->load_checkpoint(checkpoint, checkpoint_size);
+			} else {
+				expected = checkpoint;
+				expected_size = checkpoint_size;
+			}
+		} else if (type == 'T') {
+			uint8_t count = record.read< uint8_t >();
+			uint8_t seated = 0;
+			for (size_t i = 0; i < game->seats.size(); ++i) {
+				Player *player = game->seat(int8_t(i));
+				if (!player) continue;
+				if (++seated > count) break;
+				uint8_t pressed = record.read< uint8_t >();
+				uint8_t downs_mask = record.read< uint8_t >();
+				auto set = [&](std::array< Button, 4 > &buttons, uint32_t shift) {
+					for (uint32_t b = 0; b < 4; ++b) {
+						buttons[b].pressed = (pressed >> (shift + b)) & 1;
+						buttons[b].downs = ((downs_mask >> (shift + b)) & 1) ? record.read< uint8_t >() : 0;
+					}
+				};
+				set(player->controls.left_buttons, 0);
+				set(player->controls.right_buttons, 4);
+			}
+			if (seated != count) throw std::runtime_error("Replay input record for " + std::to_string(count) + " players, but game has " + std::to_string(seated) + ".");
+			if (mismatched && expected) {
+				//(keyframes include held buttons, so compare after this tick's inputs are in place)
+				std::vector< uint8_t > simulated;
+				game->save_checkpoint(&simulated);
+				if (simulated.size() != expected_size || std::memcmp(simulated.data(), expected, expected_size) != 0) *mismatched += 1;
+			}
+			game->update(tick_length);
+			position += 1;
+			cursor = record.at;
+			return true;
+		} else {
+			throw std::runtime_error("Unknown replay record type '" + std::to_string(type) + "'.");
+		}
+	}
+	cursor = record.at;
+	return false;
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+/*
+ * Match replays: a per-tick input log with periodic full-state keyframes,
+ * so any tick can be reached by loading the keyframe before it and running
+ * at most one keyframe interval of Game::update.
+ *
+ * File layout (little-endian, like the network messages):
+ *  header: "rply" u32 version, f32 tick length, u32 keyframe interval
+ *  records, one of:
+ *   'K' u8 forced, u32 tick, u32 size, Game checkpoint[size]
+ *        -- state at the start of 'tick' (the checkpoint's held buttons are that tick's inputs).
+ *           'forced' keyframes are written when the players change (so the input log alone
+ *           can't continue).
+ *   'T' u8 player count, then for each player, in seat order:
+ *        u8 pressed (bits 0-3: left buttons, 4-7: right buttons), u8 downs mask,
+ *        one u8 downs count per set bit of the downs mask
+ *        -- the controls every player had when 'update' ran (one record per tick).
+ *   'I' u32 ticks, u32 count, count x (u32 tick, u64 file offset of 'K' record)
+ *        -- keyframe index, written when the recording is closed.
+ *  trailer: u64 file offset of 'I' record, "rpix"
+ *
+ * If the server stopped without closing the file, the reader rebuilds the
+ * index by scanning the records (and ignores a truncated final record).
+ *
+ * Server:
+ *  ReplayWriter replay("match.rply");
+ *  replay.record(game); game.update(Game::Tick); //every tick
+ *
+ * Reader (see replay-player.cpp):
+ *  ReplayReader replay("match.rply");
+ *  replay.seek(tick, &game); //game is now at the start of 'tick'
+ *  while (replay.step(&game)) { ... } //runs one tick per call
+ */
+
+#include "Game.hpp"
+#include "SPSCQueue.hpp"
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cstdio>
+#include <cstdint>
+
+struct ReplayWriter {
+	//opens (and truncates) the file; throws if it can't be opened:
+	ReplayWriter(std::string const &path, uint32_t keyframe_interval = 150);
+	//writes the keyframe index and closes the file:
+	~ReplayWriter();
+
+	//log the state of 'game' just before it is updated:
+	void record(Game const &game);
+
+	uint32_t keyframe_interval;
+	uint32_t tick = 0; //ticks recorded so far
+
+	//keyframes written so far (for the index):
+	std::vector< std::pair< uint32_t, uint64_t > > keyframes;
+	std::vector< PlayerHandle > last_seats; //(to notice players coming and going)
+	std::vector< uint8_t > checkpoint; //(scratch space for keyframes)
+
+	//records are appended to 'buffer' on the simulation thread; full buffers are
+	// handed to a writer thread so the simulation never waits on the disk:
+	static constexpr size_t FlushSize = 64 * 1024;
+	std::vector< uint8_t > buffer;
+	uint64_t buffer_offset = 0; //file offset of buffer[0]
+	void flush(); //hand 'buffer' to the writer thread (if it has room)
+
+	SPSCQueue< std::vector< uint8_t >, 16 > to_disk; //(full buffers)
+	SPSCQueue< std::vector< uint8_t >, 16 > from_disk; //(empty buffers, for reuse)
+	std::atomic< bool > closing{false};
+	std::atomic< uint32_t > overflows{0}; //times the writer thread fell behind (buffer kept growing)
+	std::FILE *file = nullptr;
+	std::thread writer;
+};
+
+struct ReplayReader {
+	//maps the file into memory; throws if it isn't a replay:
+	ReplayReader(std::string const &path);
+	~ReplayReader();
+
+	ReplayReader(ReplayReader const &) = delete;
+	ReplayReader &operator=(ReplayReader const &) = delete;
+
+	float tick_length = Game::Tick;
+	uint32_t keyframe_interval = 0;
+	uint32_t ticks = 0; //number of ticks in the log
+	bool indexed = false; //false if the index was missing and had to be rebuilt
+
+	struct Keyframe {
+		uint32_t tick;
+		uint64_t offset;
+	};
+	std::vector< Keyframe > keyframes; //(sorted by tick)
+
+	//put 'game' at the start of 'tick' (clamped to [0, ticks]):
+	void seek(uint32_t tick, Game *game);
+
+	//apply the inputs for tick 'position' to 'game' and update it;
+	// returns false (and does nothing) at the end of the log.
+	//If 'mismatched' is given, periodic keyframes passed along the way are compared
+	// with the simulated state, and the count of differing ones is added to it.
+	bool step(Game *game, uint32_t *mismatched = nullptr);
+
+	uint32_t position = 0; //tick 'game' is at (after seek/step)
+	uint64_t cursor = 0; //file offset of the next record
+
+	//mapped file:
+	uint8_t const *data = nullptr;
+	uint64_t size = 0;
+	uint64_t records_end = 0; //(where the index starts, or end of the last whole record)
+	void unmap();
+#ifdef _WIN32
+	void *file_handle = nullptr;
+	void *mapping_handle = nullptr;
+#endif
+};
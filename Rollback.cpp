@@ -0,0 +1,78 @@
+#include "Rollback.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <cassert>
+
+void RollbackGame::start(LockstepGame const &game, int8_t seat_) {
+	seat = seat_;
+	confirmed_tick = game.tick;
+	confirmed_inputs = LockstepGame::Inputs(); //(everyone starts with nothing held)
+	current = game;
+}
+
+bool RollbackGame::predict(LockstepGame::Input local) {
+	assert(current.tick >= confirmed_tick);
+	if (current.tick - confirmed_tick >= MaxAhead) {
+		stalls += 1;
+		return false;
+	}
+
+	Entry &entry = ring[current.tick % Ring];
+	entry.before = current;
+	//remote players keep holding whatever they held last, but don't press anything new:
+	for (uint32_t s = 0; s < LockstepGame::Seats; ++s) {
+		entry.inputs[s].pressed = confirmed_inputs[s].pressed;
+		entry.inputs[s].downs = 0;
+	}
+	if (seat >= 0) entry.inputs[seat] = local;
+
+	current.update(entry.inputs);
+	return true;
+}
+
+bool RollbackGame::confirm(LockstepFrame const &frame) {
+	if (frame.tick != confirmed_tick) throw std::runtime_error("Rollback expected frame for tick " + std::to_string(confirmed_tick) + ", got " + std::to_string(frame.tick) + ".");
+	confirmed_tick += 1;
+	confirmed_inputs = frame.inputs;
+
+	if (frame.tick == current.tick) {
+		//server is ahead of our predictions; just apply its frame:
+		ring[frame.tick % Ring] = Entry{current, frame.inputs};
+		current.update(frame.inputs);
+		return current.hash() == frame.hash;
+	}
+
+	Entry &entry = ring[frame.tick % Ring];
+	if (entry.inputs != frame.inputs) {
+		entry.inputs = frame.inputs;
+		//later ticks predicted remote players from older inputs; re-predict them from these:
+		for (uint32_t t = frame.tick + 1; t < current.tick; ++t) {
+			LockstepGame::Inputs &inputs = ring[t % Ring].inputs;
+			for (uint32_t s = 0; s < LockstepGame::Seats; ++s) {
+				if (int8_t(s) == seat) continue;
+				inputs[s].pressed = confirmed_inputs[s].pressed;
+				inputs[s].downs = 0;
+			}
+		}
+		rollbacks += 1;
+		resimulate(frame.tick);
+	}
+
+	//state after the confirmed tick is either the next snapshot or the present:
+	LockstepGame const &after = (frame.tick + 1 == current.tick ? current : ring[(frame.tick + 1) % Ring].before);
+	return after.hash() == frame.hash;
+}
+
+void RollbackGame::resimulate(uint32_t tick) {
+	assert(tick <= current.tick && current.tick - tick <= MaxAhead);
+	uint32_t end = current.tick;
+	LockstepGame state = ring[tick % Ring].before;
+	for (uint32_t t = tick; t < end; ++t) {
+		Entry &entry = ring[t % Ring];
+		entry.before = state;
+		state.update(entry.inputs);
+	}
+	resimulated_ticks += end - tick;
+	current = state;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+/*
+ * Client-side rollback for lockstep mode.
+ *
+ * Instead of waiting a round trip for the server's frame, the client advances
+ * its own copy of the LockstepGame every tick using its local input and a
+ * prediction of everyone else's (their last confirmed buttons, no new presses).
+ *
+ * The state before every predicted tick is kept in a ring of snapshots. When
+ * the server's frame for a tick arrives with inputs that differ from the
+ * prediction, the game is rolled back to that tick's snapshot and the
+ * remaining predicted ticks are re-simulated with the corrected inputs.
+ *
+ * RollbackGame rollback;
+ * rollback.start(game, seat); //(from a lockstep start message)
+ * ...
+ * rollback.predict(local_input); //once per Game::Tick
+ * ...
+ * rollback.confirm(frame); //for every lockstep frame, in order
+ * ...
+ * rollback.current //best guess at the present state, for drawing
+ */
+
+#include "Lockstep.hpp"
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+struct RollbackGame {
+	//snapshots are plain copies of the game state:
+	static_assert(std::is_trivially_copyable_v< LockstepGame >, "LockstepGame snapshots must be memcpy-able.");
+
+	static constexpr uint32_t Ring = 32; //snapshots kept (must be > MaxAhead)
+	static constexpr uint32_t MaxAhead = 16; //predict at most this many ticks past the last confirmed one
+	static_assert(Ring > MaxAhead, "ring must hold every unconfirmed tick");
+
+	void start(LockstepGame const &game, int8_t seat);
+
+	//advance 'current' by one tick with a predicted input for every seat;
+	// returns false (and does nothing) if already MaxAhead ticks past the confirmed tick:
+	bool predict(LockstepGame::Input local);
+
+	//apply the server's inputs for tick confirmed_tick, rolling back if they weren't what we predicted;
+	// returns false if the server's state hash doesn't match ours (a desync):
+	bool confirm(LockstepFrame const &frame);
+
+	//restore the snapshot taken before 'tick' and re-run every tick up to current.tick:
+	// (tick must be in [current.tick - MaxAhead, current.tick])
+	void resimulate(uint32_t tick);
+
+	int8_t seat = -1;
+	uint32_t confirmed_tick = 0; //frames for every tick before this one have arrived
+	LockstepGame::Inputs confirmed_inputs; //inputs from the latest confirmed frame (used to predict remote seats)
+	LockstepGame current; //predicted state (current.tick >= confirmed_tick)
+
+	struct Entry {
+		LockstepGame before; //state before this tick's update
+		LockstepGame::Inputs inputs; //inputs used for this tick (predicted or confirmed)
+	};
+	std::array< Entry, Ring > ring; //indexed by tick % Ring
+
+	//stats:
+	uint32_t rollbacks = 0; //frames that disagreed with the prediction
+	uint32_t resimulated_ticks = 0; //total ticks re-run by rollbacks
+	uint32_t stalls = 0; //predict() calls refused because we were too far ahead
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+/*
+ * SPSCQueue is a fixed-capacity, lock-free ring buffer used to hand values
+ * from exactly one producer thread to exactly one consumer thread.
+ *
+ * For example (server.cpp):
+ *
+ * SPSCQueue< Event, 1024 > events;
+ *
+ * //network thread:
+ * if (!events.push(std::move(evt))) { ...queue full; try again later... }
+ *
+ * //simulation thread:
+ * Event evt;
+ * while (events.pop(&evt)) { ... }
+ *
+ * NOTE: push() must only ever be called from one thread, and pop() from one
+ *  (possibly different) thread.
+ */
+
+#include <atomic>
+#include <array>
+#include <cstddef>
+#include <utility>
+
+template< typename T, size_t Capacity >
+struct SPSCQueue {
+	static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SPSCQueue capacity must be a power of two.");
+
+	//(producer) add a value to the back of the queue:
+	// returns 'false' (and leaves value untouched) if the queue is full.
+	bool push(T &&value) {
+		size_t t = tail.load(std::memory_order_relaxed);
+		if (t - head.load(std::memory_order_acquire) == Capacity) return false;
+		slots[t & (Capacity - 1)] = std::move(value);
+		tail.store(t + 1, std::memory_order_release);
+		return true;
+	}
+
+	//(consumer) remove a value from the front of the queue:
+	// returns 'false' if the queue is empty.
+	bool pop(T *value) {
+		size_t h = head.load(std::memory_order_relaxed);
+		if (h == tail.load(std::memory_order_acquire)) return false;
+		*value = std::move(slots[h & (Capacity - 1)]);
+		head.store(h + 1, std::memory_order_release);
+		return true;
+	}
+
+	//number of queued values; exact when called by producer or consumer, approximate otherwise:
+	size_t size() const {
+		return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+	}
+
+	static constexpr size_t capacity() { return Capacity; }
+
+	//internals:
+	//head and tail are kept on separate cache lines so the two threads don't fight over them:
+	alignas(64) std::atomic< size_t > head{0}; //index of next value to pop (written by consumer)
+	alignas(64) std::atomic< size_t > tail{0}; //index of next slot to push (written by producer)
+	alignas(64) std::array< T, Capacity > slots;
+};
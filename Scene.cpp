@@ -2,6 +2,8 @@
 
 #include "gl_errors.hpp"
 #include "read_write_chunk.hpp"
+#include "LoadProfile.hpp"
+#include "FlightRecorder.hpp"
 
 #include <glm/gtc/type_ptr.hpp>
 
@@ -88,6 +90,7 @@ void Scene::draw(Camera const &camera) const {
 }
 
 void Scene::draw(glm::mat4 const &world_to_clip, glm::mat4x3 const &world_to_light) const {
+	RECORD_SCOPE("Scene::draw");
 
 	//Iterate through all drawables, sending each one to OpenGL:
 	for (auto const &drawable : drawables) {
@@ -168,8 +171,10 @@ void Scene::draw(glm::mat4 const &world_to_clip, glm::mat4x3 const &world_to_lig
 
 void Scene::load(std::string const &filename,
 	std::function< void(Scene &, Transform *, std::string const &) > const &on_drawable) {
+	RECORD_SCOPE("Scene::load");
 
 	std::ifstream file(filename, std::ios::binary);
+	LoadProfile::read_file(filename);
 
 	std::vector< char > names;
 	read_chunk(file, "str0", &names);
@@ -308,6 +313,8 @@ void Scene::load(std::string const &filename,
 		std::cerr << "WARNING: trailing data in scene file '" << filename << "'" << std::endl;
 	}
 
+	update_memory();
+
 
 
 }
@@ -348,7 +355,7 @@ void Scene::set(Scene const &other, std::unordered_map< Transform const *, Trans
 		transforms.back().parent = t.parent; //will update later
 
 		//store mapping between transforms old and new:
-		auto ret = transform_to_transform.insert(std::make_pair(&t, &transforms.back()));
+		[[maybe_unused]] auto ret = transform_to_transform.insert(std::make_pair(&t, &transforms.back()));
 		assert(ret.second);
 	}
 
@@ -374,4 +381,19 @@ void Scene::set(Scene const &other, std::unordered_map< Transform const *, Trans
 	for (auto &l : lights) {
 		l.transform = transform_to_transform.at(l.transform);
 	}
+
+	update_memory();
+}
+
+void Scene::update_memory() {
+	//(each list node is its element plus two pointers)
+	size_t bytes = 0;
+	for (auto const &t : transforms) {
+		bytes += sizeof(Transform) + 2 * sizeof(void *);
+		if (t.name.capacity() > std::string().capacity()) bytes += t.name.capacity() + 1;
+	}
+	bytes += drawables.size() * (sizeof(Drawable) + 2 * sizeof(void *));
+	bytes += cameras.size() * (sizeof(Camera) + 2 * sizeof(void *));
+	bytes += lights.size() * (sizeof(Light) + 2 * sizeof(void *));
+	memory.set(bytes);
 }
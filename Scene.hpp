@@ -11,6 +11,7 @@
  */
 
 #include "GL.hpp"
+#include "Memory.hpp"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
@@ -122,6 +123,10 @@ struct Scene {
 	std::list< Camera > cameras;
 	std::list< Light > lights;
 
+	//size of the lists above (and transform names), as of the last load() or set():
+	Memory::Tracked memory{Memory::SceneGraph};
+	void update_memory();
+
 	//The "draw" function provides a convenient way to pass all the things in a scene to OpenGL:
 	void draw(Camera const &camera) const;
 
@@ -0,0 +1,118 @@
+#pragma once
+
+/*
+ * SlotMap stores values contiguously (so iterating over them is a linear walk
+ * through memory) while handing out Handles that stay valid as other values
+ * come and go.
+ *
+ * SlotMap< Player > players;
+ * SlotMap< Player >::Handle handle = players.emplace();
+ * ...
+ * if (Player *player = players.get(handle)) { ... } //nullptr if 'handle' was erased
+ * ...
+ * players.erase(handle); //O(1): moves the last value into the hole
+ *
+ * Handles carry a generation count, so a handle to an erased value never
+ * refers to whatever value reuses its slot later.
+ *
+ * NOTE: pointers and references to values are invalidated by emplace() and
+ *  erase() (values move around); keep Handles instead.
+ */
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <utility>
+
+template< typename T >
+struct SlotMap {
+	struct Handle {
+		uint32_t slot = -1U;
+		uint32_t generation = 0;
+		bool operator==(Handle const &) const = default;
+	};
+
+	//add a value (at the back of the iteration order):
+	template< typename... Args >
+	Handle emplace(Args&&... args) {
+		uint32_t slot;
+		if (free_head != -1U) {
+			slot = free_head;
+			free_head = slots[slot].index;
+		} else {
+			slot = uint32_t(slots.size());
+			slots.emplace_back();
+		}
+		slots[slot].index = uint32_t(values.size());
+		values.emplace_back(std::forward< Args >(args)...);
+		value_slots.emplace_back(slot);
+		return Handle{slot, slots[slot].generation};
+	}
+
+	//remove a value (does nothing if handle is stale):
+	// the last value moves into its place, so iteration order changes.
+	void erase(Handle handle) {
+		if (!contains(handle)) return;
+		uint32_t index = slots[handle.slot].index;
+		if (index + 1 != values.size()) {
+			values[index] = std::move(values.back());
+			value_slots[index] = value_slots.back();
+			slots[value_slots[index]].index = index;
+		}
+		values.pop_back();
+		value_slots.pop_back();
+
+		slots[handle.slot].generation += 1; //outstanding handles are now stale
+		slots[handle.slot].index = free_head;
+		free_head = handle.slot;
+	}
+
+	void clear() {
+		while (!values.empty()) erase(handle_at(values.size() - 1));
+	}
+
+	bool contains(Handle handle) const {
+		return handle.slot < slots.size() && slots[handle.slot].generation == handle.generation
+			&& slots[handle.slot].index < values.size() && value_slots[slots[handle.slot].index] == handle.slot;
+	}
+
+	//value for handle, or nullptr if the handle is stale:
+	T *get(Handle handle) {
+		return contains(handle) ? &values[slots[handle.slot].index] : nullptr;
+	}
+	T const *get(Handle handle) const {
+		return contains(handle) ? &values[slots[handle.slot].index] : nullptr;
+	}
+
+	//handle for the value at a given position in iteration order:
+	Handle handle_at(size_t index) const {
+		assert(index < values.size());
+		return Handle{value_slots[index], slots[value_slots[index]].generation};
+	}
+
+	size_t size() const { return values.size(); }
+	bool empty() const { return values.empty(); }
+
+	T &operator[](size_t index) { return values[index]; }
+	T const &operator[](size_t index) const { return values[index]; }
+	T &front() { return values.front(); }
+	T const &front() const { return values.front(); }
+	T &back() { return values.back(); }
+	T const &back() const { return values.back(); }
+
+	typename std::vector< T >::iterator begin() { return values.begin(); }
+	typename std::vector< T >::iterator end() { return values.end(); }
+	typename std::vector< T >::const_iterator begin() const { return values.begin(); }
+	typename std::vector< T >::const_iterator end() const { return values.end(); }
+
+	//internals:
+	std::vector< T > values; //dense storage
+	std::vector< uint32_t > value_slots; //slot that refers to each value
+	struct Slot {
+		uint32_t index = 0; //position in values (or, for free slots, the next free slot)
+		uint32_t generation = 0; //incremented on erase
+	};
+	std::vector< Slot > slots;
+	uint32_t free_head = -1U; //first free slot
+};
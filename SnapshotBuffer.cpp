@@ -0,0 +1,116 @@
+#include "SnapshotBuffer.hpp"
+
+#include "Game.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+void SnapshotBuffer::push(uint32_t tick, std::vector< float > const &values, bool cut, double now) {
+	double time = tick * double(Game::Tick);
+	double offset = now - time;
+
+	if (!snapshots.empty() && time <= snapshots.back().time) {
+		//(arrived after a newer one; there's nothing left to use it for)
+		dropped += 1;
+		return;
+	}
+
+	if (!started) {
+		started = true;
+		offset_min = offset_min_prev = offset;
+		jitter_peak = jitter_peak_prev = 0.0;
+		window_start = now;
+	}
+
+	//arrival statistics, over the current and previous window:
+	if (now - window_start >= WindowSeconds) {
+		offset_min_prev = offset_min;
+		offset_min = offset;
+		jitter_peak_prev = jitter_peak;
+		jitter_peak = 0.0;
+		window_start = now;
+	}
+	offset_min = std::min(offset_min, offset);
+	double jitter = offset - std::min(offset_min, offset_min_prev);
+	jitter_peak = std::max(jitter_peak, jitter);
+	max_jitter = std::max(max_jitter, jitter);
+
+	if (!snapshots.empty()) {
+		double spacing = time - snapshots.back().time;
+		interval = (interval == 0.0 ? spacing : interval + 0.1 * (spacing - interval));
+	}
+
+	//(recycle the oldest snapshot's storage when full)
+	Snapshot snapshot;
+	if (snapshots.size() >= MaxSnapshots) {
+		snapshot = std::move(snapshots.front());
+		snapshots.pop_front();
+	}
+	snapshot.time = time;
+	snapshot.cut = cut || (!snapshots.empty() && snapshots.back().values.size() != values.size());
+	snapshot.values.assign(values.begin(), values.end());
+	snapshots.emplace_back(std::move(snapshot));
+}
+
+bool SnapshotBuffer::sample(double now, std::vector< float > *values_) {
+	assert(values_);
+	auto &values = *values_;
+	if (snapshots.empty()) return false;
+
+	//trail the fastest arrivals by one snapshot spacing (so there's a later snapshot to blend toward)
+	// plus the recent jitter (so that snapshot has usually arrived):
+	double target = interval + std::max(jitter_peak, jitter_peak_prev);
+	if (!sampled) {
+		delay = target;
+	} else {
+		//adapt gradually (shown time runs at most 10% fast or slow), so motion stays smooth:
+		double step = 0.1 * std::max(0.0, now - last_sample);
+		delay = std::clamp(target, delay - step, delay + step);
+	}
+
+	double time = now - std::min(offset_min, offset_min_prev) - delay;
+	if (sampled) time = std::max(time, shown);
+	sampled = true;
+	shown = time;
+	last_sample = now;
+
+	//snapshots before the one at or just before 'time' won't be needed again:
+	while (snapshots.size() > 2 && snapshots[1].time <= time) {
+		snapshots.pop_front();
+	}
+
+	auto blend = [&](Snapshot const &a, Snapshot const &b, double amt) {
+		values.resize(b.values.size());
+		for (size_t i = 0; i < values.size(); ++i) {
+			values[i] = float(a.values[i] + amt * (b.values[i] - a.values[i]));
+		}
+	};
+
+	Snapshot const &newest = snapshots.back();
+	if (time < snapshots.front().time) {
+		//(nothing that old; show the oldest)
+		values = snapshots.front().values;
+	} else if (time < newest.time) {
+		auto b = std::upper_bound(snapshots.begin(), snapshots.end(), time, [](double t, Snapshot const &s) { return t < s.time; });
+		assert(b != snapshots.begin() && b != snapshots.end());
+		auto a = b - 1;
+		if (b->cut) values = a->values;
+		else blend(*a, *b, (time - a->time) / (b->time - a->time));
+	} else {
+		//past the newest snapshot; continue its motion for a bit:
+		extrapolated += 1;
+		double past = time - newest.time;
+		if (past > MaxExtrapolation) {
+			held += 1;
+			past = MaxExtrapolation;
+		}
+		if (snapshots.size() >= 2 && !newest.cut) {
+			Snapshot const &before = snapshots[snapshots.size() - 2];
+			blend(before, newest, 1.0 + past / (newest.time - before.time));
+		} else {
+			values = newest.values;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+/*
+ * SnapshotBuffer is the client's view of state that arrives in snapshots
+ * (the score point, the other players' stamina).
+ *
+ * Snapshots are stamped with the server tick they were taken on. Rather than
+ * showing each one as it arrives (which steps at the server's send rate, and
+ * unevenly when the network jitters), the client shows the state as of a
+ * moment slightly in the past, interpolating between the snapshots on either
+ * side of it:
+ *
+ *  SnapshotBuffer snapshots;
+ *  snapshots.push(tick, values, cut, now); //as state messages arrive
+ *  snapshots.sample(now, &values); //every frame
+ *
+ * The delay adapts to the spacing of snapshots and the jitter of their
+ * arrivals (changing gradually, so shown time never jumps). If the next
+ * snapshot is late anyway, values are extrapolated along their last motion for
+ * a short while, then held.
+ */
+
+#include <vector>
+#include <deque>
+#include <cstdint>
+#include <cstddef>
+
+struct SnapshotBuffer {
+	static constexpr double MaxExtrapolation = 0.1; //seconds past the newest snapshot to keep extrapolating
+	static constexpr double WindowSeconds = 10.0; //how long arrival statistics are remembered
+	static constexpr size_t MaxSnapshots = 64; //(older snapshots are dropped)
+
+	//'values' as of server 'tick', arriving at client time 'now' (in seconds);
+	// 'cut' means the values jumped (match restarted, players changed) and shouldn't be blended with earlier ones:
+	void push(uint32_t tick, std::vector< float > const &values, bool cut, double now);
+
+	//values to show at client time 'now' (returns false if no snapshot has arrived yet):
+	bool sample(double now, std::vector< float > *values);
+
+	double delay = 0.0; //seconds the shown state trails the fastest arrivals (adapted)
+
+	//stats (since construction; see reset_stats):
+	uint32_t extrapolated = 0; //samples past the newest snapshot
+	uint32_t held = 0; //samples past the newest snapshot by more than MaxExtrapolation
+	uint32_t dropped = 0; //snapshots that arrived out of order
+	double max_jitter = 0.0; //largest lateness (in seconds) relative to the fastest arrivals
+	void reset_stats() { extrapolated = held = dropped = 0; max_jitter = 0.0; }
+
+	//---- internals ----
+	struct Snapshot {
+		double time = 0.0; //server time (tick * Game::Tick)
+		bool cut = false;
+		std::vector< float > values;
+	};
+	std::deque< Snapshot > snapshots; //(sorted by time)
+
+	bool started = false;
+	//client time - server time of the fastest arrival, over the last one or two windows
+	// (so the estimate can recover if the clocks drift):
+	double offset_min = 0.0, offset_min_prev = 0.0;
+	double jitter_peak = 0.0, jitter_peak_prev = 0.0; //(largest lateness in each window)
+	double window_start = 0.0;
+	double interval = 0.0; //typical server time between snapshots (smoothed)
+
+	bool sampled = false;
+	double shown = 0.0; //server time shown by the last sample (never goes backward)
+	double last_sample = 0.0; //client time of the last sample
+};
@@ -1,6 +1,7 @@
 #include "Sound.hpp"
 #include "load_wav.hpp"
 #include "load_opus.hpp"
+#include "FlightRecorder.hpp"
 
 #include <SDL.h>
 
@@ -39,6 +40,7 @@ void mix_audio(void *, Uint8 *buffer_, int len);
 //------------------------ public-facing --------------------------------
 
 Sound::Sample::Sample(std::string const &filename) {
+	RECORD_SCOPE("Sound::Sample::Sample");
 	if (filename.size() >= 4 && filename.substr(filename.size()-4) == ".wav") {
 		load_wav(filename, &data);
 	} else if (filename.size() >= 5 && filename.substr(filename.size()-5) == ".opus") {
@@ -46,9 +48,11 @@ Sound::Sample::Sample(std::string const &filename) {
 	} else {
 		throw std::runtime_error("Sample '" + filename + "' doesn't end in either \".png\" or \".opus\" -- unsure how to load.");
 	}
+	memory.set(data.capacity() * sizeof(float));
 }
 
 Sound::Sample::Sample(std::vector< float > const &data_) : data(data_) {
+	memory.set(data.capacity() * sizeof(float));
 }
 
 
@@ -312,6 +316,8 @@ void step_direction_ramp(Sound::Ramp< glm::vec3 > &ramp) {
 
 //The audio callback -- invoked by SDL when it needs more sound to play:
 void mix_audio(void *, Uint8 *buffer_, int len) {
+	RECORD_THREAD("audio"); //(SDL's audio thread)
+	RECORD_SCOPE("mix_audio");
 	assert(buffer_); //should always have some audio buffer
 
 	struct LR {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Memory.hpp"
+
 #include <glm/glm.hpp>
 
 #include <memory>
@@ -23,6 +25,7 @@ struct Sample {
 
 	//sample data is stored as 48kHz, mono, floating-point:
 	std::vector< float > data;
+	Memory::Tracked memory{Memory::SoundSamples}; //(size of data, as loaded)
 };
 
 //Ramp<> manages values that should be smoothly interpolated
@@ -0,0 +1,64 @@
+#include "TimingWheel.hpp"
+
+#include <cassert>
+
+void TimingWheel::Timer::cancel() {
+	if (!pprev) return;
+	*pprev = next;
+	if (next) next->pprev = pprev;
+	next = nullptr;
+	pprev = nullptr;
+	assert(wheel && wheel->count > 0);
+	wheel->count -= 1;
+	wheel = nullptr;
+}
+
+TimingWheel::TimingWheel(Tick now_) : now(now_) {
+}
+
+TimingWheel::~TimingWheel() {
+	//unlink any remaining timers so they don't point into a dead wheel:
+	for (auto &level : slots) {
+		for (auto &slot : level) {
+			while (slot) slot->cancel();
+		}
+	}
+}
+
+void TimingWheel::schedule(Timer *timer, Tick expires) {
+	assert(timer);
+	timer->cancel();
+	timer->expires = expires;
+	timer->wheel = this;
+	count += 1;
+	link(timer, false);
+}
+
+void TimingWheel::link(Timer *timer, bool cascading) {
+	//deadlines in the past go in the next slot to be processed:
+	// (when cascading, the current tick's slot is about to be processed, so it is fine to use it)
+	Tick at = timer->expires;
+	if (cascading) {
+		if (at < now) at = now;
+	} else {
+		if (at <= now) at = now + 1;
+	}
+
+	if ((at >> (SlotBits * Levels)) != (now >> (SlotBits * Levels))) {
+		//beyond the range of the wheel: file as far out as possible, advance() will re-file it when it gets there.
+		at = now | ((Tick(1) << (SlotBits * Levels)) - 1);
+		if (at == now) at = now + 1;
+	}
+
+	//find the coarsest bits in which 'at' differs from 'now':
+	uint32_t level = 0;
+	while (level + 1 < Levels && (at >> (SlotBits * (level + 1))) != (now >> (SlotBits * (level + 1)))) {
+		level += 1;
+	}
+
+	Timer *&slot = slots[level][(at >> (SlotBits * level)) & (Slots - 1)];
+	timer->next = slot;
+	if (slot) slot->pprev = &timer->next;
+	timer->pprev = &slot;
+	slot = timer;
+}
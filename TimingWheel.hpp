@@ -0,0 +1,118 @@
+#pragma once
+
+/*
+ * TimingWheel is a hierarchical timing wheel: a timer structure with O(1)
+ * schedule and cancel and amortized O(1) expiry, suitable for tracking
+ * deadlines on very many connections at once.
+ *
+ * Time is measured in integer 'Tick's of whatever resolution the owner picks.
+ * Timers are intrusive -- embed a TimingWheel::Timer (or a struct derived from it)
+ * in whatever object needs a deadline:
+ *
+ * struct Thing {
+ *     TimingWheel::Timer timer;
+ * };
+ *
+ * wheel.schedule(&thing.timer, wheel.now + 50); //expire 50 ticks from now
+ * ...
+ * wheel.advance(current_tick, [](TimingWheel::Timer *timer){
+ *     //timer has expired (and is no longer scheduled)
+ * });
+ *
+ * Timers cancel themselves when destroyed.
+ *
+ * Implementation: Levels x 64 slots. Level L holds timers whose expiry first
+ *  differs from 'now' in bits [6L, 6L+6); when the wheel crosses a level-L
+ *  boundary, that level's slot is cascaded down into the finer levels.
+ */
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+struct TimingWheel {
+	typedef uint64_t Tick;
+
+	struct Timer {
+		Timer() = default;
+		//timers are linked into the wheel by address, so they can't be copied:
+		Timer(Timer const &) = delete;
+		Timer &operator=(Timer const &) = delete;
+		~Timer() { cancel(); }
+
+		//is the timer currently scheduled?
+		bool active() const { return pprev != nullptr; }
+
+		//remove from the wheel (does nothing if not scheduled):
+		void cancel();
+
+		Tick expires = 0; //tick at which the timer fires
+
+		//internals:
+		TimingWheel *wheel = nullptr;
+		Timer *next = nullptr;
+		Timer **pprev = nullptr; //points to whatever pointer points to this timer
+	};
+
+	TimingWheel(Tick now = 0);
+	~TimingWheel();
+
+	//(re-)schedule timer to fire at 'expires' (deadlines in the past fire on the next tick):
+	void schedule(Timer *timer, Tick expires);
+
+	//move the wheel forward to 'to', calling on_expire(Timer *) for every timer that expires.
+	// on_expire may freely schedule or cancel any timer (including the one passed to it).
+	template< typename OnExpire >
+	void advance(Tick to, OnExpire &&on_expire);
+
+	Tick now; //current time (last tick processed)
+	size_t count = 0; //number of scheduled timers
+
+	//internals:
+	static constexpr uint32_t SlotBits = 6;
+	static constexpr uint32_t Slots = 1 << SlotBits;
+	static constexpr uint32_t Levels = 4; //(timers further out than 64^4 ticks are re-filed when they reach the last level)
+	std::array< std::array< Timer *, Slots >, Levels > slots{};
+
+	void link(Timer *timer, bool cascading); //place a timer in the proper slot given 'now'
+};
+
+//------------------------------
+
+template< typename OnExpire >
+void TimingWheel::advance(Tick to, OnExpire &&on_expire) {
+	while (now < to) {
+		if (count == 0) { //nothing to do, so skip ahead
+			now = to;
+			break;
+		}
+		now += 1;
+
+		//cascade coarser levels whose slot boundary we just crossed:
+		for (uint32_t level = Levels - 1; level > 0; --level) {
+			if ((now & ((Tick(1) << (SlotBits * level)) - 1)) != 0) continue;
+			Timer *list = slots[level][(now >> (SlotBits * level)) & (Slots - 1)];
+			slots[level][(now >> (SlotBits * level)) & (Slots - 1)] = nullptr;
+			while (list) {
+				Timer *timer = list;
+				list = timer->next;
+				link(timer, true);
+			}
+		}
+
+		//detach this tick's slot so callbacks can reschedule without disturbing iteration:
+		Timer *pending = slots[0][now & (Slots - 1)];
+		slots[0][now & (Slots - 1)] = nullptr;
+		if (pending) pending->pprev = &pending;
+		while (pending) {
+			Timer *timer = pending;
+			timer->cancel();
+			if (timer->expires > now) {
+				//was filed early because it was beyond the wheel's range:
+				schedule(timer, timer->expires);
+			} else {
+				on_expire(timer);
+			}
+		}
+	}
+}
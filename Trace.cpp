@@ -0,0 +1,30 @@
+#include "Trace.hpp"
+
+#ifdef ENABLE_TRACE
+
+#include <cstdlib>
+#include <iostream>
+
+bool Trace::enabled() {
+	static bool const on = (std::getenv("TRACE_FILE") != nullptr);
+	return on;
+}
+
+void Trace::name_thread(char const *name) {
+	if (!enabled()) return;
+	FlightRecorder::name_thread(name);
+}
+
+void Trace::write() {
+	if (!enabled()) return;
+	char const *path = std::getenv("TRACE_FILE");
+
+	size_t written = 0;
+	if (!FlightRecorder::write_trace(path, &written)) {
+		std::cerr << "[trace] failed to write '" << path << "'." << std::endl;
+		return;
+	}
+	std::cout << "[trace] wrote " << written << " events to '" << path << "'." << std::endl;
+}
+
+#endif
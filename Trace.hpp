@@ -0,0 +1,60 @@
+#pragma once
+
+/*
+ * Scoped timers that record Chrome trace events (load the output in
+ * chrome://tracing or https://ui.perfetto.dev):
+ *
+ *  void Scene::draw(...) {
+ *  	TRACE_SCOPE("Scene::draw");
+ *  	...
+ *  }
+ *
+ *  TRACE_THREAD("network"); //(optional) name the calling thread in the trace
+ *  Trace::write(); //at exit, once other threads are done; writes the file named by TRACE_FILE
+ *
+ * Tracing is only compiled in when ENABLE_TRACE is defined (build with
+ * 'TRACE=1 node Maekfile.js'); otherwise these macros expand to nothing.
+ *
+ * Traced builds record only if the TRACE_FILE environment variable is set.
+ * Events go into the flight recorder's per-thread rings (see FlightRecorder.hpp;
+ * no locks, and once a ring is full the oldest events are overwritten), so the
+ * trace also has every RECORD_SCOPE event. Code that wants a phase in both uses
+ * RECORD_SCOPE alone; TRACE_SCOPE is for detail only traces need.
+ */
+
+#include <cstdint>
+#include <cstddef>
+
+#ifdef ENABLE_TRACE
+
+#include "FlightRecorder.hpp"
+
+namespace Trace {
+	bool enabled(); //(is TRACE_FILE set?)
+
+	void name_thread(char const *name);
+
+	//write every thread's events to TRACE_FILE (call once the other threads have stopped):
+	void write();
+
+	struct Scope {
+		Scope(char const *name_) : name(name_), begin(enabled() ? FlightRecorder::now() : 0) { }
+		~Scope() { if (begin) FlightRecorder::record(name, begin, FlightRecorder::now()); }
+		char const *name;
+		uint64_t begin;
+	};
+}
+
+#define TRACE_CONCAT2(a, b) a ## b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT2(a, b)
+#define TRACE_SCOPE(name) Trace::Scope TRACE_CONCAT(trace_scope_, __LINE__)(name)
+#define TRACE_THREAD(name) Trace::name_thread(name)
+#define TRACE_WRITE() Trace::write()
+
+#else
+
+#define TRACE_SCOPE(name) do { } while (0)
+#define TRACE_THREAD(name) do { } while (0)
+#define TRACE_WRITE() do { } while (0)
+
+#endif
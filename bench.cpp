@@ -0,0 +1,516 @@
+//Microbenchmarks for the pieces of the client and server that run every frame or tick
+// (or at load time), reported as JSON so runs can be saved and compared.
+//
+//Usage:
+//	./bench [--filter TEXT] [--seconds S] [--out FILE] [--compare BASELINE] [--threshold PERCENT] [--no-gl] [--list]
+//
+//Each benchmark is run for a few samples of about S/7 seconds each (default S is 1.4); the
+// median and best ns/op over the samples are reported, along with heap allocations per op.
+//
+//The JSON report goes to stdout (or to FILE with --out). Progress goes to stderr.
+//
+//With --compare, also reads a report saved by an earlier run and lists each benchmark's
+// change in median ns/op; benchmarks whose median and best are both more than PERCENT
+// (default 10) slower are flagged as regressions, and the exit code is 1 if there are any:
+//	./bench --out baseline.json
+//	(make changes)
+//	./bench --compare baseline.json
+//(compare results from the same machine; timings on shared or throttled machines are noisy)
+//
+//MeshBuffer needs an OpenGL context, which is made with a hidden SDL window; if that fails
+// (or with --no-gl), the OpenGL benchmarks are skipped.
+
+#include "Game.hpp"
+#include "Connection.hpp"
+#include "DrawLines.hpp"
+#include "Mesh.hpp"
+#include "Scene.hpp"
+#include "Sound.hpp"
+#include "GL.hpp"
+#include "read_write_chunk.hpp"
+#include "hex_dump.hpp"
+#include "write_json.hpp"
+#include "data_path.hpp"
+#include "count_allocations.hpp"
+
+#include <SDL.h>
+
+#include <chrono>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <functional>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+
+//the SDL audio callback, from Sound.cpp (called directly to mix offline):
+void mix_audio(void *, Uint8 *buffer_, int len);
+
+struct Result {
+	std::string name;
+	double ns_per_op = 0.0; //median over samples
+	double best_ns_per_op = 0.0; //fastest sample
+	double allocations_per_op = 0.0;
+	uint64_t ops = 0; //(over all samples)
+};
+
+//results that would otherwise be unused (so the work isn't optimized away):
+static size_t sink = 0;
+
+static constexpr uint32_t Samples = 7;
+static double sample_seconds = 0.2;
+
+//run 'body' (which does some work and returns the number of operations it did) over and over:
+static Result measure(std::string const &name, std::function< uint64_t() > const &body) {
+	Result result;
+	result.name = name;
+
+	std::vector< double > ns_per_op;
+	uint64_t total_allocations = 0;
+	//(the first sample is a warm-up and isn't counted)
+	for (uint32_t sample = 0; sample <= Samples; ++sample) {
+		uint64_t ops = 0;
+		uint64_t allocations_before = allocations_so_far();
+		auto before = std::chrono::steady_clock::now();
+		double elapsed = 0.0;
+		do {
+			ops += body();
+			elapsed = std::chrono::duration< double >(std::chrono::steady_clock::now() - before).count();
+		} while (elapsed < sample_seconds);
+		if (sample == 0) continue;
+		ns_per_op.emplace_back(elapsed / ops * 1e9);
+		result.ops += ops;
+		total_allocations += allocations_so_far() - allocations_before;
+	}
+
+	std::sort(ns_per_op.begin(), ns_per_op.end());
+	result.ns_per_op = ns_per_op[ns_per_op.size() / 2];
+	result.best_ns_per_op = ns_per_op.front();
+	result.allocations_per_op = double(total_allocations) / double(result.ops);
+
+	std::cerr << "  " << std::left << std::setw(40) << name << std::right << std::setw(12) << std::fixed << std::setprecision(1)
+		<< result.ns_per_op << " ns/op (best " << result.best_ns_per_op << "), "
+		<< std::setprecision(2) << result.allocations_per_op << " allocations/op" << std::endl;
+	return result;
+}
+
+//press or release a finger the way PlayMode does (downs count presses):
+static void set_button(Button *button, bool pressed) {
+	if (pressed && !button->pressed) button->downs += 1;
+	button->pressed = pressed;
+}
+
+//buttons toggling now and then:
+static std::vector< Player::Controls > random_controls(uint32_t count, uint32_t seed) {
+	std::mt19937 mt(seed);
+	std::vector< Player::Controls > ret(count);
+	Player::Controls held;
+	for (auto &controls : ret) {
+		for (auto *buttons : {&held.left_buttons, &held.right_buttons}) {
+			for (auto &b : *buttons) {
+				b.downs = 0;
+				if (mt() % 100 < 5) set_button(&b, !b.pressed);
+			}
+		}
+		controls = held;
+	}
+	return ret;
+}
+
+//a match with every seat filled, a little way into play:
+static Game started_game(uint32_t players) {
+	Game game(players);
+	for (uint32_t i = 0; i < players; ++i) game.spawn_player();
+	std::vector< Player::Controls > inputs = random_controls(200, players);
+	for (uint32_t t = 0; t < inputs.size(); ++t) {
+		for (uint32_t s = 0; s < players; ++s) game.seat(int8_t(s))->controls = inputs[(t + s * 17) % inputs.size()];
+		game.update(Game::Tick);
+	}
+	return game;
+}
+
+//---------------- benchmarks ----------------
+
+static void bench_network(std::vector< Result > *results, std::function< bool(std::string const &) > const &wanted) {
+	for (uint32_t players : {3U, 64U}) {
+		Game game = started_game(players);
+		Player const *local = &game.players.front();
+
+		std::string suffix = " (" + std::to_string(players) + " players)";
+
+		Connection encoder;
+		if (wanted("send_state_message" + suffix)) {
+			results->emplace_back(measure("send_state_message" + suffix, [&]() -> uint64_t {
+				for (uint32_t i = 0; i < 100; ++i) {
+					encoder.send_buffer.clear();
+					game.send_state_message(&encoder, local, i, i);
+				}
+				return 100;
+			}));
+		}
+
+		encoder.send_buffer.clear();
+		game.send_state_message(&encoder, local, 1, 1);
+		std::vector< uint8_t > const message = encoder.send_buffer;
+
+		if (wanted("recv_state_message" + suffix)) {
+			Connection decoder;
+			Game client(players);
+			results->emplace_back(measure("recv_state_message" + suffix, [&]() -> uint64_t {
+				for (uint32_t i = 0; i < 100; ++i) {
+					decoder.recv_buffer.assign(message.begin(), message.end()); //(reuses the buffer's storage)
+					client.recv_state_message(&decoder);
+				}
+				return 100;
+			}));
+		}
+	}
+
+	if (wanted("recv_controls_message (64 queued)")) {
+		//a burst of 64 controls messages, as a server might find in a connection's buffer:
+		std::vector< Player::Controls > inputs = random_controls(64, 1);
+		Connection encoder;
+		for (uint32_t i = 0; i < inputs.size(); ++i) inputs[i].send_controls_message(&encoder, i);
+		std::vector< uint8_t > const burst = encoder.send_buffer;
+
+		Connection decoder;
+		Player::Controls controls;
+		results->emplace_back(measure("recv_controls_message (64 queued)", [&]() -> uint64_t {
+			decoder.recv_buffer.assign(burst.begin(), burst.end());
+			uint64_t count = 0;
+			uint32_t tick = 0;
+			while (controls.recv_controls_message(&decoder, &tick)) {
+				for (auto *buttons : {&controls.left_buttons, &controls.right_buttons}) {
+					for (auto &b : *buttons) b.downs = 0;
+				}
+				count += 1;
+			}
+			return count;
+		}));
+	}
+}
+
+static void bench_simulation(std::vector< Result > *results, std::function< bool(std::string const &) > const &wanted) {
+	for (uint32_t players : {3U, 64U}) {
+		std::string name = "Game::update (" + std::to_string(players) + " players)";
+		if (!wanted(name)) continue;
+
+		Game game = started_game(players);
+		std::vector< Player::Controls > inputs = random_controls(1000, 2);
+		uint32_t t = 0;
+		results->emplace_back(measure(name, [&]() -> uint64_t {
+			for (uint32_t i = 0; i < 10; ++i) {
+				for (uint32_t s = 0; s < players; ++s) game.seat(int8_t(s))->controls = inputs[(t + s * 31) % inputs.size()];
+				game.update(Game::Tick);
+				t += 1;
+			}
+			return 10;
+		}));
+	}
+}
+
+static void bench_drawing(std::vector< Result > *results, std::function< bool(std::string const &) > const &wanted) {
+	//(attributes are cleared before each DrawLines goes away, so nothing is sent to OpenGL)
+	if (wanted("DrawLines::draw (1000 lines)")) {
+		results->emplace_back(measure("DrawLines::draw (1000 lines)", [&]() -> uint64_t {
+			DrawLines lines(glm::mat4(1.0f));
+			for (uint32_t i = 0; i < 1000; ++i) {
+				float x = i * 0.001f;
+				lines.draw(glm::vec3(x, 0.0f, 0.0f), glm::vec3(x, 1.0f, 0.0f), glm::u8vec4(0xff, 0x88, 0x00, 0xff));
+			}
+			lines.attribs.clear();
+			return 1;
+		}));
+	}
+
+	if (wanted("DrawLines::draw_text (10 lines of 60 chars)")) {
+		std::string const text = "frame 16.67ms avg (60 fps) over 240 frames, p99 18.20 ms ?!";
+		results->emplace_back(measure("DrawLines::draw_text (10 lines of 60 chars)", [&]() -> uint64_t {
+			DrawLines lines(glm::mat4(1.0f));
+			glm::vec3 at = glm::vec3(-1.0f, 1.0f, 0.0f);
+			for (uint32_t i = 0; i < 10; ++i) {
+				lines.draw_text(text, at, glm::vec3(0.04f, 0.0f, 0.0f), glm::vec3(0.0f, 0.04f, 0.0f));
+				at.y -= 0.06f;
+			}
+			lines.attribs.clear();
+			return 1;
+		}));
+	}
+}
+
+static void bench_loading(std::vector< Result > *results, std::function< bool(std::string const &) > const &wanted, bool have_gl) {
+	if (wanted("read_chunk (1 MiB)")) {
+		std::vector< uint32_t > data(256 * 1024);
+		for (uint32_t i = 0; i < data.size(); ++i) data[i] = i * 2654435761U;
+		std::stringstream file;
+		write_chunk("dat0", data, &file);
+		std::string const bytes = file.str();
+
+		std::vector< uint32_t > read;
+		results->emplace_back(measure("read_chunk (1 MiB)", [&]() -> uint64_t {
+			std::istringstream from(bytes);
+			read_chunk(from, "dat0", &read);
+			sink += read.size();
+			return 1;
+		}));
+	}
+
+	if (wanted("hex_dump (4 KiB)")) {
+		std::vector< uint8_t > data(4096);
+		for (uint32_t i = 0; i < data.size(); ++i) data[i] = uint8_t(i * 37);
+		results->emplace_back(measure("hex_dump (4 KiB)", [&]() -> uint64_t {
+			sink += hex_dump(data).size();
+			return 1;
+		}));
+	}
+
+	if (wanted("Scene::load (phone-bank.scene)")) {
+		std::string const path = data_path("phone-bank.scene");
+		results->emplace_back(measure("Scene::load (phone-bank.scene)", [&]() -> uint64_t {
+			Scene scene;
+			scene.load(path, [](Scene &scene, Scene::Transform *transform, std::string const &mesh_name) {
+				scene.drawables.emplace_back(transform);
+			});
+			return 1;
+		}));
+	}
+
+	if (wanted("MeshBuffer (phone-bank.pnct)")) {
+		if (!have_gl) {
+			std::cerr << "  (skipping MeshBuffer: no OpenGL context)" << std::endl;
+		} else {
+			std::string const path = data_path("phone-bank.pnct");
+			results->emplace_back(measure("MeshBuffer (phone-bank.pnct)", [&]() -> uint64_t {
+				MeshBuffer meshes(path);
+				glDeleteBuffers(1, &meshes.buffer); //(MeshBuffer doesn't free its buffer)
+				return 1;
+			}));
+		}
+	}
+}
+
+static void bench_audio(std::vector< Result > *results, std::function< bool(std::string const &) > const &wanted) {
+	//one second of noise, looped by every voice:
+	std::vector< float > noise(48000);
+	std::mt19937 mt(3);
+	for (auto &s : noise) s = (mt() % 2001) / 1000.0f - 1.0f;
+	Sound::Sample sample(noise);
+
+	for (uint32_t voices : {16U, 256U}) {
+		std::string name = "mix_audio (" + std::to_string(voices) + " voices, 1024 samples)";
+		if (!wanted(name)) continue;
+
+		//half panned in 2D, half positioned in 3D:
+		std::vector< std::shared_ptr< Sound::PlayingSample > > playing;
+		for (uint32_t v = 0; v < voices; ++v) {
+			if (v % 2) playing.emplace_back(Sound::loop(sample, 0.01f, (v % 17) / 8.0f - 1.0f));
+			else playing.emplace_back(Sound::loop_3D(sample, 0.01f, glm::vec3(float(v % 13), float(v % 7), 0.0f), 4.0f));
+		}
+
+		std::vector< float > buffer(1024 * 2);
+		results->emplace_back(measure(name, [&]() -> uint64_t {
+			mix_audio(nullptr, reinterpret_cast< Uint8 * >(buffer.data()), int(buffer.size() * sizeof(float)));
+			return 1;
+		}));
+
+		Sound::stop_all_samples();
+		mix_audio(nullptr, reinterpret_cast< Uint8 * >(buffer.data()), int(buffer.size() * sizeof(float))); //(lets stopped samples finish)
+	}
+}
+
+//---------------- reporting ----------------
+
+static void write_json(std::ostream &out, std::vector< Result > const &results) {
+	//(one benchmark per line, which is what read_baseline expects)
+	out << "{\"benchmarks\":[\n";
+	for (size_t i = 0; i < results.size(); ++i) {
+		Result const &r = results[i];
+		out << "\t{\"name\":" << json_string(r.name)
+			<< ",\"ns_per_op\":" << r.ns_per_op
+			<< ",\"best_ns_per_op\":" << r.best_ns_per_op
+			<< ",\"allocations_per_op\":" << r.allocations_per_op
+			<< ",\"ops\":" << r.ops << "}"
+			<< (i + 1 < results.size() ? ",\n" : "\n");
+	}
+	out << "]}\n";
+}
+
+//read results back from a file written by write_json:
+static std::map< std::string, Result > read_baseline(std::string const &filename) {
+	std::ifstream file(filename, std::ios::binary);
+	if (!file) throw std::runtime_error("Failed to open baseline '" + filename + "'.");
+
+	std::map< std::string, Result > ret;
+	std::string line;
+	while (std::getline(file, line)) {
+		size_t name_at = line.find("{\"name\":\"");
+		size_t ns_at = line.find(",\"ns_per_op\":");
+		size_t best_at = line.find(",\"best_ns_per_op\":");
+		if (name_at == std::string::npos || ns_at == std::string::npos || best_at == std::string::npos) continue;
+		Result result;
+		//(undoing json_string's escapes)
+		for (size_t i = name_at + 9; i < line.size() && line[i] != '"'; ++i) {
+			if (line[i] == '\\' && i + 1 < line.size()) {
+				++i;
+				if (line[i] == 'n') result.name += '\n';
+				else if (line[i] == 't') result.name += '\t';
+				else if (line[i] == 'r') result.name += '\r';
+				else if (line[i] == 'u' && i + 4 < line.size()) {
+					result.name += char(std::stoul(line.substr(i + 1, 4), nullptr, 16));
+					i += 4;
+				} else result.name += line[i];
+				continue;
+			}
+			result.name += line[i];
+		}
+		result.ns_per_op = std::stod(line.substr(ns_at + 13));
+		result.best_ns_per_op = std::stod(line.substr(best_at + 18));
+		ret[result.name] = result;
+	}
+	if (ret.empty()) throw std::runtime_error("No benchmarks found in baseline '" + filename + "'.");
+	return ret;
+}
+
+//print how each result changed; returns the number of regressions:
+// (both the median and the best sample have to be slower, so one noisy sample isn't enough)
+static uint32_t compare(std::vector< Result > const &results, std::map< std::string, Result > const &baseline, double threshold) {
+	uint32_t regressions = 0;
+	std::cerr << "Compared to baseline (regression threshold +" << std::setprecision(1) << threshold << "%):" << std::endl;
+	for (auto const &r : results) {
+		auto f = baseline.find(r.name);
+		std::cerr << "  " << std::left << std::setw(40) << r.name << std::right;
+		if (f == baseline.end()) {
+			std::cerr << "  (not in baseline)" << std::endl;
+			continue;
+		}
+		double change = (r.ns_per_op / f->second.ns_per_op - 1.0) * 100.0;
+		double best_change = (r.best_ns_per_op / f->second.best_ns_per_op - 1.0) * 100.0;
+		std::cerr << std::setw(12) << std::fixed << std::setprecision(1) << f->second.ns_per_op << " -> " << r.ns_per_op << " ns/op ("
+			<< std::showpos << change << "%, best " << best_change << std::noshowpos << "%)";
+		if (change > threshold && best_change > threshold) {
+			std::cerr << "  REGRESSION";
+			regressions += 1;
+		}
+		std::cerr << std::endl;
+	}
+	return regressions;
+}
+
+//---------------- main ----------------
+
+//a hidden window, just for its OpenGL context:
+static bool init_gl(SDL_Window **window, SDL_GLContext *context) {
+	if (SDL_Init(SDL_INIT_VIDEO) != 0) return false;
+	SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+	SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
+	SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
+	*window = SDL_CreateWindow("bench", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, 64, 64, SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN);
+	if (!*window) return false;
+	*context = SDL_GL_CreateContext(*window);
+	if (!*context) {
+		SDL_DestroyWindow(*window);
+		*window = nullptr;
+		return false;
+	}
+	init_GL();
+	return true;
+}
+
+int main(int argc, char **argv) {
+	std::string filter;
+	std::string out_file;
+	std::string baseline_file;
+	double threshold = 10.0;
+	double seconds = Samples * sample_seconds;
+	bool use_gl = true;
+	bool list = false;
+
+	for (int argi = 1; argi < argc; ++argi) {
+		std::string arg = argv[argi];
+		if (arg == "--filter" && argi + 1 < argc) {
+			filter = argv[++argi];
+		} else if (arg == "--seconds" && argi + 1 < argc) {
+			seconds = std::stod(argv[++argi]);
+		} else if (arg == "--out" && argi + 1 < argc) {
+			out_file = argv[++argi];
+		} else if (arg == "--compare" && argi + 1 < argc) {
+			baseline_file = argv[++argi];
+		} else if (arg == "--threshold" && argi + 1 < argc) {
+			threshold = std::stod(argv[++argi]);
+		} else if (arg == "--no-gl") {
+			use_gl = false;
+		} else if (arg == "--list") {
+			list = true;
+		} else {
+			std::cerr << "Usage:\n\t./bench [--filter TEXT] [--seconds S] [--out FILE] [--compare BASELINE] [--threshold PERCENT] [--no-gl] [--list]" << std::endl;
+			return 1;
+		}
+	}
+	sample_seconds = seconds / Samples;
+
+	std::map< std::string, Result > baseline;
+	if (!baseline_file.empty()) { //(read before running, so a bad baseline fails fast)
+		try {
+			baseline = read_baseline(baseline_file);
+		} catch (std::exception &e) {
+			std::cerr << e.what() << std::endl;
+			return 1;
+		}
+	}
+
+	//with --list, print the names of the benchmarks instead of running them:
+	auto wanted = [&](std::string const &name) {
+		if (name.find(filter) == std::string::npos) return false;
+		if (list) std::cout << name << std::endl;
+		return !list;
+	};
+
+	SDL_Window *window = nullptr;
+	SDL_GLContext context = nullptr;
+	bool have_gl = false;
+	if (use_gl && !list) {
+		have_gl = init_gl(&window, &context);
+		if (!have_gl) std::cerr << "NOTE: couldn't make an OpenGL context (" << SDL_GetError() << ")." << std::endl;
+	}
+
+	std::vector< Result > results;
+	if (!list) std::cerr << "Running benchmarks (" << Samples << " samples of " << sample_seconds << "s each):" << std::endl;
+	bench_network(&results, wanted);
+	bench_simulation(&results, wanted);
+	bench_drawing(&results, wanted);
+	bench_loading(&results, wanted, have_gl);
+	bench_audio(&results, wanted);
+
+	if (context) SDL_GL_DeleteContext(context);
+	if (window) SDL_DestroyWindow(window);
+	SDL_Quit();
+
+	if (list) return 0;
+
+	if (out_file.empty()) {
+		write_json(std::cout, results);
+	} else {
+		std::ofstream out(out_file, std::ios::binary);
+		write_json(out, results);
+		if (!out) {
+			std::cerr << "Failed to write '" << out_file << "'." << std::endl;
+			return 1;
+		}
+		std::cerr << "Wrote '" << out_file << "'." << std::endl;
+	}
+
+	if (!baseline.empty()) {
+		uint32_t regressions = compare(results, baseline, threshold);
+		if (regressions) {
+			std::cerr << "FAIL: " << regressions << " benchmark(s) regressed by more than " << threshold << "%." << std::endl;
+			return 1;
+		}
+	}
+	return 0;
+}
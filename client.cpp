@@ -3,9 +3,15 @@
 #include "Connection.hpp"
 #include "Mode.hpp"
 #include "Load.hpp"
+#include "LoadProfile.hpp"
 #include "Sound.hpp"
 #include "GL.hpp"
+#include "gl_debug_output.hpp"
 #include "load_save_png.hpp"
+#include "Trace.hpp"
+#include "FrameStats.hpp"
+#include "FlightRecorder.hpp"
+#include "Memory.hpp"
 
 #include <SDL.h>
 
@@ -14,6 +20,7 @@
 #include <stdexcept>
 #include <memory>
 #include <algorithm>
+#include <string>
 
 #ifdef _WIN32
 extern "C" { uint32_t GetACP(); }
@@ -34,10 +41,29 @@ int main(int argc, char **argv) {
 	try {
 #endif
 	//------------ command line arguments ------------
-	if (argc != 3) {
-		std::cerr << "Usage:\n\t./client <host> <port>" << std::endl;
+	bool rollback = true;
+	//seconds a frame can take before it counts as a hitch (recent events get dumped; see FlightRecorder.hpp):
+	double hitch_budget = 0.1;
+	//where to write a Chrome trace of startup (see LoadProfile.hpp):
+	std::string startup_trace;
+	bool usage = (argc < 3);
+	for (int argi = 3; argi < argc && !usage; ++argi) {
+		std::string arg = argv[argi];
+		if (arg == "--no-rollback") {
+			rollback = false;
+		} else if (arg == "--hitch-budget" && argi + 1 < argc) {
+			hitch_budget = std::stod(argv[++argi]) / 1000.0;
+		} else if (arg == "--startup-trace" && argi + 1 < argc) {
+			startup_trace = argv[++argi];
+		} else {
+			usage = true;
+		}
+	}
+	if (usage) {
+		std::cerr << "Usage:\n\t./client <host> <port> [--no-rollback] [--hitch-budget MS] [--startup-trace FILE]" << std::endl;
 		return 1;
 	}
+	FlightRecorder::configure("client", hitch_budget);
 
 	//------------ connect to server --------------
 	Client client(argv[1], argv[2]);
@@ -57,7 +83,9 @@ int main(int argc, char **argv) {
 	SDL_GL_SetAttribute(SDL_GL_STENCIL_SIZE, 8);
 	SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
 	SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+	#ifndef NDEBUG
 	SDL_GL_SetAttribute(SDL_GL_CONTEXT_FLAGS, SDL_GL_CONTEXT_DEBUG_FLAG);
+	#endif
 	SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
 	SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
 
@@ -92,6 +120,11 @@ int main(int argc, char **argv) {
 	//On windows, load OpenGL entrypoints: (does nothing on other platforms)
 	init_GL();
 
+	#ifndef NDEBUG
+	//Report OpenGL errors as the driver finds them: (falls back to GL_ERRORS() polling if unsupported)
+	gl_debug_output();
+	#endif
+
 	//Set VSYNC + Late Swap (prevents crazy FPS):
 	if (SDL_GL_SetSwapInterval(-1) != 0) {
 		std::cerr << "NOTE: couldn't set vsync + late swap tearing (" << SDL_GetError() << ")." << std::endl;
@@ -104,13 +137,23 @@ int main(int argc, char **argv) {
 	//SDL_ShowCursor(SDL_DISABLE);
 
 	//------------ init sound --------------
-	Sound::init();
+	{
+		LoadProfile::Scope profile("Sound::init");
+		Sound::init();
+	}
 
 	//------------ load assets --------------
 	call_load_functions();
 
 	//------------ create game mode + make current --------------
-	Mode::set_current(std::make_shared< PlayMode >(client));
+	Mode::set_current(std::make_shared< PlayMode >(client, rollback));
+
+	//what startup spent its time on:
+	std::cout << LoadProfile::report();
+	if (!startup_trace.empty()) {
+		if (LoadProfile::write_trace(startup_trace)) std::cout << "Wrote startup trace to '" << startup_trace << "'." << std::endl;
+		else std::cerr << "Failed to write startup trace to '" << startup_trace << "'." << std::endl;
+	}
 
 	//------------ main loop ------------
 
@@ -129,12 +172,20 @@ int main(int argc, char **argv) {
 	};
 	on_resize();
 
+	RECORD_THREAD("main");
+
+	//per-phase frame timings, shown by pressing F2:
+	FrameStats frame_stats;
+
 	//This will loop until the current mode is set to null:
 	while (Mode::current) {
+		FlightRecorder::Watch frame_watch("frame");
+		frame_stats.begin_frame();
 		//every pass through the game loop creates one frame of output
 		//  by performing three steps:
 
 		{ //(1) process any events that are pending
+			FrameStats::Scope stats_scope(frame_stats, FrameStats::Events);
 			static SDL_Event evt;
 			while (SDL_PollEvent(&evt) == 1) {
 				//handle resizing:
@@ -161,6 +212,9 @@ int main(int argc, char **argv) {
 						px.a = 0xff;
 					}
 					save_png(filename, glm::uvec2(w,h), data.data(), LowerLeftOrigin);
+				} else if (evt.type == SDL_KEYDOWN && evt.key.keysym.sym == SDLK_F2 && !evt.key.repeat) {
+					// --- frame stats overlay ---
+					frame_stats.visible = !frame_stats.visible;
 				}
 			}
 			if (!Mode::current) break;
@@ -176,17 +230,22 @@ int main(int argc, char **argv) {
 			//lag to avoid spiral of death:
 			elapsed = std::min(0.1f, elapsed);
 
+			FrameStats::Scope stats_scope(frame_stats, FrameStats::Update);
 			Mode::current->update(elapsed);
 			if (!Mode::current) break;
 		}
 
 		{ //(3) call the current mode's "draw" function to produce output:
-		
+			FrameStats::Scope stats_scope(frame_stats, FrameStats::Draw);
 			Mode::current->draw(drawable_size);
 		}
 
-		//Wait until the recently-drawn frame is shown before doing it all again:
-		SDL_GL_SwapWindow(window);
+		if (frame_stats.visible) frame_stats.draw(drawable_size);
+
+		{ //Wait until the recently-drawn frame is shown before doing it all again:
+			FrameStats::Scope stats_scope(frame_stats, FrameStats::Swap);
+			SDL_GL_SwapWindow(window);
+		}
 	}
 
 
@@ -199,6 +258,10 @@ int main(int argc, char **argv) {
 	SDL_DestroyWindow(window);
 	window = NULL;
 
+	std::cout << Memory::report();
+
+	TRACE_WRITE(); //(if TRACE_FILE is set in a traced build; see Trace.hpp)
+
 	return 0;
 
 #ifdef _WIN32
@@ -0,0 +1,191 @@
+//Checks ConnectionTask: coroutines driven by Server::poll over loopback connections must
+// resume when a message arrives, when a flush completes, and when the connection closes,
+// report exceptions through rethrow_if_failed(), and hand their frames back to the pool.
+//
+//Usage:
+//	./connection-task-test [port]
+//
+//(listens on localhost:15479 by default)
+//Prints each failed check and exits with a nonzero status if there were any.
+
+#include "Connection.hpp"
+#include "ConnectionTask.hpp"
+#include "Game.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <list>
+#include <functional>
+#include <cstdint>
+
+static uint32_t failures = 0;
+static void check(bool ok, std::string const &what) {
+	if (!ok) {
+		std::cerr << "FAILED: " << what << std::endl;
+		failures += 1;
+	}
+}
+
+//what the task below has gotten up to:
+struct Progress {
+	uint32_t messages = 0; //controls messages read
+	bool flushed = false; //ping reply handed to the OS
+	bool saw_close = false; //read_message() resumed with 'false'
+};
+
+//the server side of a tiny protocol: answer one controls message with a ping, then count controls until the connection closes:
+static ConnectionTask serve(Connection &connection, Progress &progress) {
+	if (!co_await connection.read_message()) co_return;
+	Player::Controls controls;
+	if (!controls.recv_controls_message(&connection)) throw std::runtime_error("expected controls");
+	progress.messages += 1;
+
+	send_ping_message(&connection);
+	if (!co_await connection.flush()) co_return;
+	progress.flushed = true;
+
+	while (co_await connection.read_message()) {
+		if (!controls.recv_controls_message(&connection)) throw std::runtime_error("expected controls");
+		progress.messages += 1;
+	}
+	progress.saw_close = true;
+}
+
+int main(int argc, char **argv) {
+	std::string port = "15479";
+	if (argc > 1) port = argv[1];
+	if (argc > 2) {
+		std::cerr << "Usage:\n\t./connection-task-test [port]" << std::endl;
+		return 1;
+	}
+
+	Server server(port);
+
+	std::unordered_map< Connection *, ConnectionTask > tasks;
+	std::unordered_map< Connection *, Progress > progress;
+	auto poll_server = [&]() {
+		server.poll([&](Connection *c, Connection::Event evt) {
+			if (evt == Connection::OnOpen) {
+				tasks.emplace(c, serve(*c, progress[c]));
+			}
+			//(OnRecv / OnClose need no handling: poll() resumes the tasks)
+		}, 0.0);
+	};
+
+	//poll the server and clients until 'done' or a second passes:
+	auto poll_until = [&](std::list< Client > &clients, std::function< bool() > const &done) {
+		auto start = std::chrono::steady_clock::now();
+		bool ok = done();
+		while (!ok && std::chrono::steady_clock::now() - start < std::chrono::seconds(1)) {
+			poll_server();
+			for (auto &client : clients) client.poll([](Connection *, Connection::Event){ }, 0.0);
+			ok = done();
+		}
+		return ok;
+	};
+
+	size_t base_in_use = connection_task_pool_stats().in_use;
+
+	{ //one task, start to finish:
+		std::list< Client > clients;
+		clients.emplace_back("localhost", port);
+		Connection &client = clients.back().connection;
+
+		check(poll_until(clients, [&](){ return tasks.size() == 1; }), "single: server saw the connection");
+		Connection *c = tasks.begin()->first;
+		check(!tasks[c].done() && c->waiting, "single: task suspended waiting for a message");
+		check(connection_task_pool_stats().in_use == base_in_use + 1, "single: suspended task holds one pool block");
+
+		//half a message doesn't wake it:
+		Player::Controls controls;
+		controls.send_controls_message(&client);
+		std::vector< uint8_t > rest(client.send_buffer.begin() + 6, client.send_buffer.end());
+		client.send_buffer.resize(6);
+		poll_until(clients, [&](){ return client.send_buffer.empty() && c->recv_buffer.size() == 6; });
+		check(progress[c].messages == 0, "single: partial message doesn't resume the task");
+
+		//the rest of it does; the task answers with a ping and waits for it to flush:
+		client.send_buffer.insert(client.send_buffer.end(), rest.begin(), rest.end());
+		check(poll_until(clients, [&](){ return progress[c].flushed; }), "single: task read the message and flushed its reply");
+		check(poll_until(clients, [&](){ return recv_ping_message(&client); }), "single: client got the reply");
+
+		//two messages in one go are both read without waiting for more data:
+		controls.send_controls_message(&client);
+		controls.send_controls_message(&client);
+		check(poll_until(clients, [&](){ return progress[c].messages == 3; }), "single: back-to-back messages both read");
+
+		//closing the connection resumes the task with 'false':
+		client.close();
+		check(poll_until(clients, [&](){ return tasks[c].done(); }), "single: task finished after close");
+		check(progress[c].saw_close, "single: read_message() reported the close");
+		bool threw = false;
+		try { tasks[c].rethrow_if_failed(); } catch (...) { threw = true; }
+		check(!threw, "single: clean finish doesn't rethrow");
+
+		tasks.clear();
+		progress.clear();
+		check(connection_task_pool_stats().in_use == base_in_use, "single: frame returned to the pool");
+	}
+
+	{ //a task that throws:
+		std::list< Client > clients;
+		clients.emplace_back("localhost", port);
+		Connection &client = clients.back().connection;
+		check(poll_until(clients, [&](){ return tasks.size() == 1; }), "throw: server saw the connection");
+		Connection *c = tasks.begin()->first;
+
+		send_pong_message(&client); //(not what serve() expects)
+		check(poll_until(clients, [&](){ return tasks[c].done(); }), "throw: task finished");
+		bool threw = false;
+		try { tasks[c].rethrow_if_failed(); } catch (std::runtime_error const &) { threw = true; }
+		check(threw, "throw: exception rethrown by rethrow_if_failed()");
+
+		tasks.clear();
+		progress.clear();
+		check(connection_task_pool_stats().in_use == base_in_use, "throw: frame returned to the pool");
+		client.close();
+		poll_until(clients, [&](){ return server.connections.empty(); });
+	}
+
+	{ //many suspended tasks, destroyed without finishing; a second round reuses their blocks:
+		constexpr uint32_t Count = 100;
+		size_t blocks = 0;
+		for (uint32_t round = 0; round < 2; ++round) {
+			std::string what = "round " + std::to_string(round) + ": ";
+			std::list< Client > clients;
+			//(accepting as we go, since the server's listen backlog is short)
+			for (uint32_t i = 0; i < Count; ++i) {
+				clients.emplace_back("localhost", port);
+				poll_until(clients, [&](){ return tasks.size() == i + 1; });
+			}
+			check(tasks.size() == Count, what + "server saw every connection");
+			check(connection_task_pool_stats().in_use == base_in_use + Count, what + "one block per suspended task");
+			check(connection_task_pool_stats().oversized == 0, what + "frames fit in a block");
+			if (round == 0) blocks = connection_task_pool_stats().blocks;
+			else check(connection_task_pool_stats().blocks == blocks, what + "no new blocks allocated");
+
+			//destroying a suspended task frees its block and detaches it from the connection:
+			std::vector< Connection * > waited_on;
+			for (auto const &[c, task] : tasks) waited_on.emplace_back(c);
+			tasks.clear();
+			progress.clear();
+			check(connection_task_pool_stats().in_use == base_in_use, what + "every frame returned to the pool");
+			bool detached = true;
+			for (Connection *c : waited_on) detached = detached && !c->waiting;
+			check(detached, what + "connections forget destroyed tasks");
+
+			for (auto &client : clients) client.connection.close();
+			poll_until(clients, [&](){ return server.connections.empty(); });
+		}
+	}
+
+	if (failures) {
+		std::cerr << failures << " checks failed." << std::endl;
+		return 1;
+	}
+	std::cout << "All connection task checks passed." << std::endl;
+	return 0;
+}
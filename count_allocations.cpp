@@ -0,0 +1,33 @@
+#include "count_allocations.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+//(relaxed is enough: the count is only read between measurements, but the code being measured may allocate from other threads)
+static std::atomic< uint64_t > allocations{0};
+
+uint64_t allocations_so_far() {
+	return allocations.load(std::memory_order_relaxed);
+}
+
+void *operator new(size_t size) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void *ptr = std::malloc(size ? size : 1)) return ptr;
+	throw std::bad_alloc();
+}
+void *operator new[](size_t size) {
+	return operator new(size);
+}
+void operator delete(void *ptr) noexcept {
+	std::free(ptr);
+}
+void operator delete[](void *ptr) noexcept {
+	std::free(ptr);
+}
+void operator delete(void *ptr, size_t) noexcept {
+	std::free(ptr);
+}
+void operator delete[](void *ptr, size_t) noexcept {
+	std::free(ptr);
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstdint>
+
+//heap allocations (operator new / new[]) made anywhere in the program so far.
+// Linking count_allocations.cpp replaces the global operator new and delete
+// (so only link it into tools that want the count, like the benchmarks):
+//	uint64_t before = allocations_so_far();
+//	...
+//	uint64_t made = allocations_so_far() - before;
+uint64_t allocations_so_far();
@@ -0,0 +1,92 @@
+//Measures the cost of delivering poll() events to a handler,
+// comparing a std::function handler with handlers passed by type.
+//
+//Usage:
+//	./dispatch-bench [connections] [events-per-connection]
+//
+//No sockets are involved: events are fed straight through poll_detail::dispatch,
+// which is the same code the poll() event loop uses.
+
+#include "Connection.hpp"
+#include "Game.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <list>
+#include <cstdint>
+
+int main(int argc, char **argv) {
+	uint32_t connection_count = 64;
+	uint32_t events_per_connection = 100000;
+	if (argc > 1) connection_count = uint32_t(std::stoul(argv[1]));
+	if (argc > 2) events_per_connection = uint32_t(std::stoul(argv[2]));
+	if (argc > 3 || connection_count == 0) {
+		std::cerr << "Usage:\n\t./dispatch-bench [connections] [events-per-connection]" << std::endl;
+		return 1;
+	}
+
+	std::list< Connection > connections(connection_count);
+
+	//a controls message, as sent by the client:
+	std::vector< uint8_t > message;
+	{
+		Connection scratch;
+		Player::Controls controls;
+		controls.left_buttons[0].pressed = true;
+		controls.send_controls_message(&scratch);
+		message = scratch.send_buffer;
+	}
+
+	//run all events through 'handler', print timing:
+	auto run = [&](char const *name, auto &&handler, bool with_data) {
+		for (auto &c : connections) c.recv_buffer.clear();
+		auto before = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < events_per_connection; ++i) {
+			for (auto &c : connections) {
+				if (with_data) c.recv_buffer.insert(c.recv_buffer.end(), message.begin(), message.end());
+				poll_detail::dispatch(handler, &c, Connection::OnRecv);
+			}
+		}
+		auto after = std::chrono::steady_clock::now();
+		double seconds = std::chrono::duration< double >(after - before).count();
+		double events = double(events_per_connection) * double(connection_count);
+		std::cout << "  " << name << ": " << (seconds / events * 1e9) << " ns/event (" << (events / seconds / 1e6) << " M events/s)" << std::endl;
+	};
+
+	//handlers that do almost nothing show the raw dispatch overhead:
+	uint64_t count = 0;
+	auto counting_lambda = [&count](Connection *c, Connection::Event evt) {
+		if (evt == Connection::OnRecv) count += 1;
+	};
+	std::function< void(Connection *, Connection::Event) > counting_function = counting_lambda;
+	struct CountingHandler {
+		uint64_t *count;
+		void on_open(Connection *) { }
+		void on_recv(Connection *) { *count += 1; }
+		void on_close(Connection *) { }
+	} counting_handler{&count};
+
+	//handlers that parse a controls message show the overhead relative to real work:
+	Player::Controls controls;
+	auto parsing_lambda = [&controls](Connection *c, Connection::Event evt) {
+		if (evt == Connection::OnRecv) {
+			while (controls.recv_controls_message(c)) { }
+		}
+	};
+	std::function< void(Connection *, Connection::Event) > parsing_function = parsing_lambda;
+
+	std::cout << connection_count << " connections x " << events_per_connection << " OnRecv events:" << std::endl;
+	std::cout << "empty handler:" << std::endl;
+	run("std::function", counting_function, false);
+	run("lambda (by type)", counting_lambda, false);
+	run("on_recv member (by type)", counting_handler, false);
+	std::cout << "controls-parsing handler:" << std::endl;
+	run("std::function", parsing_function, true);
+	run("lambda (by type)", parsing_lambda, true);
+
+	//(keep 'count' observable so the work isn't optimized away)
+	std::cout << "(" << count << " events counted)" << std::endl;
+
+	return 0;
+}
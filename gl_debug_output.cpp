@@ -0,0 +1,92 @@
+#include "gl_debug_output.hpp"
+
+#include "GL.hpp"
+
+#include <SDL.h>
+
+#include <iostream>
+#include <mutex>
+#include <string>
+
+//KHR_debug isn't part of OpenGL 3.3, so it isn't in GL.hpp:
+namespace {
+	constexpr GLenum DEBUG_OUTPUT = 0x92E0;
+	constexpr GLenum DEBUG_OUTPUT_SYNCHRONOUS = 0x8242;
+	constexpr GLint CONTEXT_FLAG_DEBUG_BIT = 0x00000002;
+
+	constexpr GLenum DEBUG_SEVERITY_NOTIFICATION = 0x826B;
+	constexpr GLenum DEBUG_TYPE_ERROR = 0x824C;
+
+	typedef void (APIENTRY *DebugProc)(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, GLchar const *message, void const *user);
+	typedef void (APIENTRY *DebugMessageCallbackProc)(DebugProc callback, void const *user);
+	typedef void (APIENTRY *DebugMessageControlProc)(GLenum source, GLenum type, GLenum severity, GLsizei count, GLuint const *ids, GLboolean enabled);
+
+	char const *source_name(GLenum source) {
+		switch (source) {
+			case 0x8246: return "API";
+			case 0x8247: return "window system";
+			case 0x8248: return "shader compiler";
+			case 0x8249: return "third party";
+			case 0x824A: return "application";
+			default: return "other";
+		}
+	}
+
+	char const *type_name(GLenum type) {
+		switch (type) {
+			case DEBUG_TYPE_ERROR: return "error";
+			case 0x824D: return "deprecated behavior";
+			case 0x824E: return "undefined behavior";
+			case 0x824F: return "portability";
+			case 0x8250: return "performance";
+			case 0x8268: return "marker";
+			default: return "message";
+		}
+	}
+
+	char const *severity_name(GLenum severity) {
+		switch (severity) {
+			case 0x9146: return "high";
+			case 0x9147: return "medium";
+			case 0x9148: return "low";
+			default: return "notification";
+		}
+	}
+
+	//(may be called from a driver thread)
+	void APIENTRY callback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, GLchar const *message, void const *) {
+		static std::mutex mutex;
+		std::string text = (length < 0 ? std::string(message) : std::string(message, length));
+		while (!text.empty() && (text.back() == '\n' || text.back() == '\r')) text.pop_back();
+
+		std::lock_guard< std::mutex > lock(mutex);
+		std::cerr << (type == DEBUG_TYPE_ERROR ? "WARNING: gl error" : "NOTE: gl") << " (" << type_name(type) << ", "
+			<< severity_name(severity) << " severity, from " << source_name(source) << ", id " << id << "): " << text << std::endl;
+	}
+}
+
+bool gl_debug_output(bool synchronous) {
+	GLint flags = 0;
+	glGetIntegerv(GL_CONTEXT_FLAGS, &flags);
+	if (!(flags & CONTEXT_FLAG_DEBUG_BIT) || !SDL_GL_ExtensionSupported("GL_KHR_debug")) {
+		std::cerr << "NOTE: no debug output from this OpenGL context; checking glGetError instead." << std::endl;
+		return false;
+	}
+
+	auto debug_message_callback = (DebugMessageCallbackProc)SDL_GL_GetProcAddress("glDebugMessageCallback");
+	auto debug_message_control = (DebugMessageControlProc)SDL_GL_GetProcAddress("glDebugMessageControl");
+	if (!debug_message_callback || !debug_message_control) {
+		std::cerr << "NOTE: GL_KHR_debug is advertised but its entrypoints are missing; checking glGetError instead." << std::endl;
+		return false;
+	}
+
+	debug_message_callback(callback, nullptr);
+	//notifications (buffer placement hints and the like) are too chatty to print every frame:
+	debug_message_control(GL_DONT_CARE, GL_DONT_CARE, DEBUG_SEVERITY_NOTIFICATION, 0, nullptr, GL_FALSE);
+	glEnable(DEBUG_OUTPUT);
+	if (synchronous) glEnable(DEBUG_OUTPUT_SYNCHRONOUS);
+	else glDisable(DEBUG_OUTPUT_SYNCHRONOUS);
+
+	gl_debug_output_active = true;
+	return true;
+}
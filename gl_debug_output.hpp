@@ -0,0 +1,22 @@
+#pragma once
+
+//Reports OpenGL errors (and other driver messages) through the KHR_debug
+// message callback, as the driver finds them, instead of checking glGetError
+// after the fact. Call once the context is current (and init_GL() has run):
+//
+//  gl_debug_output();
+//
+//Messages are printed with their source, type, and severity. They arrive
+// asynchronously, so they can't say which call caused them; pass
+// synchronous = true (and set a breakpoint in the callback) to find that out.
+//
+//Does nothing -- and returns false -- if the context doesn't support
+// KHR_debug or wasn't created with SDL_GL_CONTEXT_DEBUG_FLAG, in which case
+// GL_ERRORS() (in gl_errors.hpp) keeps polling glGetError instead.
+
+#include <atomic>
+
+bool gl_debug_output(bool synchronous = false);
+
+//true once the callback is installed:
+inline std::atomic< bool > gl_debug_output_active{false};
@@ -1,12 +1,20 @@
 #pragma once
 
+//GL_ERRORS() prints any pending OpenGL errors, with the file and line it's on.
+// It polls glGetError, which can stall until the driver catches up, so:
+// - once gl_debug_output() (gl_debug_output.hpp) is active, errors are reported
+//   by its callback instead and GL_ERRORS() doesn't poll;
+// - in release builds (NDEBUG; 'RELEASE=1 node Maekfile.js') it compiles to nothing.
+
 #include "GL.hpp"
+#include "gl_debug_output.hpp"
 #include <iostream>
 
 #define STR2(X) # X
 #define STR(X) STR2(X)
 
-inline void gl_errors(std::string const &where) {
+inline void gl_errors(char const *where) {
+	if (gl_debug_output_active.load(std::memory_order_relaxed)) return;
 	GLenum err = 0;
 	while ((err = glGetError()) != GL_NO_ERROR) {
 		#define CHECK( ERR ) \
@@ -27,5 +35,9 @@ inline void gl_errors(std::string const &where) {
 		#undef CHECK
 	}
 }
+#ifdef NDEBUG
+#define GL_ERRORS() ((void)0)
+#else
 #define GL_ERRORS() gl_errors(__FILE__  ":" STR(__LINE__) )
+#endif
 
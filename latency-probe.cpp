@@ -0,0 +1,174 @@
+//Measures input latency against a running server, without a window: plays the part of a
+// client (at 60 frames per second, like the real one) pressing a key every so often, and
+// reports how long each stage from press to the server's response took (see LatencyTrace.hpp).
+//
+//Usage:
+//	./latency-probe <host> <port> [--seconds S] [--players N] [--press-every MS] [--out FILE] [--max-p95 MS]
+//
+//Runs for S seconds (default 10), pressing a key every MS milliseconds (default 250).
+// With --players, N-1 more idle clients join too (e.g. to fill out a match).
+//
+//The table goes to stdout; --out also writes the percentiles as JSON. With --max-p95, the
+// exit code is 1 if the 95th percentile of total latency is over MS milliseconds:
+//	dist/server 15466 &
+//	dist/latency-probe localhost 15466 --max-p95 150
+//(lockstep servers don't send state messages, so they can't be probed)
+
+#include "Game.hpp"
+#include "Connection.hpp"
+#include "LatencyTrace.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <list>
+#include <vector>
+#include <thread>
+#include <cstdint>
+#include <stdexcept>
+
+int main(int argc, char **argv) {
+	using Clock = std::chrono::steady_clock;
+
+	std::string host, port;
+	double seconds = 10.0;
+	uint32_t players = 1;
+	double press_every = 0.25;
+	std::string out_file;
+	double max_p95 = 0.0; //(0: don't check)
+
+	try {
+		std::vector< std::string > positional;
+		for (int argi = 1; argi < argc; ++argi) {
+			std::string arg = argv[argi];
+			auto value = [&]() -> std::string {
+				if (argi + 1 >= argc) throw std::runtime_error("Expected a value after '" + arg + "'.");
+				return argv[++argi];
+			};
+			if (arg == "--seconds") {
+				seconds = std::stod(value());
+			} else if (arg == "--players") {
+				players = uint32_t(std::stoul(value()));
+				if (players < 1) throw std::runtime_error("Need at least one player.");
+			} else if (arg == "--press-every") {
+				press_every = std::stod(value()) / 1000.0;
+			} else if (arg == "--out") {
+				out_file = value();
+			} else if (arg == "--max-p95") {
+				max_p95 = std::stod(value()) / 1000.0;
+			} else if (arg.size() >= 2 && arg.substr(0, 2) == "--") {
+				throw std::runtime_error("Unknown option '" + arg + "'.");
+			} else {
+				positional.emplace_back(arg);
+			}
+		}
+		if (positional.size() != 2) throw std::runtime_error("Expected a host and a port.");
+		host = positional[0];
+		port = positional[1];
+	} catch (std::exception const &e) {
+		std::cerr << e.what() << "\n";
+		std::cerr << "Usage:\n\t./latency-probe <host> <port> [--seconds S] [--players N] [--press-every MS] [--out FILE] [--max-p95 MS]" << std::endl;
+		return 1;
+	}
+
+	LatencyTrace trace;
+
+	try {
+		std::list< Client > clients; //(the first one presses keys; any others just keep their seats)
+		std::vector< Player::Controls > controls(players);
+		for (uint32_t p = 0; p < players; ++p) {
+			clients.emplace_back(host, port);
+		}
+
+		Game game; //(for decoding state messages)
+		float const frame = 1.0f / 60.0f;
+		Clock::time_point start = Clock::now();
+		Clock::time_point end = start + std::chrono::duration_cast< Clock::duration >(std::chrono::duration< double >(seconds));
+		double next_press = 0.5; //(give the server a moment to seat everyone)
+		double release_at = -1.0;
+		uint32_t finger = 0;
+
+		for (uint32_t f = 0; ; ++f) {
+			Clock::time_point frame_start = start + std::chrono::duration_cast< Clock::duration >(std::chrono::duration< double >(f * frame));
+			std::this_thread::sleep_until(frame_start);
+			if (frame_start >= end) break;
+			double now = f * frame;
+
+			//"handle_event": press (and later release) one finger after another:
+			Player::Controls &local = controls[0];
+			if (now >= next_press) {
+				local.left_buttons[finger].downs += 1;
+				local.left_buttons[finger].pressed = true;
+				trace.key();
+				next_press += press_every;
+				release_at = now + 0.1;
+			} else if (release_at >= 0.0 && now >= release_at) {
+				local.left_buttons[finger].pressed = false;
+				finger = (finger + 1) % local.left_buttons.size();
+				release_at = -1.0;
+			}
+
+			//"update": send everyone's controls for this tick, then read whatever the server sent:
+			uint32_t input_tick = uint32_t(now / Game::Tick);
+			auto c = controls.begin();
+			for (auto &client : clients) {
+				c->send_controls_message(&client.connection, input_tick);
+				for (auto &b : c->left_buttons) b.downs = 0;
+				for (auto &b : c->right_buttons) b.downs = 0;
+				++c;
+			}
+			trace.sent(input_tick);
+
+			bool first = true;
+			for (auto &client : clients) {
+				client.poll([&](Connection *connection, Connection::Event event) {
+					if (event == Connection::OnClose) throw std::runtime_error("Lost connection to server.");
+					if (event != Connection::OnRecv) return;
+					uint32_t state_tick, state_input_tick;
+					InputEcho echo;
+					while (true) {
+						if (game.recv_state_message(connection, &state_tick, &state_input_tick, &echo)) {
+							if (first) trace.state(state_input_tick, echo);
+						} else if (recv_ping_message(connection)) {
+							send_pong_message(connection);
+						} else {
+							break;
+						}
+					}
+					if (connection->has_message()) {
+						throw std::runtime_error("Unexpected message type " + std::to_string(int(connection->recv_buffer[0])) + " (is this a lockstep server?).");
+					}
+				}, 0.0);
+				first = false;
+			}
+
+			//"draw":
+			trace.drawn();
+		}
+	} catch (std::exception const &e) {
+		std::cerr << "Probe failed: " << e.what() << std::endl;
+		return 1;
+	}
+
+	std::cout << trace.report();
+	if (!out_file.empty()) {
+		std::ofstream out(out_file, std::ios::binary);
+		trace.write_json(out);
+		if (!out) {
+			std::cerr << "Failed to write '" << out_file << "'." << std::endl;
+			return 1;
+		}
+	}
+
+	LatencyTrace::Summary total = trace.summary(LatencyTrace::Total);
+	if (total.count == 0) {
+		std::cerr << "No presses made it back from the server." << std::endl;
+		return 1;
+	}
+	if (max_p95 > 0.0 && total.p95 > max_p95) {
+		std::cerr << "Total latency p95 " << (total.p95 * 1000.0f) << "ms is over the limit of " << (max_p95 * 1000.0) << "ms." << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -1,4 +1,5 @@
 #include "load_opus.hpp"
+#include "LoadProfile.hpp"
 
 #include <opusfile.h>
 
@@ -24,6 +25,7 @@ void load_opus(std::string const &filename, std::vector< float > *data_) {
 	if (err != 0) {
 		throw std::runtime_error("opusfile error " + std::to_string(err) + " opening \"" + filename + "\".");
 	}
+	LoadProfile::read_file(filename);
 
 	//get length in samples:
 	ogg_int64_t length = op_pcm_total(op.get(), -1);
@@ -1,4 +1,5 @@
 #include "load_save_png.hpp"
+#include "LoadProfile.hpp"
 
 #include <png.h>
 
@@ -21,6 +22,7 @@ void load_png(std::string filename, glm::uvec2 *size, std::vector< glm::u8vec4 >
 	if (!file) {
 		throw std::runtime_error("Failed to open PNG image file '" + filename + "'.");
 	}
+	LoadProfile::read_file(filename);
 	if (!load_png(file, &size->x, &size->y, data, origin)) {
 		throw std::runtime_error("Failed to read PNG image from '" + filename + "'.");
 	}
@@ -105,7 +107,7 @@ bool load_png(std::istream &from, unsigned int *width, unsigned int *height, vec
 	//Ok, should be 32-bit RGBA now.
 
 	png_read_update_info(png, info);
-	size_t rowbytes = png_get_rowbytes(png, info);
+	[[maybe_unused]] size_t rowbytes = png_get_rowbytes(png, info); //(only checked in debug builds)
 	//Make sure it's the format we think it is...
 	assert(rowbytes == w*sizeof(uint32_t));
 
@@ -3,11 +3,43 @@
 #create GL.hpp / GL.cpp by parsing everything from glcorearb.h (why not the regsistry xml, hmmmm?) and selecting only things that are core through version 3_3.
 #get glcorearb.h from https://github.com/KhronosGroup/OpenGL-Registry/raw/master/api/GL/glcorearb.h
 
+#Also generates per-frame call statistics, compiled in with -DENABLE_GL_STATS (GL_STATS=1 node Maekfile.js):
+# every gl call goes through a wrapper that counts it, and the wrappers for the functions
+# listed below also time themselves, count as state changes, or count uploaded bytes.
+# (pass --no-stats to leave the statistics code out of GL.hpp / GL.cpp entirely)
+
 import re
+import sys
+
+emit_stats = "--no-stats" not in sys.argv[1:]
+
+#calls timed (CPU time spent in the call -- for most calls, just queueing work for the driver):
+timed = [
+	"glDrawArrays", "glDrawElements", "glDrawArraysInstanced", "glDrawElementsInstanced",
+	"glBufferData", "glBufferSubData", "glTexImage2D", "glTexSubImage2D",
+	"glClear", "glGetError", "glReadPixels", "glFlush", "glFinish"
+]
+#calls that change pipeline state:
+state_changes = [
+	"glUseProgram", "glBindVertexArray", "glBindTexture", "glActiveTexture", "glBindBuffer",
+	"glBindFramebuffer", "glBindRenderbuffer", "glBindSampler",
+	"glEnable", "glDisable", "glBlendFunc", "glBlendFuncSeparate", "glBlendEquation", "glBlendEquationSeparate",
+	"glDepthFunc", "glDepthMask", "glColorMask", "glCullFace", "glFrontFace", "glPolygonMode",
+	"glViewport", "glScissor"
+]
+#calls that upload 'size' bytes of buffer data:
+uploads = [ "glBufferData", "glBufferSubData" ]
+#calls that upload texels from 'pixels' (expression for the texel count):
+texture_uploads = {
+	"glTexImage1D": "width", "glTexSubImage1D": "width",
+	"glTexImage2D": "width * height", "glTexSubImage2D": "width * height",
+	"glTexImage3D": "width * height * depth", "glTexSubImage3D": "width * height * depth",
+}
 
 filtered = []
 lookups = []
 fps = []
+protos = [] #(return type, name, arguments) of every function
 
 with open('glcorearb.h', 'r') as f:
 	in_version = None
@@ -76,6 +108,8 @@ with open('glcorearb.h', 'r') as f:
 			#check for function prototype lines:
 			m = re.match(r"GLAPI(.*)APIENTRY ([^\s]+) (.*)$", line)
 			if m != None:
+				if mode != "skip":
+					protos.append((m.group(1).strip(), m.group(2), m.group(3)))
 				if mode == "all_proto":
 					filtered.append(line)
 				elif mode == "win_pointer":
@@ -153,6 +187,85 @@ typedef signed   long  int     khronos_ssize_t;
 	print("""
 }""", file=f)
 
+	if emit_stats:
+		print("""
+//------------------------------------------------------------
+//Per-frame call statistics (compiled in with ENABLE_GL_STATS):
+// every gl call goes through a wrapper that counts it; draws, state changes, and
+// buffer and texture uploads are totaled, and a few calls are timed (see make-GL.py for which).
+// Call GLStats::end_frame() once per frame, then read GLStats::last.
+
+#ifdef ENABLE_GL_STATS
+
+#include <array>
+#include <chrono>
+#include <string>
+
+namespace GLStats {
+	enum Function : uint32_t {""", file=f)
+		for (rt, fn, ag) in protos:
+			print("\t\tCall_" + fn + ",", file=f)
+		print("""		FunctionCount
+	};
+	extern std::array< char const *, FunctionCount > const FunctionNames;
+
+	struct Frame {
+		std::array< uint32_t, FunctionCount > calls{};
+		std::array< double, FunctionCount > seconds{}; //(only for timed calls)
+		uint32_t draw_calls = 0;
+		uint32_t state_changes = 0;
+		uint64_t upload_bytes = 0; //buffer data plus texels (ignoring row padding; uploads from a bound GL_PIXEL_UNPACK_BUFFER aren't counted)
+	};
+	extern Frame current; //calls so far this frame
+	extern Frame last; //calls during the previous frame
+
+	//finish the current frame (making it 'last') and start a new one:
+	void end_frame();
+
+	//calls made during 'frame', most frequent first (after a line of totals):
+	std::string report(Frame const &frame);
+
+	//bytes per texel of client data in 'format' and 'type' (0 if unknown):
+	uint32_t texel_bytes(GLenum format, GLenum type);
+
+	struct Timer {
+		Timer(Function function_) : function(function_), begin(std::chrono::steady_clock::now()) { }
+		~Timer() { current.seconds[function] += std::chrono::duration< double >(std::chrono::steady_clock::now() - begin).count(); }
+		Function function;
+		std::chrono::steady_clock::time_point begin;
+	};
+""", file=f)
+		for (rt, fn, ag) in protos:
+			params = ag.strip().rstrip(";").strip()
+			assert params[0] == "(" and params[-1] == ")"
+			names = []
+			if params[1:-1].strip() != "void":
+				for param in params[1:-1].split(","):
+					m = re.search(r"(\w+)\s*(\[\d*\])?\s*$", param)
+					assert m != None, param
+					names.append(m.group(1))
+			print("\tinline " + rt + " " + fn + " " + params + " {", file=f)
+			print("\t\tcurrent.calls[Call_" + fn + "] += 1;", file=f)
+			if fn.startswith("glDraw") or fn.startswith("glMultiDraw"):
+				print("\t\tcurrent.draw_calls += 1;", file=f)
+			if fn in state_changes:
+				print("\t\tcurrent.state_changes += 1;", file=f)
+			if fn in uploads:
+				print("\t\tcurrent.upload_bytes += uint64_t(size);", file=f)
+			if fn in texture_uploads:
+				print("\t\tif (pixels) current.upload_bytes += uint64_t(" + texture_uploads[fn].replace(" * ", ") * uint64_t(") + ") * texel_bytes(format, type);", file=f)
+			if fn in timed:
+				print("\t\tTimer timer(Call_" + fn + ");", file=f)
+			print("\t\treturn (::" + fn + ")(" + ", ".join(names) + ");", file=f)
+			print("\t}", file=f)
+		print("}", file=f)
+		print("", file=f)
+		print("//(a function-like macro only applies to calls, so declarations and function pointers are left alone)", file=f)
+		for (rt, fn, ag) in protos:
+			print("#define " + fn + "(...) GLStats::" + fn + "(__VA_ARGS__)", file=f)
+		print("", file=f)
+		print("#endif //ENABLE_GL_STATS", file=f)
+
 
 with open("GL.cpp", "w") as f:
 	print("""#include "GL.hpp"
@@ -177,3 +290,88 @@ void init_GL() {""", file=f)
 #ifdef _WIN32""", file=f)
 	print("\t" + "\n\t".join(fps),file=f)
 	print("""#endif""", file=f)
+
+	if emit_stats:
+		print("""
+#ifdef ENABLE_GL_STATS
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+std::array< char const *, GLStats::FunctionCount > const GLStats::FunctionNames{{""", file=f)
+		for (rt, fn, ag) in protos:
+			print("\t\"" + fn + "\",", file=f)
+		print("""}};
+
+GLStats::Frame GLStats::current;
+GLStats::Frame GLStats::last;
+
+void GLStats::end_frame() {
+	last = current;
+	current = Frame();
+}
+
+std::string GLStats::report(Frame const &frame) {
+	std::vector< uint32_t > called;
+	uint32_t total = 0;
+	for (uint32_t f = 0; f < FunctionCount; ++f) {
+		if (frame.calls[f] == 0) continue;
+		called.emplace_back(f);
+		total += frame.calls[f];
+	}
+	std::stable_sort(called.begin(), called.end(), [&](uint32_t a, uint32_t b) {
+		return frame.calls[a] > frame.calls[b];
+	});
+
+	std::ostringstream out;
+	out << total << " calls, " << frame.draw_calls << " draws, " << frame.state_changes << " state changes, "
+		<< frame.upload_bytes << " bytes uploaded\\n";
+	out << std::fixed << std::setprecision(3);
+	for (uint32_t f : called) {
+		out << "  " << std::left << std::setw(28) << FunctionNames[f] << std::right << std::setw(6) << frame.calls[f];
+		if (frame.seconds[f] > 0.0) out << "  " << (frame.seconds[f] * 1000.0) << "ms";
+		out << "\\n";
+	}
+	return out.str();
+}
+
+uint32_t GLStats::texel_bytes(GLenum format, GLenum type) {
+	//packed types hold a whole texel:
+	switch (type) {
+		case GL_UNSIGNED_BYTE_3_3_2: case GL_UNSIGNED_BYTE_2_3_3_REV:
+			return 1;
+		case GL_UNSIGNED_SHORT_5_6_5: case GL_UNSIGNED_SHORT_5_6_5_REV:
+		case GL_UNSIGNED_SHORT_4_4_4_4: case GL_UNSIGNED_SHORT_4_4_4_4_REV:
+		case GL_UNSIGNED_SHORT_5_5_5_1: case GL_UNSIGNED_SHORT_1_5_5_5_REV:
+			return 2;
+		case GL_UNSIGNED_INT_8_8_8_8: case GL_UNSIGNED_INT_8_8_8_8_REV:
+		case GL_UNSIGNED_INT_10_10_10_2: case GL_UNSIGNED_INT_2_10_10_10_REV:
+		case GL_UNSIGNED_INT_24_8: case GL_UNSIGNED_INT_10F_11F_11F_REV: case GL_UNSIGNED_INT_5_9_9_9_REV:
+			return 4;
+		case GL_FLOAT_32_UNSIGNED_INT_24_8_REV:
+			return 8;
+	}
+	uint32_t component = 0;
+	switch (type) {
+		case GL_UNSIGNED_BYTE: case GL_BYTE: component = 1; break;
+		case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT: component = 2; break;
+		case GL_UNSIGNED_INT: case GL_INT: case GL_FLOAT: component = 4; break;
+		default: return 0;
+	}
+	switch (format) {
+		case GL_RED: case GL_GREEN: case GL_BLUE: case GL_RED_INTEGER: case GL_GREEN_INTEGER: case GL_BLUE_INTEGER:
+		case GL_DEPTH_COMPONENT: case GL_STENCIL_INDEX:
+			return component;
+		case GL_RG: case GL_RG_INTEGER: case GL_DEPTH_STENCIL:
+			return 2 * component;
+		case GL_RGB: case GL_BGR: case GL_RGB_INTEGER: case GL_BGR_INTEGER:
+			return 3 * component;
+		case GL_RGBA: case GL_BGRA: case GL_RGBA_INTEGER: case GL_BGRA_INTEGER:
+			return 4 * component;
+		default: return 0;
+	}
+}
+
+#endif //ENABLE_GL_STATS""", file=f)
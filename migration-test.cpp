@@ -0,0 +1,167 @@
+//Checks a match handoff end to end (without sockets): the handoff message must carry the source's
+// tick, checkpoint, and resume tokens; a target that has been running for fewer ticks than the
+// source must carry on from the source's tick; and a client following the redirect must go on
+// showing the match as the target runs it (rather than freezing on the source's last snapshots).
+//
+//Usage:
+//	./migration-test
+//
+//Prints each failed check and exits with a nonzero status if there were any.
+
+#include "Migration.hpp"
+#include "SnapshotBuffer.hpp"
+#include "Connection.hpp"
+#include "Game.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+
+static uint32_t failures = 0;
+static void check(bool ok, std::string const &what) {
+	if (!ok) {
+		std::cerr << "FAILED: " << what << std::endl;
+		failures += 1;
+	}
+}
+
+//just enough of a server to stamp state messages (as server.cpp does):
+struct TestServer {
+	Game game{2};
+	uint32_t tick = 0; //(server_tick)
+	bool paused = false; //(as the source is while handing off)
+	uint32_t played = 0; //ticks the game has actually been updated (what the client sees move)
+
+	void step() {
+		tick += 1;
+		if (!paused) {
+			game.update(Game::Tick);
+			played += 1;
+		}
+	}
+};
+
+int main(int argc, char **argv) {
+	if (argc != 1) {
+		std::cerr << "Usage:\n\t./migration-test" << std::endl;
+		return 1;
+	}
+
+	constexpr uint32_t SendEvery = 2; //(ticks between state messages)
+	constexpr double Latency = 0.05; //(seconds from server to client, either server)
+	constexpr uint32_t TransferTicks = 8; //(ticks between the checkpoint and the target loading it; a big checkpoint is slow to send)
+	constexpr uint32_t AckTicks = 4; //(ticks between the target loading the checkpoint and the redirect)
+	constexpr uint32_t ReconnectTicks = 2; //(ticks between the redirect and the target's first state message)
+
+	TestServer source, target;
+	source.game.spawn_player();
+	source.game.spawn_player();
+
+	//the client's view of the match, fed a value that shows how much of the match has been played:
+	SnapshotBuffer snapshots;
+	uint32_t clock = 0; //(client time, in ticks)
+	auto send_state = [&](TestServer const &server) {
+		if (server.tick % SendEvery != 0) return;
+		snapshots.push(server.tick, std::vector< float >{ float(server.played) }, false, clock * double(Game::Tick) + Latency);
+	};
+	auto shown = [&]() {
+		std::vector< float > values;
+		if (!snapshots.sample(clock * double(Game::Tick) + Latency, &values)) return -1.0f;
+		return values[0];
+	};
+
+	//the source has been running for a while, the target only briefly:
+	for (uint32_t i = 0; i < 300; ++i) {
+		source.step();
+		send_state(source);
+		clock += 1;
+		shown();
+	}
+	for (uint32_t i = 0; i < 40; ++i) {
+		target.step();
+	}
+	check(target.tick < source.tick, "target has run fewer ticks than the source");
+
+	//source -> target (through the same encoding the network threads use):
+	Handoff sent;
+	sent.secret = "s3cret";
+	sent.server_tick = source.tick;
+	source.game.save_checkpoint(&sent.checkpoint);
+	for (size_t i = 0; i < source.game.players.size(); ++i) {
+		sent.tokens.emplace_back(make_resume_token());
+	}
+	source.paused = true;
+
+	//(the source keeps ticking, and sending paused states, while the checkpoint is on its way)
+	auto source_step = [&]() {
+		source.step();
+		send_state(source);
+		clock += 1;
+		shown();
+	};
+	for (uint32_t i = 0; i < TransferTicks; ++i) {
+		source_step();
+		target.step();
+	}
+
+	Connection wire;
+	send_handoff_message(&wire, sent);
+	wire.recv_buffer = wire.send_buffer;
+	Handoff got;
+	check(recv_handoff_message(&wire, &got), "handoff message read back");
+	check(wire.recv_buffer.empty(), "handoff message read completely");
+	check(got.secret == sent.secret, "secret round trip");
+	check(got.server_tick == sent.server_tick, "server tick round trip");
+	check(got.checkpoint == sent.checkpoint, "checkpoint round trip");
+	check(got.tokens == sent.tokens, "tokens round trip");
+
+	//the target takes over (as accept_handoff does):
+	target.game.load_checkpoint(got.checkpoint);
+	target.tick = got.server_tick;
+	target.played = source.played;
+	target.paused = true; //(until the players are back)
+	std::vector< uint8_t > reloaded;
+	target.game.save_checkpoint(&reloaded);
+	check(reloaded == sent.checkpoint, "target loaded the checkpoint exactly");
+	check(target.tick == sent.server_tick, "target picked up the source's tick");
+
+	//...until the ack comes back:
+	for (uint32_t i = 0; i < AckTicks; ++i) {
+		source_step();
+		target.step();
+	}
+	check(source.tick > target.tick, "source's last states are stamped after the target's tick");
+
+	//the client follows the redirect (as PlayMode does):
+	snapshots = SnapshotBuffer();
+	for (uint32_t i = 0; i < ReconnectTicks; ++i) {
+		target.step();
+		clock += 1;
+		shown();
+	}
+
+	//the players are back; the target runs the match:
+	target.paused = false;
+	float first_shown = -1.0f;
+	float last_shown = -1.0f;
+	for (uint32_t i = 0; i < 60; ++i) {
+		target.step();
+		send_state(target);
+		clock += 1;
+		last_shown = shown();
+		if (i == 10) first_shown = last_shown;
+	}
+	check(snapshots.dropped == 0, "no target snapshots dropped as out of order (" + std::to_string(snapshots.dropped) + " were)");
+	check(first_shown > float(source.played), "match visibly moving again shortly after the redirect (showing " + std::to_string(first_shown) + " ticks played)");
+	check(std::abs(last_shown - float(target.played)) < 10.0f, "client keeps up with the target (showing " + std::to_string(last_shown) + " of " + std::to_string(target.played) + " ticks played)");
+	check(std::abs(snapshots.interval - SendEvery * double(Game::Tick)) < 1e-3, "snapshot spacing unaffected by the move");
+
+	if (failures) {
+		std::cerr << failures << " checks failed." << std::endl;
+		return 1;
+	}
+	std::cout << "All migration checks passed." << std::endl;
+	return 0;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Connection.hpp"
+#include "Game.hpp"
+
+#include <string>
+#include <stdexcept>
+#include <cstring>
+
+//helpers for reading and writing network messages,
+// which are [type, size_low0, size_mid8, size_high8, data...]:
+
+inline void send_message_header(Connection &connection, Message type, size_t size) {
+	if (size >= (1 << 24)) throw std::runtime_error("Message too large (" + std::to_string(size) + " bytes).");
+	connection.send(type);
+	connection.send(uint8_t(size));
+	connection.send(uint8_t(size >> 8));
+	connection.send(uint8_t(size >> 16));
+}
+
+//returns size of the message at the front of recv_buffer if it is complete and of the given type:
+inline bool peek_message(Connection &connection, Message type, uint32_t *size) {
+	auto &recv_buffer = connection.recv_buffer;
+	if (recv_buffer.size() < 4) return false;
+	if (recv_buffer[0] != uint8_t(type)) return false;
+	*size = (uint32_t(recv_buffer[3]) << 16)
+	      | (uint32_t(recv_buffer[2]) << 8)
+	      |  uint32_t(recv_buffer[1]);
+	return recv_buffer.size() >= 4 + *size;
+}
+
+//bounds-checked reader for a message body:
+struct MessageReader {
+	MessageReader(Connection &connection_, uint32_t size_, char const *what_) : connection(connection_), size(size_), what(what_) { }
+	Connection &connection;
+	uint32_t size;
+	char const *what;
+	uint32_t at = 0;
+
+	void read(void *val, size_t bytes) {
+		if (at + bytes > size) throw std::runtime_error(std::string("Ran out of bytes reading ") + what + " message.");
+		std::memcpy(val, connection.recv_buffer.data() + 4 + at, bytes); //(not &recv_buffer[...]: an empty read can sit one past the end)
+		at += uint32_t(bytes);
+	}
+	template< typename T >
+	void read(T *val) { read(val, sizeof(*val)); }
+	void read(std::string *str) {
+		uint8_t length;
+		read(&length);
+		str->resize(length);
+		read(str->data(), length);
+	}
+
+	//check that the whole message was used and remove it from the buffer:
+	void finish() {
+		if (at != size) throw std::runtime_error(std::string("Trailing data in ") + what + " message.");
+		connection.recv_buffer.erase(connection.recv_buffer.begin(), connection.recv_buffer.begin() + 4 + size);
+	}
+};
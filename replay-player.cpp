@@ -0,0 +1,110 @@
+//Plays back a match replay recorded by the server (./server <port> --replay <file>).
+//
+//Usage:
+//	./replay-player <file> [--seek TICK] [--until TICK] [--speed X] [--every N] [--verify]
+//
+//Seeks to TICK (default 0) by loading the nearest earlier keyframe and running
+// Game::update from there, then plays until TICK (default: the end) at X times
+// real time (default 1; 0 means as fast as possible), printing the match state
+// every N ticks (default 30).
+//
+//With --verify, instead replays the whole file from the start and checks that
+// the simulated state matches every keyframe along the way (exit code 1 if not).
+
+#include "Replay.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <thread>
+
+static char const *hand_name(Hand hand) {
+	if (hand == Hand::Rock) return "rock";
+	if (hand == Hand::Paper) return "paper";
+	if (hand == Hand::Scissors) return "scissors";
+	return "none";
+}
+
+static void print_state(ReplayReader const &replay, Game const &game) {
+	std::cout << "tick " << replay.position << " (" << std::fixed << std::setprecision(2) << (replay.position * replay.tick_length) << "s):"
+		<< " score";
+	for (size_t i = 0; i < game.bary_score.size(); ++i) {
+		std::cout << (i ? " / " : " ") << game.bary_score[i];
+	}
+	std::cout << (game.over ? " [over]" : "");
+	for (size_t i = 0; i < game.seats.size(); ++i) {
+		Player const *player = game.seat(int8_t(i));
+		if (!player) continue;
+		std::cout << " | seat " << i << ": " << hand_name(player->left_hand) << "/" << hand_name(player->right_hand)
+			<< ", stamina " << std::setprecision(1) << player->stamina << (player->win ? ", won" : "");
+	}
+	std::cout << std::endl;
+}
+
+int main(int argc, char **argv) {
+	if (argc < 2) {
+		std::cerr << "Usage:\n\t./replay-player <file> [--seek TICK] [--until TICK] [--speed X] [--every N] [--verify]" << std::endl;
+		return 1;
+	}
+
+	uint32_t seek = 0;
+	uint32_t until = -1U;
+	double speed = 1.0;
+	uint32_t every = 30;
+	bool verify = false;
+	for (int argi = 2; argi < argc; ++argi) {
+		std::string arg = argv[argi];
+		if (arg == "--seek" && argi + 1 < argc) {
+			seek = uint32_t(std::stoul(argv[++argi]));
+		} else if (arg == "--until" && argi + 1 < argc) {
+			until = uint32_t(std::stoul(argv[++argi]));
+		} else if (arg == "--speed" && argi + 1 < argc) {
+			speed = std::stod(argv[++argi]);
+		} else if (arg == "--every" && argi + 1 < argc) {
+			every = std::max(1U, uint32_t(std::stoul(argv[++argi])));
+		} else if (arg == "--verify") {
+			verify = true;
+		} else {
+			std::cerr << "Unknown argument '" << arg << "'." << std::endl;
+			return 1;
+		}
+	}
+
+	ReplayReader replay(argv[1]);
+	std::cout << argv[1] << ": " << replay.ticks << " ticks (" << (replay.ticks * replay.tick_length) << "s), "
+		<< replay.keyframes.size() << " keyframes (every " << replay.keyframe_interval << " ticks)"
+		<< (replay.indexed ? "" : "; recording was not closed, index rebuilt by scanning") << "." << std::endl;
+
+	Game game;
+
+	if (verify) {
+		uint32_t mismatched = 0;
+		auto before = std::chrono::steady_clock::now();
+		replay.seek(0, &game);
+		while (replay.step(&game, &mismatched)) { }
+		double seconds = std::chrono::duration< double >(std::chrono::steady_clock::now() - before).count();
+		std::cout << "replayed " << replay.position << " ticks in " << (seconds * 1e3) << "ms; "
+			<< mismatched << " keyframes differed from the simulation." << std::endl;
+		return mismatched ? 1 : 0;
+	}
+
+	auto before = std::chrono::steady_clock::now();
+	replay.seek(seek, &game);
+	std::cout << "seeked to tick " << replay.position << " in "
+		<< std::chrono::duration< double, std::micro >(std::chrono::steady_clock::now() - before).count() << "us." << std::endl;
+	print_state(replay, game);
+
+	uint32_t start = replay.position;
+	auto start_time = std::chrono::steady_clock::now();
+	while (replay.position < until && replay.step(&game)) {
+		if (speed > 0.0) {
+			double at = (replay.position - start) * replay.tick_length / speed;
+			std::this_thread::sleep_until(start_time + std::chrono::duration_cast< std::chrono::steady_clock::duration >(std::chrono::duration< double >(at)));
+		}
+		if (replay.position % every == 0) print_state(replay, game);
+	}
+	print_state(replay, game);
+
+	return 0;
+}
@@ -4,12 +4,43 @@
 #include "hex_dump.hpp"
 
 #include "Game.hpp"
+#include "Migration.hpp"
+#include "Lockstep.hpp"
+#include "Replay.hpp"
+#include "InputBuffer.hpp"
+#include "Metrics.hpp"
+#include "Trace.hpp"
+#include "FlightRecorder.hpp"
+#include "Memory.hpp"
+#include "SPSCQueue.hpp"
 
 #include <chrono>
 #include <stdexcept>
 #include <iostream>
 #include <cassert>
 #include <unordered_map>
+#include <deque>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <memory>
+#include <cmath>
+
+typedef std::chrono::steady_clock Clock;
+
+//set by SIGTERM when a handoff target is configured:
+static volatile std::sig_atomic_t handoff_requested = 0;
+static void request_handoff(int) {
+	handoff_requested = 1;
+}
+
+//set by SIGINT while recording a replay or trace, so the file gets written properly:
+static volatile std::sig_atomic_t stop_requested = 0;
+static void request_stop(int) {
+	stop_requested = 1;
+}
 
 #ifdef _WIN32
 extern "C" { uint32_t GetACP(); }
@@ -32,92 +63,818 @@ int main(int argc, char **argv) {
 
 	//------------ argument parsing ------------
 
-	if (argc != 2) {
-		std::cerr << "Usage:\n\t./server <port>" << std::endl;
+	//where to move the match on SIGTERM (if anywhere):
+	// (this address is also handed to clients, so it must be reachable from them)
+	std::string handoff_host, handoff_port;
+	//handoffs are only sent with, and only accepted with, this secret (from the environment, so it stays out of 'ps'):
+	// (no secret means this server neither sends nor accepts handoffs)
+	std::string handoff_secret;
+	if (char const *secret = std::getenv("SERVER_HANDOFF_SECRET")) handoff_secret = secret;
+	//relay inputs instead of sending state (see Lockstep.hpp):
+	bool lockstep_mode = false;
+	//file to record the match to (see Replay.hpp):
+	std::string replay_path;
+	//players in the ring:
+	uint32_t match_size = 3;
+	//state messages per second (clients interpolate between them; see SnapshotBuffer.hpp):
+	float send_rate = 15.0f;
+	//file to keep rewriting with current metrics (see Metrics.hpp):
+	std::string stats_path;
+	//seconds of tick work that count as a hitch (recent events get dumped; see FlightRecorder.hpp):
+	double hitch_budget = 0.1;
+
+	bool usage = (argc < 2);
+	for (int argi = 2; argi < argc && !usage; ++argi) {
+		std::string arg = argv[argi];
+		if (arg == "--handoff-to" && argi + 2 < argc) {
+			handoff_host = argv[++argi];
+			handoff_port = argv[++argi];
+		} else if (arg == "--lockstep") {
+			lockstep_mode = true;
+		} else if (arg == "--replay" && argi + 1 < argc) {
+			replay_path = argv[++argi];
+		} else if (arg == "--stats" && argi + 1 < argc) {
+			stats_path = argv[++argi];
+		} else if (arg == "--hitch-budget" && argi + 1 < argc) {
+			hitch_budget = std::stod(argv[++argi]) / 1000.0;
+		} else if (arg == "--send-rate" && argi + 1 < argc) {
+			send_rate = std::stof(argv[++argi]);
+			if (!(send_rate > 0.0f && send_rate * Game::Tick < 1.001f)) {
+				std::cerr << "The send rate must be above 0 and at most the tick rate (" << std::lround(1.0f / Game::Tick) << ")." << std::endl;
+				usage = true;
+			}
+		} else if (arg == "--players" && argi + 1 < argc) {
+			match_size = uint32_t(std::stoul(argv[++argi]));
+			if (match_size < 2 || match_size > Game::MaxPlayers) {
+				std::cerr << "Matches need between 2 and " << Game::MaxPlayers << " players." << std::endl;
+				usage = true;
+			}
+		} else {
+			usage = true;
+		}
+	}
+	if (!handoff_host.empty() && handoff_secret.empty()) {
+		std::cerr << "Handing off a match needs a shared secret in SERVER_HANDOFF_SECRET (the same on both servers)." << std::endl;
+		usage = true;
+	}
+	if (handoff_secret.size() > 255) {
+		std::cerr << "SERVER_HANDOFF_SECRET can be at most 255 bytes." << std::endl;
+		usage = true;
+	}
+	if (lockstep_mode && !handoff_host.empty()) {
+		std::cerr << "Lockstep matches can't be handed off (checkpoints hold Game state, not LockstepGame state)." << std::endl;
+		usage = true;
+	}
+	if (lockstep_mode && match_size != LockstepGame::Seats) {
+		std::cerr << "Lockstep matches are always " << LockstepGame::Seats << " players." << std::endl;
+		usage = true;
+	}
+	if (lockstep_mode && !replay_path.empty()) {
+		std::cerr << "Lockstep matches can't be recorded (replays hold Game state, not LockstepGame state)." << std::endl;
+		usage = true;
+	}
+	if (usage) {
+		std::cerr << "Usage:\n\t./server <port> [--players N] [--send-rate HZ] [--lockstep] [--replay <file>] [--stats <file>] [--hitch-budget MS] [--handoff-to <host> <port>]\n"
+			"(set SERVER_HANDOFF_SECRET to the same secret on two servers to let them hand off matches)" << std::endl;
 		return 1;
 	}
 
+	FlightRecorder::configure("server", hitch_budget);
+
 	//------------ initialization ------------
 
 	Server server(argv[1]);
 
-	//------------ main loop ------------
+	//clients send controls every frame, so a few quiet seconds means something is wrong:
+	server.timeouts.handshake = 5.0;
+	server.timeouts.keepalive = 2.0;
+	server.timeouts.idle = 5.0;
 
-	//keep track of which connection is controlling which player:
-	std::unordered_map< Connection *, Player * > connection_to_player;
-	//keep track of game state:
-	Game game;
+	if (!handoff_host.empty()) {
+		std::signal(SIGTERM, request_handoff);
+		std::cout << "Will hand off the match to " << handoff_host << ":" << handoff_port << " on SIGTERM." << std::endl;
+	}
+	if (!handoff_secret.empty() && !lockstep_mode) {
+		std::cout << "Accepting handoffs from servers with the shared secret." << std::endl;
+	}
 
-	while (true) {
-		static auto next_tick = std::chrono::steady_clock::now() + std::chrono::duration< double >(Game::Tick);
-		//process incoming data from clients until a tick has elapsed:
-		while (true) {
-			auto now = std::chrono::steady_clock::now();
-			double remain = std::chrono::duration< double >(next_tick - now).count();
-			if (remain < 0.0) {
-				next_tick += std::chrono::duration< double >(Game::Tick);
-				break;
-			}
-
-			//helper used on client close (due to quit) and server close (due to error):
-			auto remove_connection = [&](Connection *c) {
-				auto f = connection_to_player.find(c);
-				assert(f != connection_to_player.end());
-				game.remove_player(f->second);
-				connection_to_player.erase(f);
-			};
+	//------------ pipeline ------------
+	//The server runs as two threads:
+	// - the network thread polls sockets, parses messages, and forwards them to the simulation thread;
+	// - the simulation thread drains forwarded events at the start of each tick, updates the game, and encodes
+	//   state messages which it hands back to the network thread for sending.
+	//Connections are referred to by a numeric id on both sides, since Connection objects belong to the network thread.
 
-			server.poll([&](Connection *c, Connection::Event evt){
-				if (evt == Connection::OnOpen) {
-					//client connected:
+	//Connections aren't given a player until their first message arrives, since a connection may also be
+	// a client resuming a migrated match (C2S_Resume) or another server handing off its match (S2S_Handoff).
+	// (the network thread's per-connection coroutine, 'serve', sorts this out before anything else)
 
-					//create some player info for them:
-					if (connection_to_player.size() < 3) {
-						connection_to_player.emplace(c, game.spawn_player());
-					} else {
-						c->close();
-					}
-				} else if (evt == Connection::OnClose) {
-					//client disconnected:
+	//network -> simulation:
+	struct NetEvent {
+		enum Type : uint8_t {
+			Controls, //a client sent a controls message (controls.downs are the downs from that message alone)
+			Resume, //a client is reclaiming its player after a handoff
+			Handoff, //another server sent its match
+			Close, //a client disconnected
+			HandoffDone, //the handoff target answered (or didn't) our own handoff
+		} type = Controls;
+		uint32_t id = 0;
+		Player::Controls controls;
+		uint32_t tick = 0; //(Controls) client tick the controls are meant for
+		uint64_t token = 0; //(Resume)
+		::Handoff handoff; //(Handoff)
+		bool acked = false; //(HandoffDone) did the target take the match?
+		std::string why; //(HandoffDone) if not, why not
+		Clock::time_point queued;
+	};
+
+	//simulation -> network:
+	struct SimEvent {
+		enum Type : uint8_t {
+			Send, //append bytes to the connection's send buffer
+			Close, //close the connection (e.g., no player slot for it)
+			Handoff, //connect to the handoff target, send it 'bytes', and report back with a HandoffDone
+			CancelHandoff, //stop waiting on the handoff target (no HandoffDone follows)
+		} type = Send;
+		uint32_t id = 0; //(not used by Handoff / CancelHandoff)
+		std::vector< uint8_t > bytes;
+		Clock::time_point queued;
+	};
+
+	SPSCQueue< NetEvent, 1024 > to_sim;
+	SPSCQueue< SimEvent, 1024 > to_net;
+
+	//queue-depth and push-to-pop latency counters:
+	// (the pushing and popping threads both write these while the simulation thread reports them;
+	//  totals only ever grow and report() subtracts what it last printed, while maximums are
+	//  raised with a compare-exchange loop so a concurrent reset can't be overwritten by a stale value)
+	struct QueueStats {
+		std::atomic< uint64_t > count{0}; //values passed through the queue
+		std::atomic< uint64_t > max_depth{0}; //deepest the queue has been after a push (since the last report)
+		std::atomic< uint64_t > stalls{0}; //pushes that found the queue full
+		std::atomic< uint64_t > latency_ns{0}; //total push-to-pop time
+		std::atomic< uint64_t > max_latency_ns{0}; //largest push-to-pop time (since the last report)
+
+		//totals as of the last report (only touched by the reporting thread):
+		uint64_t reported_count = 0;
+		uint64_t reported_stalls = 0;
+		uint64_t reported_latency_ns = 0;
+
+		static void raise(std::atomic< uint64_t > &max, uint64_t value) {
+			uint64_t seen = max.load(std::memory_order_relaxed);
+			while (value > seen && !max.compare_exchange_weak(seen, value, std::memory_order_relaxed)) { }
+		}
+		void pushed(size_t depth) {
+			raise(max_depth, depth);
+		}
+		void popped(Clock::time_point queued) {
+			uint64_t ns = uint64_t(std::chrono::duration_cast< std::chrono::nanoseconds >(Clock::now() - queued).count());
+			//(latency first, so a report that sees this pop's count also sees its latency)
+			latency_ns.fetch_add(ns, std::memory_order_relaxed);
+			count.fetch_add(1, std::memory_order_release);
+			raise(max_latency_ns, ns);
+		}
+		void report(char const *name, size_t depth) {
+			uint64_t total_count = count.load(std::memory_order_acquire);
+			uint64_t total_latency_ns = latency_ns.load(std::memory_order_relaxed);
+			uint64_t total_stalls = stalls.load(std::memory_order_relaxed);
+			uint64_t n = total_count - reported_count;
+			uint64_t latency = total_latency_ns - reported_latency_ns;
+			uint64_t stalled = total_stalls - reported_stalls;
+			reported_count = total_count;
+			reported_latency_ns = total_latency_ns;
+			reported_stalls = total_stalls;
+
+			std::cout << "  " << name << ": depth " << depth << " (max " << max_depth.exchange(0, std::memory_order_relaxed) << ")"
+				<< ", " << n << " transfers"
+				<< ", latency avg " << (n ? latency / n / 1000.0 : 0.0) << "us"
+				<< " max " << max_latency_ns.exchange(0, std::memory_order_relaxed) / 1000.0 << "us"
+				<< ", " << stalled << " stalls" << std::endl;
+		}
+	};
+	QueueStats to_sim_stats, to_net_stats;
+
+	//set by the simulation thread once the match has moved elsewhere:
+	std::atomic< bool > quit{false};
+
+	//------------ network thread ------------
 
-					remove_connection(c);
+	std::thread network_thread([&](){
+		RECORD_THREAD("network");
+		//keep track of connection ids:
+		std::unordered_map< Connection *, uint32_t > connection_to_id;
+		std::unordered_map< uint32_t, Connection * > id_to_connection;
+		uint32_t next_id = 1;
 
-				} else { assert(evt == Connection::OnRecv);
-					//got data from client:
-					//std::cout << "current buffer:\n" << hex_dump(c->recv_buffer); std::cout.flush(); //DEBUG
+		//events that didn't fit in the queue (delivered in order once there is space):
+		std::deque< NetEvent > backlog;
+		auto forward = [&](NetEvent &&evt) {
+			evt.queued = Clock::now();
+			if (backlog.empty() && to_sim.push(std::move(evt))) {
+				to_sim_stats.pushed(to_sim.size());
+			} else {
+				to_sim_stats.stalls.fetch_add(1, std::memory_order_relaxed);
+				Metrics::add(Metrics::QueueFull);
+				backlog.emplace_back(std::move(evt));
+			}
+		};
+
+		//each connection's messages are parsed by a coroutine (see ConnectionTask.hpp), resumed by server.poll():
+		std::unordered_map< Connection *, ConnectionTask > tasks;
+
+		//helper used on client close (due to quit) and server close (due to error):
+		auto remove_connection = [&](Connection *c) {
+			tasks.erase(c); //(a suspended task must go before its connection does)
+			auto f = connection_to_id.find(c);
+			if (f == connection_to_id.end()) return; //already removed
+			NetEvent evt;
+			evt.type = NetEvent::Close;
+			evt.id = f->second;
+			forward(std::move(evt));
+			id_to_connection.erase(f->second);
+			connection_to_id.erase(f);
+			Metrics::add(Metrics::ConnectionsClosed);
+		};
+
+		//read the message at the front of a connection's recv_buffer into 'msg',
+		// returning false if there is nothing to forward to the simulation thread (throws on unexpected messages):
+		enum Expect : uint8_t { FirstMessage, LaterMessage };
+		auto recv_message = [&](Connection &c, Expect expect, NetEvent *msg) -> bool {
+			uint8_t type = c.recv_buffer[0];
+			size_t buffered = c.recv_buffer.size();
+			bool to_forward = true;
+			if (msg->controls.recv_controls_message(&c, &msg->tick)) {
+				msg->type = NetEvent::Controls;
+			} else if (expect == FirstMessage && recv_resume_message(&c, &msg->token)) {
+				msg->type = NetEvent::Resume;
+			} else if (expect == FirstMessage && recv_handoff_message(&c, &msg->handoff)) {
+				//anyone can connect to this port, so only take matches from servers that know the secret:
+				if (!handoff_secret_matches(handoff_secret, msg->handoff.secret)) throw std::runtime_error("Handoff without the shared secret.");
+				msg->type = NetEvent::Handoff;
+			} else if (expect == LaterMessage && recv_pong_message(&c)) {
+				//answer to a keepalive ping; receiving it already reset the read-idle deadline:
+				to_forward = false;
+			} else {
+				throw std::runtime_error("Unexpected message type " + std::to_string(int(type)) + (expect == FirstMessage ? " to start a connection." : "."));
+			}
+			Metrics::message_received(type, buffered - c.recv_buffer.size());
+			return to_forward;
+		};
 
-					//look up in players list:
-					auto f = connection_to_player.find(c);
-					assert(f != connection_to_player.end());
-					Player &player = *f->second;
+		//the protocol, from the server's side of one connection:
+		// (a lambda, so it can use forward(); frames hold a reference to it, which outlives every task)
+		auto serve = [&](Connection &c, uint32_t id) -> ConnectionTask {
+			//handshake: the first message says whether this is a new player (controls),
+			// a player returning after a handoff (resume), or another server handing off its match:
+			if (!co_await c.read_message()) co_return; //(closed before saying anything)
+			{
+				NetEvent msg;
+				msg.id = id;
+				recv_message(c, FirstMessage, &msg);
+				forward(std::move(msg));
+			}
+			c.established = true; //(switches from the handshake deadline to keepalives)
+
+			//after that, just controls (and answers to pings):
+			while (co_await c.read_message()) {
+				NetEvent msg;
+				msg.id = id;
+				if (recv_message(c, LaterMessage, &msg)) forward(std::move(msg));
+			}
+		};
+
+		//our own handoff (see SimEvent::Handoff) runs on an outgoing connection, so polling continues while it is in flight:
+		Connection *handoff_target = nullptr;
+		ConnectionTask handoff_task;
+		auto await_handoff_ack = [&](Connection &target) -> ConnectionTask {
+			NetEvent result;
+			result.type = NetEvent::HandoffDone;
+			try {
+				if (!co_await target.read_message()) throw std::runtime_error("target closed the connection");
+				if (!recv_handoff_ack_message(&target)) throw std::runtime_error("unexpected reply from target");
+				result.acked = true;
+			} catch (std::exception const &e) {
+				result.why = e.what();
+			}
+			target.close();
+			handoff_target = nullptr;
+			forward(std::move(result));
+		};
 
-					//handle messages from client:
+		while (!quit.load(std::memory_order_relaxed)) {
+			//deliver anything left over from a full queue:
+			while (!backlog.empty() && to_sim.push(std::move(backlog.front()))) {
+				backlog.pop_front();
+				to_sim_stats.pushed(to_sim.size());
+			}
+
+			{ //receive and parse messages from clients:
+				RECORD_SCOPE("Server::poll");
+				server.poll([&](Connection *c, Connection::Event evt){
+					if (evt == Connection::OnOpen) {
+						//client connected; the simulation thread hears about it with its first message:
+						uint32_t id = next_id++;
+						connection_to_id.emplace(c, id);
+						id_to_connection.emplace(id, c);
+						tasks.emplace(c, serve(*c, id));
+						Metrics::add(Metrics::ConnectionsOpened);
+					} else if (evt == Connection::OnIdle) {
+						//client has gone quiet; probe it, and if nothing (not even a pong) comes back before
+						// Timeouts::idle, poll() closes the connection and OnClose frees its player slot:
+						std::cout << "Client " << c->socket << " has not sent anything for " << server.timeouts.keepalive << " seconds; pinging." << std::endl;
+						send_ping_message(c);
+						Metrics::message_sent(uint8_t(Message::S2C_Ping), 4);
+					} else if (evt == Connection::OnClose) {
+						//client disconnected:
+						remove_connection(c);
+					} else { assert(evt == Connection::OnRecv);
+						//got data from client; its task is resumed once a whole message is in:
+						//std::cout << "current buffer:\n" << hex_dump(c->recv_buffer); std::cout.flush(); //DEBUG
+					}
+				}, 0.001);
+
+				//drop clients whose tasks failed (e.g., on a malformed message):
+				for (auto t = tasks.begin(); t != tasks.end(); ) {
+					Connection *c = t->first;
+					if (!t->second.done()) {
+						++t;
+						continue;
+					}
 					try {
-						bool handled_message;
-						do {
-							handled_message = false;
-							if (player.controls.recv_controls_message(c)) handled_message = true;
-							//TODO: extend for more message types as needed
-						} while (handled_message);
+						t->second.rethrow_if_failed();
+						++t; //(finished because the connection closed; OnClose removes it)
 					} catch (std::exception const &e) {
 						std::cout << "Disconnecting client:" << e.what() << std::endl;
+						Metrics::add(Metrics::ParseErrors);
+						t = tasks.erase(t);
 						c->close();
 						remove_connection(c);
 					}
 				}
-			}, remain);
+			}
+
+			//send whatever the simulation thread has produced:
+			SimEvent out;
+			while (to_net.pop(&out)) {
+				to_net_stats.popped(out.queued);
+				if (out.type == SimEvent::Handoff) {
+					assert(!handoff_target);
+					try {
+						handoff_target = server.connect(handoff_host, handoff_port);
+					} catch (std::exception const &e) {
+						NetEvent result;
+						result.type = NetEvent::HandoffDone;
+						result.why = e.what();
+						forward(std::move(result));
+						continue;
+					}
+					Metrics::message_sent(out.bytes[0], out.bytes.size());
+					handoff_target->send_buffer = std::move(out.bytes);
+					handoff_task = await_handoff_ack(*handoff_target);
+					continue;
+				} else if (out.type == SimEvent::CancelHandoff) {
+					handoff_task = ConnectionTask(); //(detaches it from the connection)
+					if (handoff_target) handoff_target->close();
+					handoff_target = nullptr;
+					continue;
+				}
+				auto f = id_to_connection.find(out.id);
+				if (f == id_to_connection.end()) continue; //connection already gone
+				Connection *c = f->second;
+				if (out.type == SimEvent::Send) {
+					if (!out.bytes.empty()) Metrics::message_sent(out.bytes[0], out.bytes.size());
+					c->send_buffer.insert(c->send_buffer.end(), out.bytes.begin(), out.bytes.end());
+				} else { assert(out.type == SimEvent::Close);
+					tasks.erase(c);
+					c->close();
+					connection_to_id.erase(c);
+					id_to_connection.erase(f);
+					Metrics::add(Metrics::ConnectionsClosed);
+				}
+			}
+
+			size_t send_buffer_bytes = 0, send_buffer_max = 0;
+			for (auto const &[id, c] : id_to_connection) {
+				send_buffer_bytes += c->send_buffer.size();
+				send_buffer_max = std::max(send_buffer_max, c->send_buffer.size());
+			}
+			Metrics::set(Metrics::Connections, int64_t(connection_to_id.size()));
+			Metrics::set(Metrics::SendBufferBytes, int64_t(send_buffer_bytes));
+			Metrics::set(Metrics::SendBufferMaxBytes, int64_t(send_buffer_max));
+			Metrics::set(Metrics::ToSimulationDepth, int64_t(to_sim.size()));
+			Metrics::set(Metrics::BacklogEvents, int64_t(backlog.size()));
+		}
+
+		//(tasks refer to 'serve' and 'await_handoff_ack', so must go before they do)
+		tasks.clear();
+		handoff_task = ConnectionTask();
+	});
+
+	//------------ stats file ------------
+
+	//rewritten every second by its own thread, so file I/O never holds up a tick:
+	std::thread stats_thread;
+	if (!stats_path.empty()) {
+		std::cout << "[server] writing metrics to '" << stats_path << "' every second." << std::endl;
+		stats_thread = std::thread([&](){
+			while (!quit.load(std::memory_order_relaxed)) {
+				Metrics::write_file(stats_path);
+				for (uint32_t i = 0; i < 10 && !quit.load(std::memory_order_relaxed); ++i) {
+					std::this_thread::sleep_for(std::chrono::milliseconds(100));
+				}
+			}
+			Metrics::write_file(stats_path);
+		});
+	}
+
+	//------------ simulation thread (main loop) ------------
+
+	//keep track of which connection is controlling which player:
+	std::unordered_map< uint32_t, PlayerHandle > connection_to_player;
+	//keep track of game state:
+	Game game(match_size);
+
+	//events that didn't fit in the queue (delivered in order once there is space):
+	std::deque< SimEvent > backlog;
+	uint64_t sent_bytes = 0; //(since last report)
+	auto forward = [&](SimEvent &&evt) {
+		evt.queued = Clock::now();
+		sent_bytes += evt.bytes.size();
+		if (backlog.empty() && to_net.push(std::move(evt))) {
+			to_net_stats.pushed(to_net.size());
+		} else {
+			to_net_stats.stalls.fetch_add(1, std::memory_order_relaxed);
+			Metrics::add(Metrics::QueueFull);
+			backlog.emplace_back(std::move(evt));
+		}
+	};
+
+	//used to encode state messages without touching the network thread's connections:
+	Connection encoder;
+
+	auto close_connection = [&](uint32_t id) {
+		SimEvent close;
+		close.type = SimEvent::Close;
+		close.id = id;
+		forward(std::move(close));
+	};
+
+	//jitter buffers, so each player's input lands on the tick it was meant for (by connection id):
+	std::unordered_map< uint32_t, InputBuffer > input_buffers;
+	uint32_t server_tick = 0;
+	uint32_t const send_every = std::max(1U, uint32_t(std::lround(1.0f / (send_rate * Game::Tick)))); //(ticks between state messages)
+
+	//------------ lockstep mode ------------
+
+	//the simulation clients run (the server runs it too, to hash the result of each frame):
+	LockstepGame lockstep;
+	bool lockstep_restart = false; //set when players come or go, so everyone needs a fresh start message
+
+	//------------ replay recording ------------
+
+	std::unique_ptr< ReplayWriter > replay;
+	if (!replay_path.empty()) {
+		replay = std::make_unique< ReplayWriter >(replay_path);
+		std::signal(SIGINT, request_stop);
+		std::cout << "[server] recording replay to '" << replay_path << "'." << std::endl;
+	}
+
+	//------------ match migration ------------
+
+	//as the target: players held for clients that haven't reconnected yet (by resume token).
+	// The game doesn't tick until they are all back or the deadline passes.
+	std::unordered_map< uint64_t, PlayerHandle > awaiting_resume;
+	Clock::time_point resume_deadline;
+	Clock::time_point handoff_received;
+
+	//as the source: while the target is loading the checkpoint the game is paused (though ticks go on as usual),
+	// and once it has acked, wait for clients to follow their redirects, then exit.
+	bool handing_off = false;
+	Clock::time_point handoff_started;
+	Clock::time_point handoff_deadline;
+	size_t handoff_checkpoint_bytes = 0;
+	std::unordered_map< int8_t, uint64_t > seat_to_token; //(for the redirects)
+	bool draining = false;
+	Clock::time_point drain_deadline;
+
+	//checkpoint the match and have the network thread send it to the handoff target:
+	auto start_handoff = [&]() {
+		handoff_started = Clock::now();
+
+		Handoff handoff;
+		handoff.secret = handoff_secret;
+		handoff.server_tick = server_tick;
+		game.save_checkpoint(&handoff.checkpoint);
+		seat_to_token.clear();
+		for (auto const &player : game.players) {
+			handoff.tokens.emplace_back(make_resume_token());
+			seat_to_token.emplace(player.index, handoff.tokens.back());
+		}
+		handoff_checkpoint_bytes = handoff.checkpoint.size();
+
+		encoder.send_buffer.clear();
+		send_handoff_message(&encoder, handoff);
+		SimEvent send;
+		send.type = SimEvent::Handoff;
+		send.bytes = encoder.send_buffer;
+		forward(std::move(send));
+
+		handing_off = true;
+		handoff_deadline = handoff_started + std::chrono::seconds(1);
+	};
+
+	//the target has the match (or never will):
+	auto finish_handoff = [&](bool acked, std::string const &why) {
+		handing_off = false;
+		if (!acked) {
+			std::cerr << "[server] handoff failed (" << why << "); continuing match here. Send SIGTERM again to stop without handing off." << std::endl;
+			std::signal(SIGTERM, SIG_DFL);
+			return;
+		}
+
+		for (auto const &[id, player] : connection_to_player) {
+			auto f = seat_to_token.find(game.players.get(player)->index);
+			if (f == seat_to_token.end()) continue; //(joined after the checkpoint; can't follow)
+			Redirect redirect;
+			redirect.token = f->second;
+			redirect.host = handoff_host;
+			redirect.port = handoff_port;
+			encoder.send_buffer.clear();
+			send_redirect_message(&encoder, redirect);
+			SimEvent send;
+			send.type = SimEvent::Send;
+			send.id = id;
+			send.bytes = encoder.send_buffer;
+			forward(std::move(send));
+		}
+
+		draining = true;
+		drain_deadline = Clock::now() + std::chrono::seconds(2);
+		std::cout << "[server] handed off match (" << handoff_checkpoint_bytes << " byte checkpoint) to "
+			<< handoff_host << ":" << handoff_port << "; game paused for "
+			<< std::chrono::duration< double, std::milli >(Clock::now() - handoff_started).count() << "ms; redirecting "
+			<< connection_to_player.size() << " clients." << std::endl;
+	};
+
+	//take over a match sent by another server:
+	auto accept_handoff = [&](uint32_t id, Handoff const &handoff) {
+		if (lockstep_mode) {
+			std::cerr << "[server] refusing handoff: lockstep servers can't load checkpoints." << std::endl;
+			close_connection(id);
+			return;
+		}
+		if (draining || handing_off || !game.players.empty() || !connection_to_player.empty() || !awaiting_resume.empty()) {
+			std::cerr << "[server] refusing handoff: already hosting a match." << std::endl;
+			close_connection(id);
+			return;
+		}
+		try {
+			game.load_checkpoint(handoff.checkpoint);
+			if (handoff.tokens.size() != game.players.size()) throw std::runtime_error("token count doesn't match player count");
+		} catch (std::exception const &e) {
+			std::cerr << "[server] refusing handoff: " << e.what() << std::endl;
+			game = Game(match_size);
+			close_connection(id);
+			return;
+		}
+		//pick up the source's tick count, so clients see state stamped as if the match never moved:
+		server_tick = handoff.server_tick;
+		for (size_t i = 0; i < game.players.size(); ++i) {
+			awaiting_resume.emplace(handoff.tokens[i], game.players.handle_at(i));
+		}
+		handoff_received = Clock::now();
+		resume_deadline = handoff_received + std::chrono::seconds(1);
+
+		encoder.send_buffer.clear();
+		send_handoff_ack_message(&encoder);
+		SimEvent send;
+		send.type = SimEvent::Send;
+		send.id = id;
+		send.bytes = encoder.send_buffer;
+		forward(std::move(send));
+
+		std::cout << "[server] accepted handoff of a match with " << game.players.size() << " players." << std::endl;
+	};
+
+	RECORD_THREAD("simulation");
+	std::signal(SIGINT, request_stop); //(so the memory report, and any trace, get written on ctrl-c)
+
+	auto next_tick = Clock::now() + std::chrono::duration_cast< Clock::duration >(std::chrono::duration< double >(Game::Tick));
+	auto next_report = Clock::now() + std::chrono::seconds(10);
+	while (true) {
+		std::this_thread::sleep_until(next_tick);
+		Metrics::observe(Metrics::TickLateSeconds, std::chrono::duration< double >(Clock::now() - next_tick).count());
+		next_tick += std::chrono::duration_cast< Clock::duration >(std::chrono::duration< double >(Game::Tick));
+		server_tick += 1;
+
+		//time this tick's work, however the iteration ends (and dump the flight recorder if it runs over budget):
+		struct TickTimer {
+			FlightRecorder::Watch watch{"tick"};
+			Clock::time_point start = Clock::now();
+			~TickTimer() {
+				double seconds = std::chrono::duration< double >(Clock::now() - start).count();
+				Metrics::add(Metrics::Ticks);
+				Metrics::observe(Metrics::TickSeconds, seconds);
+				if (seconds > Game::Tick) Metrics::add(Metrics::TicksOverBudget);
+			}
+		} tick_timer;
+		if (Clock::now() >= next_report) {
+			next_report += std::chrono::seconds(10);
+			std::cout << "[server] sending " << (sent_bytes / 10) << " bytes/s of game messages; pipeline:" << std::endl;
+			sent_bytes = 0;
+			to_sim_stats.report("network -> simulation", to_sim.size());
+			to_net_stats.report("simulation -> network", to_net.size());
+			for (auto const &[id, handle] : connection_to_player) {
+				auto f = input_buffers.find(id);
+				if (f == input_buffers.end()) continue;
+				InputBuffer &buffer = f->second;
+				std::cout << "  seat " << int(game.players.get(handle)->index) << " input: depth " << buffer.depth
+					<< " ticks (" << buffer.buffered() << " buffered), " << buffer.late << " late, "
+					<< buffer.starved << " starved, " << buffer.merged << " merged, max jitter " << buffer.max_jitter << " ticks" << std::endl;
+				buffer.reset_stats();
+			}
+		}
+
+		//handle everything the network thread has received since last tick:
+		NetEvent evt;
+		while (to_sim.pop(&evt)) {
+			to_sim_stats.popped(evt.queued);
+			if (evt.type == NetEvent::Close) {
+				auto f = connection_to_player.find(evt.id);
+				if (f == connection_to_player.end()) continue; //was never given a player
+				if (lockstep_mode) {
+					lockstep.leave(game.players.get(f->second)->index);
+					lockstep_restart = true;
+				}
+				if (!draining) game.remove_player(f->second);
+				connection_to_player.erase(f);
+				input_buffers.erase(evt.id);
+			} else if (evt.type == NetEvent::Handoff) {
+				accept_handoff(evt.id, evt.handoff);
+			} else if (evt.type == NetEvent::HandoffDone) {
+				if (handing_off) finish_handoff(evt.acked, evt.why); //(else: already given up on it)
+			} else if (evt.type == NetEvent::Resume) {
+				auto f = awaiting_resume.find(evt.token);
+				if (f == awaiting_resume.end() || connection_to_player.count(evt.id)) {
+					std::cout << "[server] rejecting resume with unknown token." << std::endl;
+					close_connection(evt.id);
+					continue;
+				}
+				connection_to_player.emplace(evt.id, f->second);
+				awaiting_resume.erase(f);
+				if (awaiting_resume.empty()) {
+					std::cout << "[server] all players resumed "
+						<< std::chrono::duration< double, std::milli >(Clock::now() - handoff_received).count() << "ms after handoff." << std::endl;
+				}
+			} else { assert(evt.type == NetEvent::Controls);
+				auto f = connection_to_player.find(evt.id);
+				if (f == connection_to_player.end()) {
+					//first message from a new client; create some player info for them (if there is room):
+					if (draining || handing_off || connection_to_player.size() + awaiting_resume.size() >= game.match_size()) {
+						close_connection(evt.id);
+						continue;
+					}
+					f = connection_to_player.emplace(evt.id, game.spawn_player()).first;
+					if (lockstep_mode) {
+						lockstep.join(game.players.get(f->second)->index);
+						lockstep_restart = true;
+					}
+				}
+				//file controls to be applied on the tick they were meant for:
+				input_buffers[evt.id].push(evt.tick, evt.controls, server_tick, evt.queued);
+			}
+		}
+
+		Metrics::set(Metrics::Players, int64_t(game.players.size()));
+		Metrics::set(Metrics::ToNetworkDepth, int64_t(to_net.size()));
+		Metrics::set(Metrics::BacklogEvents, int64_t(backlog.size()));
+
+		if (stop_requested) break;
+
+		if (handoff_requested && !draining && !handing_off) {
+			handoff_requested = 0;
+			start_handoff();
+		}
+		if (handing_off && Clock::now() >= handoff_deadline) {
+			SimEvent cancel;
+			cancel.type = SimEvent::CancelHandoff;
+			forward(std::move(cancel));
+			finish_handoff(false, "target did not acknowledge in time");
+		}
+
+		if (draining) {
+			//match lives elsewhere now; stop once everyone has followed their redirect:
+			while (!backlog.empty() && to_net.push(std::move(backlog.front()))) {
+				backlog.pop_front();
+				to_net_stats.pushed(to_net.size());
+			}
+			if ((connection_to_player.empty() && backlog.empty()) || Clock::now() >= drain_deadline) break;
+			continue;
+		}
+
+		if (!awaiting_resume.empty() && Clock::now() >= resume_deadline) {
+			std::cout << "[server] " << awaiting_resume.size() << " players did not resume after handoff; removing them." << std::endl;
+			for (auto const &[token, player] : awaiting_resume) {
+				game.remove_player(player);
+			}
+			awaiting_resume.clear();
+		}
+
+		while (!backlog.empty() && to_net.push(std::move(backlog.front()))) {
+			backlog.pop_front();
+			to_net_stats.pushed(to_net.size());
+		}
+
+		//play back everyone's input for this tick:
+		Clock::time_point applied = Clock::now();
+		for (auto &[id, handle] : connection_to_player) {
+			auto f = input_buffers.find(id);
+			if (f != input_buffers.end()) f->second.pop(server_tick, &game.players.get(handle)->controls, applied);
+		}
+
+		if (lockstep_mode) {
+			//(re)start everyone's simulation if the players changed:
+			if (lockstep_restart) {
+				lockstep_restart = false;
+				for (auto &[id, player] : connection_to_player) {
+					encoder.send_buffer.clear();
+					send_lockstep_start_message(&encoder, lockstep, game.players.get(player)->index);
+					SimEvent send;
+					send.type = SimEvent::Send;
+					send.id = id;
+					send.bytes = encoder.send_buffer;
+					forward(std::move(send));
+				}
+			}
+
+			//gather this tick's inputs, step, and relay them (with the resulting hash) to everyone:
+			LockstepFrame frame;
+			frame.tick = lockstep.tick;
+			for (auto &player : game.players) {
+				frame.inputs[player.index] = LockstepGame::input_from(player.controls);
+				for (auto &b : player.controls.left_buttons) b.downs = 0;
+				for (auto &b : player.controls.right_buttons) b.downs = 0;
+			}
+			lockstep.update(frame.inputs);
+			frame.hash = lockstep.hash();
+
+			encoder.send_buffer.clear();
+			send_lockstep_frame_message(&encoder, frame);
+			for (auto &[id, player] : connection_to_player) {
+				SimEvent send;
+				send.type = SimEvent::Send;
+				send.id = id;
+				send.bytes = encoder.send_buffer;
+				forward(std::move(send));
+			}
+			continue;
 		}
 
 		//update current game state
-		game.update(Game::Tick);
+		// (paused while migrated players are reconnecting, or while our checkpoint is on its way to another server)
+		if (awaiting_resume.empty() && !handing_off) {
+			if (replay) replay->record(game);
+			RECORD_SCOPE("Game::update");
+			game.update(Game::Tick);
+		}
 
-		//send updated game state to all clients
-		for (auto &[c, player] : connection_to_player) {
-			game.send_state_message(c, player);
+		//send updated game state to all clients, every few ticks
+		// (stamped with how far into each client's input the state is, for client-side prediction)
+		if (server_tick % send_every != 0) continue;
+		RECORD_SCOPE("send_state_message");
+		Clock::time_point sending = Clock::now();
+		for (auto &[id, player] : connection_to_player) {
+			auto f = input_buffers.find(id);
+			//(along with how long we held their newest played input, for the client's latency report)
+			InputEcho echo;
+			if (f != input_buffers.end() && f->second.last_played.any) {
+				InputBuffer::Played const &played = f->second.last_played;
+				auto units = [](Clock::duration d) { //(0.1ms units, clamped to fit)
+					int64_t u = std::chrono::duration_cast< std::chrono::microseconds >(d).count() / 100;
+					return uint16_t(std::clamp< int64_t >(u, 0, InputEcho::Unknown - 1));
+				};
+				echo.tick = played.tick;
+				echo.buffered = units(played.applied - played.arrived);
+				echo.held = units(sending - played.applied);
+			}
+			encoder.send_buffer.clear();
+			game.send_state_message(&encoder, game.players.get(player), server_tick, f != input_buffers.end() ? f->second.next : 0, echo);
+			SimEvent send;
+			send.type = SimEvent::Send;
+			send.id = id;
+			send.bytes = encoder.send_buffer;
+			forward(std::move(send));
 		}
 
 	}
 
+	quit = true;
+	network_thread.join();
+	if (stats_thread.joinable()) stats_thread.join();
+
+	std::cout << Memory::report();
+
+	TRACE_WRITE(); //(if TRACE_FILE is set in a traced build; see Trace.hpp)
 
 	return 0;
 
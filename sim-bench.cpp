@@ -0,0 +1,425 @@
+//Runs Game::update as fast as possible on generated inputs (no networking, no SDL)
+// and reports ticks/second, ns/tick, and heap allocations per tick.
+//
+//Usage:
+//	./sim-bench [--ticks N] [--seed S] [--inputs random|scripted] [--expect HASH] [--max-ns-per-tick NS] [--batch GAMES] [--rollback] [--scaling]
+//
+//With --batch, runs GAMES matches side by side -- first with Game::update on each, then with
+// GameBatch::update on all of them at once -- and reports both (plus whether they agree).
+//
+//With --rollback, measures what a rolling-back client pays to re-simulate 8 to 16 ticks:
+// restoring a RollbackGame snapshot vs. restoring a Game checkpoint, and a full predict/confirm
+// run (checked against the server's state hashes) with the confirmed frames that many ticks behind.
+//
+//With --scaling, runs full ring matches of 3 to 64 players and reports time per tick and per
+// player-tick along with state message and checkpoint sizes (all should grow linearly).
+//
+//Inputs are generated up front from the seed, so a given set of arguments always
+// produces the same final state; its hash is printed at the end. Use --expect to fail
+// (exit code 1) if the hash changes, and --max-ns-per-tick to fail if the simulation gets slower.
+//(hashes depend on floating point behavior, so compare them on one platform/compiler)
+
+#include "Game.hpp"
+#include "GameBatch.hpp"
+#include "Rollback.hpp"
+#include "count_allocations.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <cstdio>
+#include <cstdint>
+#include <algorithm>
+
+//the controls each player's client would have delivered before a tick:
+typedef std::vector< Player::Controls > TickInputs;
+
+//press or release a finger the way PlayMode does (downs count presses):
+static void set_button(Button *button, bool pressed) {
+	if (pressed && !button->pressed) button->downs += 1;
+	button->pressed = pressed;
+}
+
+//random: every button toggles now and then, with some players mashing harder than others.
+static std::vector< TickInputs > random_inputs(uint32_t ticks, uint32_t players, uint32_t seed) {
+	std::mt19937 mt(seed);
+	std::vector< TickInputs > inputs(ticks, TickInputs(players));
+	std::vector< Player::Controls > held(players);
+	for (uint32_t t = 0; t < ticks; ++t) {
+		for (uint32_t p = 0; p < players; ++p) {
+			Player::Controls &controls = held[p];
+			uint32_t toggle_chance = 2 + p * 3; //(percent per button per tick)
+			auto update = [&](std::array< Button, 4 > &buttons) {
+				for (auto &b : buttons) {
+					b.downs = 0;
+					if (mt() % 100 < toggle_chance) set_button(&b, !b.pressed);
+				}
+			};
+			update(controls.left_buttons);
+			update(controls.right_buttons);
+			inputs[t][p] = controls;
+		}
+	}
+	return inputs;
+}
+
+//scripted: each player cycles through rock, paper, and scissors at its own pace.
+static std::vector< TickInputs > scripted_inputs(uint32_t ticks, uint32_t players, uint32_t seed) {
+	std::vector< TickInputs > inputs(ticks, TickInputs(players));
+	std::vector< Player::Controls > held(players);
+	for (uint32_t t = 0; t < ticks; ++t) {
+		for (uint32_t p = 0; p < players; ++p) {
+			Player::Controls &controls = held[p];
+			uint32_t period = 10 + (seed + p * 7) % 23; //ticks per hand
+			auto shape = [&](std::array< Button, 4 > &buttons, uint32_t phase) {
+				for (auto &b : buttons) b.downs = 0;
+				uint32_t hand = (t / period + phase) % 3;
+				set_button(&buttons[0], hand == 0);
+				set_button(&buttons[1], hand == 0);
+				set_button(&buttons[2], hand != 1);
+				set_button(&buttons[3], hand != 1);
+			};
+			shape(controls.left_buttons, 0);
+			shape(controls.right_buttons, p);
+			inputs[t][p] = controls;
+		}
+	}
+	return inputs;
+}
+
+//FNV-1a over the game's checkpoint (covers all simulation state, including the rng):
+static uint64_t hash_game(Game const &game) {
+	std::vector< uint8_t > checkpoint;
+	game.save_checkpoint(&checkpoint);
+	uint64_t hash = 0xcbf29ce484222325ULL;
+	for (uint8_t b : checkpoint) {
+		hash ^= b;
+		hash *= 0x100000001b3ULL;
+	}
+	return hash;
+}
+
+static uint64_t hash_games(std::vector< Game > const &games) {
+	uint64_t hash = 0;
+	for (auto const &game : games) {
+		hash = hash * 31 + hash_game(game);
+	}
+	return hash;
+}
+
+//many matches, updated one at a time with Game::update and all at once with GameBatch:
+static int run_batch(uint32_t ticks, uint32_t games, uint32_t seed, std::string const &input_kind, std::string const &expect) {
+	//inputs for each match (replayed cyclically, to keep memory reasonable):
+	uint32_t period = std::min(ticks, std::max(30U, 2000000U / games));
+	std::vector< std::vector< TickInputs > > inputs;
+	inputs.reserve(games);
+	for (uint32_t g = 0; g < games; ++g) {
+		inputs.emplace_back(input_kind == "random"
+			? random_inputs(period, GameBatch::Seats, seed + g)
+			: scripted_inputs(period, GameBatch::Seats, seed + g));
+	}
+
+	auto fresh_games = [&]() {
+		std::vector< Game > result(games);
+		for (auto &game : result) {
+			for (uint32_t i = 0; i < GameBatch::Seats; ++i) game.spawn_player();
+		}
+		return result;
+	};
+
+	auto report = [&](char const *name, double seconds, uint64_t tick_allocations, uint64_t hash) {
+		char hash_str[17];
+		std::snprintf(hash_str, sizeof(hash_str), "%016llx", (unsigned long long)hash);
+		double updates = double(ticks) * double(games);
+		std::cout << "  " << name << ": " << (seconds / ticks * 1e9) << " ns/tick, "
+			<< (seconds / updates * 1e9) << " ns/match-tick, "
+			<< (double(tick_allocations) / ticks) << " allocations/tick, hash " << hash_str << std::endl;
+		return std::string(hash_str);
+	};
+
+	std::cout << ticks << " ticks of " << games << " matches, " << input_kind << " inputs (seed " << seed << "):" << std::endl;
+
+	//scalar:
+	std::vector< Game > scalar = fresh_games();
+	uint64_t allocations_before = allocations_so_far();
+	auto before = std::chrono::steady_clock::now();
+	for (uint32_t t = 0; t < ticks; ++t) {
+		for (uint32_t g = 0; g < games; ++g) {
+			Game &game = scalar[g];
+			TickInputs const &input = inputs[g][t % period];
+			for (uint32_t s = 0; s < GameBatch::Seats; ++s) {
+				game.players[s].controls = input[s];
+			}
+			game.update(Game::Tick);
+		}
+	}
+	auto after = std::chrono::steady_clock::now();
+	double scalar_seconds = std::chrono::duration< double >(after - before).count();
+	uint64_t scalar_allocations = allocations_so_far() - allocations_before;
+	std::string scalar_hash = report("Game::update x N", scalar_seconds, scalar_allocations, hash_games(scalar));
+
+	//batched:
+	std::vector< Game > batched = fresh_games();
+	GameBatch batch(games);
+	for (uint32_t g = 0; g < games; ++g) batch.load(g, batched[g]);
+	allocations_before = allocations_so_far();
+	double update_seconds = 0.0;
+	before = std::chrono::steady_clock::now();
+	for (uint32_t t = 0; t < ticks; ++t) {
+		for (uint32_t g = 0; g < games; ++g) {
+			TickInputs const &input = inputs[g][t % period];
+			for (uint32_t s = 0; s < GameBatch::Seats; ++s) {
+				batch.set_controls(g, s, input[s]);
+			}
+		}
+		auto update_before = std::chrono::steady_clock::now();
+		batch.update(Game::Tick);
+		update_seconds += std::chrono::duration< double >(std::chrono::steady_clock::now() - update_before).count();
+	}
+	after = std::chrono::steady_clock::now();
+	double batch_seconds = std::chrono::duration< double >(after - before).count();
+	uint64_t batch_allocations = allocations_so_far() - allocations_before;
+	for (uint32_t g = 0; g < games; ++g) batch.store(g, &batched[g]);
+	std::string batch_hash = report((std::string("GameBatch (") + GameBatch::kernel() + ")").c_str(), batch_seconds, batch_allocations, hash_games(batched));
+
+	std::cout << "    (GameBatch::update alone: " << (update_seconds / (double(ticks) * double(games)) * 1e9) << " ns/match-tick; the rest is set_controls)" << std::endl;
+	std::cout << "  speedup: " << (scalar_seconds / batch_seconds) << "x" << std::endl;
+
+	bool ok = true;
+	if (batch_hash != scalar_hash) {
+		std::cerr << "FAIL: GameBatch final state differs from Game::update." << std::endl;
+		ok = false;
+	}
+	if (!expect.empty() && expect != scalar_hash) {
+		std::cerr << "FAIL: final state hash " << scalar_hash << " != expected " << expect << std::endl;
+		ok = false;
+	}
+	return ok ? 0 : 1;
+}
+
+//client-side rollback: cost of re-simulating the last 'depth' ticks, for several depths:
+static int run_rollback(uint32_t ticks, uint32_t seed, std::string const &input_kind) {
+	uint32_t const Seats = LockstepGame::Seats;
+	std::vector< TickInputs > controls = (input_kind == "random"
+		? random_inputs(ticks, Seats, seed)
+		: scripted_inputs(ticks, Seats, seed));
+
+	//what the server would send (inputs plus hash after each tick):
+	std::vector< LockstepFrame > frames(ticks);
+	LockstepGame start;
+	for (uint32_t s = 0; s < Seats; ++s) start.join(s);
+	{
+		LockstepGame server = start;
+		for (uint32_t t = 0; t < ticks; ++t) {
+			frames[t].tick = t;
+			for (uint32_t s = 0; s < Seats; ++s) frames[t].inputs[s] = LockstepGame::input_from(controls[t][s]);
+			server.update(frames[t].inputs);
+			frames[t].hash = server.hash();
+		}
+	}
+
+	std::cout << ticks << " ticks, " << input_kind << " inputs (seed " << seed << "); rollback snapshots are " << sizeof(LockstepGame) << " bytes:" << std::endl;
+
+	bool ok = true;
+	for (uint32_t depth = 8; depth <= RollbackGame::MaxAhead; depth += 2) {
+		//worst case: every tick rolls back 'depth' ticks:
+		RollbackGame rollback;
+		rollback.start(start, 0);
+		for (uint32_t t = 0; t < depth; ++t) rollback.predict(frames[t].inputs[0]);
+		uint32_t repeats = std::max(1U, ticks / depth);
+		uint64_t allocations_before = allocations_so_far();
+		auto before = std::chrono::steady_clock::now();
+		for (uint32_t r = 0; r < repeats; ++r) {
+			rollback.resimulate(rollback.current.tick - depth);
+		}
+		double snapshot_seconds = std::chrono::duration< double >(std::chrono::steady_clock::now() - before).count();
+		uint64_t snapshot_allocations = allocations_so_far() - allocations_before;
+
+		//same thing with Game, which has to go through a checkpoint to be restored:
+		Game game;
+		for (uint32_t s = 0; s < Seats; ++s) game.spawn_player();
+		std::vector< uint8_t > checkpoint;
+		game.save_checkpoint(&checkpoint);
+		allocations_before = allocations_so_far();
+		before = std::chrono::steady_clock::now();
+		for (uint32_t r = 0; r < repeats; ++r) {
+			game.load_checkpoint(checkpoint);
+			for (uint32_t t = 0; t < depth; ++t) {
+				for (uint32_t s = 0; s < Seats; ++s) game.seat(s)->controls = controls[t][s];
+				game.update(Game::Tick);
+			}
+		}
+		double game_seconds = std::chrono::duration< double >(std::chrono::steady_clock::now() - before).count();
+		uint64_t game_allocations = allocations_so_far() - allocations_before;
+
+		//realistic: predict every tick, confirm frames 'depth' ticks late, roll back on mispredictions:
+		RollbackGame client;
+		client.start(start, 0);
+		uint32_t desyncs = 0;
+		before = std::chrono::steady_clock::now();
+		for (uint32_t t = 0; t < ticks; ++t) {
+			if (t >= depth && !client.confirm(frames[t - depth])) desyncs += 1;
+			client.predict(frames[t].inputs[0]);
+		}
+		for (uint32_t t = ticks - std::min(ticks, depth); t < ticks; ++t) {
+			if (!client.confirm(frames[t])) desyncs += 1;
+		}
+		double run_seconds = std::chrono::duration< double >(std::chrono::steady_clock::now() - before).count();
+
+		std::cout << "  " << depth << " ticks: "
+			<< (snapshot_seconds / repeats * 1e9) << " ns/rollback from snapshot (" << (double(snapshot_allocations) / repeats) << " allocations), "
+			<< (game_seconds / repeats * 1e9) << " ns/rollback with Game checkpoints (" << (double(game_allocations) / repeats) << " allocations); "
+			<< "full run: " << (run_seconds / ticks * 1e9) << " ns/tick, " << client.rollbacks << " rollbacks re-running "
+			<< client.resimulated_ticks << " ticks, " << desyncs << " desyncs" << std::endl;
+
+		if (desyncs || client.current.hash() != frames.back().hash) {
+			std::cerr << "FAIL: rollback client with depth " << depth << " disagreed with the server." << std::endl;
+			ok = false;
+		}
+	}
+	return ok ? 0 : 1;
+}
+
+//ring matches of increasing size:
+static int run_scaling(uint32_t ticks, uint32_t seed, std::string const &input_kind) {
+	std::cout << ticks << " ticks per match size, " << input_kind << " inputs (seed " << seed << "):" << std::endl;
+	for (uint32_t players : {3U, 4U, 8U, 16U, 32U, 48U, 64U}) {
+		Game game(players);
+		for (uint32_t i = 0; i < players; ++i) game.spawn_player();
+
+		//(inputs replayed cyclically, to keep memory reasonable)
+		uint32_t period = std::min(ticks, 10000U);
+		std::vector< TickInputs > inputs = (input_kind == "random"
+			? random_inputs(period, players, seed)
+			: scripted_inputs(period, players, seed));
+
+		uint32_t games_over = 0;
+		uint64_t allocations_before = allocations_so_far();
+		auto before = std::chrono::steady_clock::now();
+		for (uint32_t t = 0; t < ticks; ++t) {
+			TickInputs const &input = inputs[t % period];
+			for (uint32_t s = 0; s < players; ++s) {
+				game.seat(int8_t(s))->controls = input[s];
+			}
+			bool was_over = game.over;
+			game.update(Game::Tick);
+			if (game.over && !was_over) games_over += 1;
+		}
+		double seconds = std::chrono::duration< double >(std::chrono::steady_clock::now() - before).count();
+		uint64_t tick_allocations = allocations_so_far() - allocations_before;
+
+		std::vector< uint8_t > message;
+		game.send_state_message(&message, &game.players.front());
+		std::vector< uint8_t > checkpoint;
+		game.save_checkpoint(&checkpoint);
+
+		std::cout << "  " << players << " players: " << (seconds / ticks * 1e9) << " ns/tick, "
+			<< (seconds / (double(ticks) * players) * 1e9) << " ns/player-tick, "
+			<< (double(tick_allocations) / ticks) << " allocations/tick, "
+			<< message.size() << " byte state message, "
+			<< checkpoint.size() << " byte checkpoint, "
+			<< games_over << " games finished" << std::endl;
+	}
+	return 0;
+}
+
+int main(int argc, char **argv) {
+	uint32_t ticks = 1000000;
+	uint32_t seed = 0;
+	std::string input_kind = "random";
+	std::string expect;
+	double max_ns_per_tick = 0.0;
+	uint32_t batch = 0;
+	bool rollback = false;
+	bool scaling = false;
+
+	for (int argi = 1; argi < argc; ++argi) {
+		std::string arg = argv[argi];
+		if (arg == "--ticks" && argi + 1 < argc) {
+			ticks = uint32_t(std::stoul(argv[++argi]));
+		} else if (arg == "--seed" && argi + 1 < argc) {
+			seed = uint32_t(std::stoul(argv[++argi]));
+		} else if (arg == "--inputs" && argi + 1 < argc) {
+			input_kind = argv[++argi];
+		} else if (arg == "--expect" && argi + 1 < argc) {
+			expect = argv[++argi];
+		} else if (arg == "--max-ns-per-tick" && argi + 1 < argc) {
+			max_ns_per_tick = std::stod(argv[++argi]);
+		} else if (arg == "--batch" && argi + 1 < argc) {
+			batch = uint32_t(std::stoul(argv[++argi]));
+		} else if (arg == "--rollback") {
+			rollback = true;
+		} else if (arg == "--scaling") {
+			scaling = true;
+		} else {
+			std::cerr << "Usage:\n\t./sim-bench [--ticks N] [--seed S] [--inputs random|scripted] [--expect HASH] [--max-ns-per-tick NS] [--batch GAMES] [--rollback] [--scaling]" << std::endl;
+			return 1;
+		}
+	}
+	if (input_kind != "random" && input_kind != "scripted") {
+		std::cerr << "Unknown input kind '" << input_kind << "' (expecting 'random' or 'scripted')." << std::endl;
+		return 1;
+	}
+
+	if (batch) {
+		return run_batch(ticks, batch, seed, input_kind, expect);
+	}
+	if (rollback) {
+		return run_rollback(ticks, seed, input_kind);
+	}
+	if (scaling) {
+		return run_scaling(ticks, seed, input_kind);
+	}
+
+	Game game;
+	for (uint32_t i = 0; i < 3; ++i) {
+		game.spawn_player();
+	}
+	uint32_t player_count = uint32_t(game.players.size());
+
+	std::vector< TickInputs > inputs = (input_kind == "random"
+		? random_inputs(ticks, player_count, seed)
+		: scripted_inputs(ticks, player_count, seed));
+
+	//deliver inputs + update, as the server's simulation loop does:
+	uint32_t games_over = 0;
+	uint64_t allocations_before = allocations_so_far();
+	auto before = std::chrono::steady_clock::now();
+	for (uint32_t t = 0; t < ticks; ++t) {
+		auto input = inputs[t].begin();
+		for (auto &player : game.players) {
+			player.controls = *input;
+			++input;
+		}
+		bool was_over = game.over;
+		game.update(Game::Tick);
+		if (game.over && !was_over) games_over += 1;
+	}
+	auto after = std::chrono::steady_clock::now();
+	uint64_t tick_allocations = allocations_so_far() - allocations_before;
+
+	double seconds = std::chrono::duration< double >(after - before).count();
+	double ns_per_tick = seconds / ticks * 1e9;
+
+	char hash[17];
+	std::snprintf(hash, sizeof(hash), "%016llx", (unsigned long long)hash_game(game));
+
+	std::cout << ticks << " ticks, " << player_count << " players, " << input_kind << " inputs (seed " << seed << "), " << games_over << " games finished:" << std::endl;
+	std::cout << "  " << (ticks / seconds) << " ticks/s" << std::endl;
+	std::cout << "  " << ns_per_tick << " ns/tick" << std::endl;
+	std::cout << "  " << (double(tick_allocations) / ticks) << " allocations/tick" << std::endl;
+	std::cout << "  final state hash: " << hash << std::endl;
+
+	bool ok = true;
+	if (!expect.empty() && expect != hash) {
+		std::cerr << "FAIL: final state hash " << hash << " != expected " << expect << std::endl;
+		ok = false;
+	}
+	if (max_ns_per_tick > 0.0 && ns_per_tick > max_ns_per_tick) {
+		std::cerr << "FAIL: " << ns_per_tick << " ns/tick > limit of " << max_ns_per_tick << " ns/tick" << std::endl;
+		ok = false;
+	}
+	return ok ? 0 : 1;
+}
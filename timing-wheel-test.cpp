@@ -0,0 +1,185 @@
+//Checks TimingWheel: timers scheduled at every level (and beyond the wheel's range) must fire
+// exactly on their deadline, including after cascading down through the finer levels,
+// and cancelled timers must never fire.
+//
+//Usage:
+//	./timing-wheel-test
+//
+//Prints each failed check and exits with a nonzero status if there were any.
+
+#include "TimingWheel.hpp"
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <list>
+#include <algorithm>
+#include <cstdint>
+
+static uint32_t failures = 0;
+static void check(bool ok, std::string const &what) {
+	if (!ok) {
+		std::cerr << "FAILED: " << what << std::endl;
+		failures += 1;
+	}
+}
+
+//a timer that remembers when (and how often) it fired:
+struct TestTimer : TimingWheel::Timer {
+	TimingWheel::Tick fired_at = 0;
+	uint32_t fired = 0;
+};
+
+static void record(TimingWheel &wheel, TimingWheel::Timer *timer_) {
+	TestTimer *timer = static_cast< TestTimer * >(timer_);
+	timer->fired_at = wheel.now;
+	timer->fired += 1;
+}
+
+static constexpr TimingWheel::Tick level_span(uint32_t level) {
+	return TimingWheel::Tick(1) << (TimingWheel::SlotBits * level);
+}
+
+//schedule one timer 'delay' ticks out, check it hasn't fired a tick early, and fires exactly on time:
+static void check_fires_on_time(TimingWheel::Tick start, TimingWheel::Tick delay, std::string const &what) {
+	TimingWheel wheel(start);
+	TestTimer timer;
+	wheel.schedule(&timer, start + delay);
+	check(wheel.count == 1, what + ": counted");
+
+	wheel.advance(start + delay - 1, [&](TimingWheel::Timer *t){ record(wheel, t); });
+	check(timer.fired == 0, what + ": not early");
+	check(timer.active(), what + ": still scheduled");
+
+	wheel.advance(start + delay, [&](TimingWheel::Timer *t){ record(wheel, t); });
+	check(timer.fired == 1, what + ": fired");
+	check(timer.fired_at == start + delay, what + ": fired at tick " + std::to_string(timer.fired_at) + ", expected " + std::to_string(start + delay));
+	check(!timer.active() && wheel.count == 0, what + ": unscheduled after firing");
+}
+
+//schedule a timer, advance to 'cancel_after' (e.g., after it has cascaded to a finer level), cancel it, and check it never fires:
+static void check_cancel(TimingWheel::Tick start, TimingWheel::Tick delay, TimingWheel::Tick cancel_after, std::string const &what) {
+	TimingWheel wheel(start);
+	TestTimer timer, other;
+	wheel.schedule(&timer, start + delay);
+	wheel.schedule(&other, start + delay); //(shares the slot, so cancel must unlink from the middle of a list)
+	wheel.advance(start + cancel_after, [&](TimingWheel::Timer *t){ record(wheel, t); });
+	timer.cancel();
+	check(!timer.active() && wheel.count == 1, what + ": cancelled");
+	wheel.advance(start + delay + level_span(TimingWheel::Levels - 1), [&](TimingWheel::Timer *t){ record(wheel, t); });
+	check(timer.fired == 0, what + ": cancelled timer never fired");
+	check(other.fired == 1 && other.fired_at == start + delay, what + ": slot-mate still fired on time");
+}
+
+int main(int argc, char **argv) {
+	if (argc != 1) {
+		std::cerr << "Usage:\n\t./timing-wheel-test" << std::endl;
+		return 1;
+	}
+
+	//wheels starting at zero and just short of a level-2 boundary (so every delay crosses some boundaries):
+	for (TimingWheel::Tick start : { TimingWheel::Tick(0), level_span(2) - 3 }) {
+		std::string at = " (from tick " + std::to_string(start) + ")";
+
+		//one timer filed in each level, plus one beyond the wheel's range:
+		for (uint32_t level = 0; level <= TimingWheel::Levels; ++level) {
+			TimingWheel::Tick delay = (level == 0 ? 5 : 3 * level_span(level) + 7);
+			if (level == TimingWheel::Levels) delay = level_span(TimingWheel::Levels) + 17;
+			std::string what = "level " + std::to_string(level) + at;
+			check_fires_on_time(start, delay, what);
+
+			//cancel while still in its original level:
+			check_cancel(start, delay, 0, what + " cancel before cascade");
+			//cancel after it has cascaded down (one tick before expiry it is in level 0):
+			if (level > 0) check_cancel(start, delay, delay - 1, what + " cancel after cascade");
+		}
+
+		//deadlines at (or before) 'now' fire on the next tick:
+		{
+			TimingWheel wheel(start + 10);
+			TestTimer timer;
+			wheel.schedule(&timer, start);
+			wheel.advance(start + 11, [&](TimingWheel::Timer *t){ record(wheel, t); });
+			check(timer.fired == 1 && timer.fired_at == start + 11, "past deadline" + at);
+		}
+	}
+
+	//rescheduling from the expiry callback (as Connection's keepalive -> idle stages do):
+	{
+		TimingWheel wheel(0);
+		TestTimer timer;
+		std::vector< TimingWheel::Tick > fired_at;
+		wheel.schedule(&timer, 100);
+		wheel.advance(100000, [&](TimingWheel::Timer *t){
+			fired_at.emplace_back(wheel.now);
+			if (fired_at.size() < 3) wheel.schedule(t, wheel.now + level_span(1) * 10);
+		});
+		check(fired_at == std::vector< TimingWheel::Tick >{ 100, 740, 1380 }, "reschedule from callback");
+		check(wheel.count == 0, "reschedule from callback: nothing left scheduled");
+	}
+
+	//many timers spread across every level, some cancelled part way through, advanced in uneven steps:
+	{
+		std::mt19937 mt(0x5eed);
+		TimingWheel wheel(12345);
+		std::list< TestTimer > timers;
+		std::vector< TimingWheel::Tick > deadlines;
+		std::vector< bool > cancelled;
+		for (uint32_t i = 0; i < 4000; ++i) {
+			uint32_t level = i % TimingWheel::Levels;
+			TimingWheel::Tick delay = 1 + mt() % (level_span(level + 1) - 1);
+			timers.emplace_back();
+			wheel.schedule(&timers.back(), wheel.now + delay);
+			deadlines.emplace_back(wheel.now + delay);
+			cancelled.emplace_back(false);
+		}
+		check(wheel.count == timers.size(), "random: count after scheduling");
+
+		TimingWheel::Tick end = 12345 + level_span(TimingWheel::Levels);
+		uint32_t step = 0;
+		while (wheel.now < end) {
+			TimingWheel::Tick to = std::min(end, wheel.now + 1 + mt() % (3 * level_span(2)));
+			wheel.advance(to, [&](TimingWheel::Timer *t){ record(wheel, t); });
+			//cancel a few timers that haven't fired yet:
+			uint32_t i = 0;
+			for (auto &timer : timers) {
+				if (timer.active() && (i + step) % 97 == 0) {
+					timer.cancel();
+					cancelled[i] = true;
+				}
+				++i;
+			}
+			++step;
+		}
+
+		uint32_t i = 0, wrong = 0;
+		for (auto const &timer : timers) {
+			if (cancelled[i]) {
+				if (timer.fired != 0) wrong += 1;
+			} else {
+				if (timer.fired != 1 || timer.fired_at != deadlines[i]) wrong += 1;
+			}
+			++i;
+		}
+		check(wrong == 0, "random: " + std::to_string(wrong) + " timers fired at the wrong time (or not at all)");
+		check(wheel.count == 0, "random: nothing left scheduled");
+	}
+
+	//timers cancel themselves when destroyed:
+	{
+		TimingWheel wheel(0);
+		{
+			TestTimer timer;
+			wheel.schedule(&timer, level_span(3) * 2);
+		}
+		check(wheel.count == 0, "destroyed timer unscheduled");
+	}
+
+	if (failures) {
+		std::cerr << failures << " checks failed." << std::endl;
+		return 1;
+	}
+	std::cout << "All timing wheel checks passed." << std::endl;
+	return 0;
+}
@@ -0,0 +1,60 @@
+#include "write_json.hpp"
+
+#include <iomanip>
+
+std::string json_string(std::string_view str) {
+	static char const *hex = "0123456789abcdef";
+	std::string ret = "\"";
+	for (char c : str) {
+		if (c == '"' || c == '\\') {
+			ret += '\\';
+			ret += c;
+		} else if (c == '\n') {
+			ret += "\\n";
+		} else if (c == '\t') {
+			ret += "\\t";
+		} else if (c == '\r') {
+			ret += "\\r";
+		} else if (uint8_t(c) < 0x20) {
+			ret += "\\u00";
+			ret += hex[uint8_t(c) >> 4];
+			ret += hex[uint8_t(c) & 0xf];
+		} else {
+			ret += c;
+		}
+	}
+	return ret + "\"";
+}
+
+ChromeTraceWriter::ChromeTraceWriter(std::ostream &out_, std::vector< std::pair< std::string, std::string > > const &other_data) : out(out_) {
+	out << "{\"displayTimeUnit\":\"ms\",";
+	if (!other_data.empty()) {
+		out << "\"otherData\":{";
+		for (size_t i = 0; i < other_data.size(); ++i) {
+			out << (i ? "," : "") << json_string(other_data[i].first) << ":" << json_string(other_data[i].second);
+		}
+		out << "},";
+	}
+	out << "\"traceEvents\":[";
+	out << std::fixed << std::setprecision(3);
+}
+
+void ChromeTraceWriter::thread_name(uint32_t tid, std::string_view name) {
+	out << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+		<< ",\"args\":{\"name\":" << json_string(name) << "}}";
+	separator = ",\n";
+}
+
+void ChromeTraceWriter::complete(std::string_view name, uint32_t tid, double begin_us, double duration_us, std::string_view category, std::string_view args) {
+	out << separator << "{\"name\":" << json_string(name);
+	if (!category.empty()) out << ",\"cat\":" << json_string(category);
+	out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+		<< ",\"ts\":" << begin_us << ",\"dur\":" << duration_us;
+	if (!args.empty()) out << ",\"args\":{" << args << "}";
+	out << "}";
+	separator = ",\n";
+}
+
+void ChromeTraceWriter::finish() {
+	out << "\n]}\n";
+}
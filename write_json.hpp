@@ -0,0 +1,39 @@
+#pragma once
+
+/*
+ * Helpers for the JSON files the tools and recorders here write:
+ *
+ *  out << "{\"name\":" << json_string(name) << "}";
+ *
+ *  ChromeTraceWriter trace(out); //Chrome trace-event JSON (chrome://tracing or https://ui.perfetto.dev)
+ *  trace.thread_name(1, "main");
+ *  trace.complete("Scene::draw", 1, begin_us, duration_us);
+ *  trace.finish();
+ */
+
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+//'str' as a JSON string literal (quotes, backslashes, and control characters escaped):
+std::string json_string(std::string_view str);
+
+struct ChromeTraceWriter {
+	//starts the file; 'other_data' (name, value) pairs show up as the trace's metadata:
+	explicit ChromeTraceWriter(std::ostream &out, std::vector< std::pair< std::string, std::string > > const &other_data = {});
+
+	void thread_name(uint32_t tid, std::string_view name);
+
+	//a complete ("X") event, with times in microseconds;
+	// 'args', if given, is the inside of a JSON object (e.g., "\"bytes\":12") shown with the event:
+	void complete(std::string_view name, uint32_t tid, double begin_us, double duration_us, std::string_view category = {}, std::string_view args = {});
+
+	//close the event list (after the last event):
+	void finish();
+
+	std::ostream &out;
+	char const *separator = "\n";
+};